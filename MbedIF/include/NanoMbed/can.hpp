@@ -160,6 +160,10 @@ class CAN {
   }
 
   void frequency(int baudrate) { dri_.ChangeBaudrate(baudrate); }
+#if NANO_HW_CAN_FD
+  /// @brief CAN FD: arbitration / data phase のビットレートを設定する
+  void frequency(int nominal, int data) { dri_.ChangeBaudrate(nominal, data); }
+#endif
 
   void mode(MbedCANMode mode) {
     switch (mode) {
@@ -221,9 +225,7 @@ inline int can_read(can_t* obj, CANMessage* msg, int handle) {
   }
 
   // Convert to CANMessage
-  msg->id = nano_msg.id;
-  msg->len = nano_msg.len;
-  std::memcpy(msg->data, nano_msg.data, nano_msg.len);
+  *msg = CANMessage::from_nano_hw(nano_msg);
   return 1;  // Message arrived
 }
 
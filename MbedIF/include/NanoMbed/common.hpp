@@ -1,7 +1,8 @@
 #pragma once
 
 #include <cstddef>
-#include <functional>
+#include <utility>
+#include "Nano/inplace_function.hpp"
 #include "Nano/queue.hpp"
 
 namespace {
@@ -21,6 +22,23 @@ struct ClassMethod_Impl<T, R(Args...)> {
 template <typename T, typename Fn>
 using ClassMethod = typename ClassMethod_Impl<T, Fn>::type;
 
+// &F::operator() --> R(Args...) Utility type
+template <typename Method>
+struct CallOperator_Impl;
+
+template <typename F, typename R, typename... Args>
+struct CallOperator_Impl<R (F::*)(Args...)> {
+  using type = R(Args...);
+};
+
+template <typename F, typename R, typename... Args>
+struct CallOperator_Impl<R (F::*)(Args...) const> {
+  using type = R(Args...);
+};
+
+template <typename F>
+using CallOperator = typename CallOperator_Impl<decltype(&F::operator())>::type;
+
 }  // namespace mbed::details
 
 namespace mbed {
@@ -35,17 +53,29 @@ class CircularBuffer {
 };
 
 template <typename Fn>
-class Callback : public std::function<Fn> {
+class Callback : public Nano::utils::InplaceFunction<Fn> {
+  using Base = Nano::utils::InplaceFunction<Fn>;
+
  public:
-  using std::function<Fn>::function;
+  using Base::Base;
 
+  // obj と method をそのまま保持する (std::bind を経由しない)
   template <typename T, typename Method = mbed::details::ClassMethod<T, Fn>>
-  Callback(T* obj, Method method) : std::function<Fn>(std::bind(method, obj)) {}
+  Callback(T* obj, Method method)
+      : Base([obj, method](auto&&... args) {
+          return (obj->*method)(std::forward<decltype(args)>(args)...);
+        }) {}
 };
 
 template <typename T, typename R, typename... Args>
 Callback(T*, R (T::*)(Args...)) -> Callback<R(Args...)>;
 
+template <typename R, typename... Args>
+Callback(R (*)(Args...)) -> Callback<R(Args...)>;
+
+template <typename F>
+Callback(F) -> Callback<mbed::details::CallOperator<F>>;
+
 // callback(T* obj, void (T::*method)()) -> Callback
 // callback(R (*func)(Args...)) -> Callback
 template <typename T>
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <algorithm>
-#include <vector>
+#include <cstring>
 
 #include <NanoHW/spi.hpp>
 
@@ -24,31 +24,37 @@ class SPI {
   }
 
   int write(int value) {
-    std::vector<uint8_t> tx{static_cast<uint8_t>(value)};
-    std::vector<uint8_t> rx;
+    nano_hw::spi::SPIBuffer tx{static_cast<uint8_t>(value)};
+    nano_hw::spi::SPIBuffer rx;
     (void)dri_.Transfer(tx, rx);
     return rx.empty() ? 0 : rx.front();
   }
 
+  /// @note kSPIMaxTransfer を超える長さは分割して転送する
   int write(const char* tx_buffer, int tx_length, char* rx_buffer,
             int rx_length) {
     if (tx_length <= 0 || tx_buffer == nullptr) {
       return 0;
     }
 
-    std::vector<uint8_t> tx(static_cast<size_t>(tx_length));
-    for (int i = 0; i < tx_length; ++i) {
-      tx[static_cast<size_t>(i)] = static_cast<uint8_t>(tx_buffer[i]);
-    }
-
-    std::vector<uint8_t> rx;
-    const int transferred = dri_.Transfer(tx, rx);
-
-    if (rx_buffer != nullptr && rx_length > 0) {
-      const int copy_length = std::min(rx_length, static_cast<int>(rx.size()));
-      for (int i = 0; i < copy_length; ++i) {
-        rx_buffer[i] = static_cast<char>(rx[static_cast<size_t>(i)]);
+    nano_hw::spi::SPIBuffer tx;
+    nano_hw::spi::SPIBuffer rx;
+    int transferred = 0;
+
+    for (int offset = 0; offset < tx_length;) {
+      auto const chunk =
+          std::min(tx_length - offset, static_cast<int>(tx.capacity()));
+      tx.assign(reinterpret_cast<const uint8_t*>(tx_buffer + offset),
+                static_cast<size_t>(chunk));
+      rx.clear();
+      transferred += dri_.Transfer(tx, rx);
+
+      if (rx_buffer != nullptr && offset < rx_length) {
+        auto const copy_length =
+            std::min({rx_length - offset, static_cast<int>(rx.size()), chunk});
+        memcpy(rx_buffer + offset, rx.data(), static_cast<size_t>(copy_length));
       }
+      offset += chunk;
     }
 
     return transferred;
@@ -14,7 +14,7 @@ namespace mbed {
 class SerialBase {
  public:
   enum Parity { None, Odd, Even };
-  enum IrqType { RxIrq };
+  enum IrqType { RxIrq, TxIrq };
 };
 
 class UnbufferedSerial : public SerialBase {
@@ -31,15 +31,23 @@ class UnbufferedSerial : public SerialBase {
   void enable_output(bool enable) { enabled_output_ = enable; }
 
   void attach(Callback<void()> cb, IrqType type = IrqType::RxIrq) {
-    rx_callback_ = cb;
+    if (type == IrqType::TxIrq) {
+      tx_callback_ = cb;
+      RaiseTxIrq();
+    } else {
+      rx_callback_ = cb;
+    }
   }
 
   bool readable() const { return is_open_ && enabled_input_; }
 
+  bool writable() const { return is_open_ && enabled_output_; }
+
   size_t write(const void* buffer, size_t size) {
     if (!is_open_ || !enabled_output_) {
       return 0;
     }
+    tx_written_ += size;
     return dri_.Send(const_cast<void*>(buffer), size);
   }
 
@@ -78,8 +86,31 @@ class UnbufferedSerial : public SerialBase {
  private:
   static constexpr int kDefaultBaudrate = 115200;
 
+  // The stub's transmit register is always empty, so a TxIrq handler runs as
+  // soon as it is attached and keeps running while it writes something (a
+  // handler that stops writing without detaching would spin on hardware).
+  void RaiseTxIrq() {
+    if (in_tx_irq_) {
+      return;
+    }
+    in_tx_irq_ = true;
+    while (tx_callback_ && writable()) {
+      auto const before = tx_written_;
+      // The handler may detach itself, so call a copy
+      auto callback = tx_callback_;
+      callback();
+      if (tx_written_ == before) {
+        break;
+      }
+    }
+    in_tx_irq_ = false;
+  }
+
   nano_hw::uart::DynUART<nano_hw::uart::DummyUARTConfig> dri_;
   Callback<void()> rx_callback_;
+  Callback<void()> tx_callback_;
+  size_t tx_written_ = 0;
+  bool in_tx_irq_ = false;
   bool enabled_input_ = true;
   bool enabled_output_ = true;
   bool is_open_ = true;
@@ -4,7 +4,7 @@
 #include <cstring>
 
 #include <NanoHAL/can.h>
-#include <NanoHW/can.hpp>
+#include <NanoHW/can_message.hpp>
 
 enum CANFormat : uint8_t { CANStandard = 0, CANExtended = 1, CANAny = 2 };
 
@@ -12,11 +12,18 @@ enum CANType : uint8_t { CANData = 0, CANRemote = 1 };
 
 struct CANMessage {
   // NOLINTBEGIN
-  unsigned int id = 0;             ///< 29 bit identifier
-  unsigned char data[8] = {};      ///< Data field
+  unsigned int id = 0;  ///< 29 bit identifier
+  unsigned char data[nano_hw::can::kCANMaxPayload] = {};  ///< Data field
   unsigned char len = 0;           ///< Length of data field in bytes
   CANFormat format = CANStandard;  ///< Format ::CANFormat
   CANType type = CANData;          ///< Type ::CANType
+  /// Receive time (low 16 bits of HighResClock, ms). Nano extension
+  unsigned short timestamp = 0;
+  bool timestamped = false;  ///< timestamp is valid. Nano extension
+#if NANO_HW_CAN_FD
+  bool fd = false;   ///< CAN FD frame
+  bool brs = false;  ///< Bit rate switch (FD only)
+#endif
   // NOLINTEND
 
   CANMessage() = default;
@@ -28,19 +35,38 @@ struct CANMessage {
 
   // Convert to nano_hw::can::CANMessage
   explicit operator nano_hw::can::CANMessage() const {
+    using nano_hw::can::CANMessageFormat;
+
     nano_hw::can::CANMessage msg;
     msg.id = this->id;
+    msg.SetFormat(this->format == CANExtended ? CANMessageFormat::kExtended
+                                              : CANMessageFormat::kStandard);
+    msg.SetRemote(this->type == CANRemote);
+#if NANO_HW_CAN_FD
+    msg.flags |= (this->fd ? msg.kFlagFD : 0) | (this->brs ? msg.kFlagBRS : 0);
+#endif
     msg.len = this->len;
-    std::memcpy(msg.data, this->data, this->len);
+    msg.CopyPayloadFrom(this->data);
     return msg;
   }
 
   // Convert from nano_hw::can::CANMessage
   static CANMessage from_nano_hw(const nano_hw::can::CANMessage& nano_msg) {
+    using nano_hw::can::CANMessageFormat;
+
     CANMessage msg;
     msg.id = nano_msg.id;
+    msg.format = nano_msg.Format() == CANMessageFormat::kExtended ? CANExtended
+                                                                  : CANStandard;
+    msg.type = nano_msg.IsRemote() ? CANRemote : CANData;
+    msg.timestamped = nano_msg.HasTimestamp();
+    msg.timestamp = nano_msg.timestamp;
+#if NANO_HW_CAN_FD
+    msg.fd = nano_msg.IsFD();
+    msg.brs = nano_msg.BitrateSwitch();
+#endif
     msg.len = nano_msg.len;
-    std::memcpy(msg.data, nano_msg.data, nano_msg.len);
+    nano_msg.CopyPayloadTo(msg.data);
     return msg;
   }
 };
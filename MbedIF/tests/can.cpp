@@ -4,6 +4,10 @@
 #include "NanoHW/can_impl.hpp"
 #include "can_api.h"
 
+#include <memory>
+#include <type_traits>
+#include <vector>
+
 template struct nano_hw::can::CANImpl<nano_stub::MockCAN>;
 
 // CANの初期化と基本的な送信テスト
@@ -204,3 +208,90 @@ TEST(CANTest, RxIrqAttach) {
 
   EXPECT_TRUE(r.rx_handler_called);
 }
+
+namespace {
+
+/// VirtualCANBus につないだ MockCAN のコールバックを溜める
+struct BusNode {
+  std::vector<nano_hw::can::CANMessage> received;
+
+  static void OnReceived(void* ctx, nano_hw::can::CANMessage msg) {
+    static_cast<BusNode*>(ctx)->received.push_back(msg);
+  }
+};
+
+struct BusNodeConfig {
+  using OnCANReceived = nano_hw::Direct<&BusNode::OnReceived>;
+  using OnCANTransmit = nano_hw::Ignore;
+  using OnCANBusError = nano_hw::Ignore;
+  using OnCANPassiveError = nano_hw::Ignore;
+};
+
+using BusCAN = nano_stub::MockCAN<BusNodeConfig>;
+static_assert(!std::is_copy_constructible_v<BusCAN> &&
+              !std::is_move_constructible_v<BusCAN>);
+
+constexpr int kBusBitrate = 500000;
+
+nano_hw::can::CANMessage BusFrame(uint32_t id) {
+  nano_hw::can::CANMessage msg{};
+  msg.id = id;
+  msg.len = 8;
+  return msg;
+}
+
+}  // namespace
+
+// MockCAN 同士が VirtualCANBus 越しにフィルタ・ループバック込みで通信すること
+TEST(MockCANBusTest, SendThroughBus) {
+  nano_stub::VirtualCANBus bus(kBusBitrate);
+  BusNode node_a, node_b;
+  BusCAN a(nano_hw::Pin{0}, nano_hw::Pin{1}, kBusBitrate, &node_a);
+  BusCAN b(nano_hw::Pin{2}, nano_hw::Pin{3}, kBusBitrate, &node_b);
+  a.AttachBus(bus);
+  b.AttachBus(bus);
+
+  nano_hw::can::CANFilter filter{nano_hw::can::CANFilter::Type::kList, {}};
+  filter.filter.list_filter.id = 0x123;
+  b.SetFilter(0, filter);
+  a.ChangeMode(nano_hw::can::CANMode::kLoopback);
+
+  EXPECT_TRUE(a.SendMessage(BusFrame(0x123)));
+  EXPECT_TRUE(a.SendMessage(BusFrame(0x456)));
+  bus.RunUntilIdle();
+
+  ASSERT_EQ(node_b.received.size(), 1u);
+  EXPECT_EQ(node_b.received[0].id, 0x123u);
+  EXPECT_EQ(node_a.received.size(), 2u);
+
+  b.DeactivateFilter(0, filter);
+  a.SendMessage(BusFrame(0x456));
+  bus.RunUntilIdle();
+  EXPECT_EQ(node_b.received.size(), 2u);
+
+  // ビットレートを変えたノードはエラーになる
+  b.ChangeBaudrate(250000);
+  b.SendMessage(BusFrame(0x10));
+  bus.RunUntilIdle();
+  EXPECT_EQ(b.TransmitErrors(), 8);
+}
+
+// 送信中の MockCAN を破棄してもバスは止まらず、途切れたフレームは届かないこと
+TEST(MockCANBusTest, DestroyMidFrame) {
+  nano_stub::VirtualCANBus bus(kBusBitrate);
+  BusNode node_sender, node_listener;
+  auto sender = std::make_unique<BusCAN>(nano_hw::Pin{0}, nano_hw::Pin{1},
+                                         kBusBitrate, &node_sender);
+  BusCAN listener(nano_hw::Pin{2}, nano_hw::Pin{3}, kBusBitrate,
+                  &node_listener);
+  sender->AttachBus(bus);
+  listener.AttachBus(bus);
+
+  sender->SendMessage(BusFrame(0x100));
+  bus.RunFor(std::chrono::microseconds(100));
+  sender.reset();
+  bus.RunUntilIdle();
+
+  EXPECT_TRUE(node_listener.received.empty());
+  EXPECT_EQ(bus.Ports(), 1u);
+}
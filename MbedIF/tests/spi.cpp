@@ -30,6 +30,24 @@ TEST(SPITest, WriteBuffer) {
   EXPECT_EQ(rx[3], tx[3]);
 }
 
+TEST(SPITest, WriteBufferLongerThanTransfer) {
+  SPI spi(NC, NC, NC);
+
+  constexpr int kLength = static_cast<int>(nano_hw::spi::kSPIMaxTransfer) * 3;
+  char tx[kLength];
+  char rx[kLength] = {};
+  for (int i = 0; i < kLength; ++i) {
+    tx[i] = static_cast<char>(i);
+  }
+
+  const int transferred = spi.write(tx, kLength, rx, kLength);
+
+  EXPECT_EQ(transferred, kLength);
+  for (int i = 0; i < kLength; ++i) {
+    EXPECT_EQ(rx[i], tx[i]);
+  }
+}
+
 TEST(SPITest, ConfigureFormatAndFrequency) {
   SPI spi(NC, NC, NC);
 
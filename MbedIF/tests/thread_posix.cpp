@@ -0,0 +1,138 @@
+#include "thread.hpp"
+#include <gtest/gtest.h>
+
+#include <pthread.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <NanoMbed/thread.hpp>
+#include "NanoHW/thread_impl.hpp"
+#include "rtos.hpp"
+
+using nano_stub::PosixThread;
+using rtos::Thread;
+template struct nano_hw::thread::ThreadImpl<nano_stub::PosixThread>;
+
+// 2 スレッドが交互に進む (Start 内で同期実行されない) こと
+TEST(PosixThreadTest, RunsConcurrently) {
+  Thread a;
+  Thread b;
+  std::atomic<int> turn{0};
+  constexpr int kRounds = 100;
+
+  a.start([&turn]() {
+    for (int i = 0; i < kRounds; i++) {
+      while (turn.load() != 2 * i) std::this_thread::yield();
+      turn.fetch_add(1);
+    }
+  });
+  b.start([&turn]() {
+    for (int i = 0; i < kRounds; i++) {
+      while (turn.load() != 2 * i + 1) std::this_thread::yield();
+      turn.fetch_add(1);
+    }
+  });
+
+  a.join();
+  b.join();
+  EXPECT_EQ(turn.load(), 2 * kRounds);
+}
+
+// Join がタスク完了まで待つこと
+TEST(PosixThreadTest, JoinWaitsForTask) {
+  Thread thread;
+  std::atomic<bool> executed{false};
+
+  thread.start([&executed]() {
+    nano_hw::parallel::SleepForMS(std::chrono::milliseconds(20));
+    executed = true;
+  });
+  thread.join();
+
+  EXPECT_TRUE(executed.load());
+}
+
+// sleep 中のスレッドは Terminate で起き、停止要求を見て戻れること
+TEST(PosixThreadTest, TerminateWakesSleepingThread) {
+  Thread thread;
+  std::atomic<bool> finished{false};
+
+  thread.start([&finished]() {
+    nano_hw::parallel::SleepForMS(std::chrono::seconds(30));
+    if (!PosixThread::CurrentStopRequested()) {
+      finished = true;
+    }
+  });
+
+  auto const begin = std::chrono::steady_clock::now();
+  thread.terminate();
+  auto const elapsed = std::chrono::steady_clock::now() - begin;
+
+  EXPECT_FALSE(finished.load());
+  EXPECT_LT(elapsed, std::chrono::seconds(5));
+}
+
+// キャンセルポイントを通らないループも StopRequested で抜けられること
+TEST(PosixThreadTest, TerminateCooperativeLoop) {
+  Thread thread;
+  std::atomic<bool> running{false};
+  std::atomic<bool> exited{false};
+
+  thread.start([&]() {
+    running = true;
+    while (!PosixThread::CurrentStopRequested()) {
+      std::this_thread::yield();
+    }
+    exited = true;
+  });
+
+  while (!running.load()) std::this_thread::yield();
+  thread.terminate();
+
+  EXPECT_TRUE(exited.load());
+}
+
+// 権限が無くても優先度の設定値は保持されること
+TEST(PosixThreadTest, SetPriority) {
+  Thread thread(ThreadPriorityLow);
+  EXPECT_EQ(thread.get_priority(), ThreadPriorityLow);
+
+  thread.start([]() {
+    nano_hw::parallel::SleepForMS(std::chrono::milliseconds(10));
+  });
+  thread.set_priority(ThreadPriorityBelowNormal);
+  EXPECT_EQ(thread.get_priority(), ThreadPriorityBelowNormal);
+  thread.join();
+}
+
+// stack_size が pthread 属性に反映されること
+TEST(PosixThreadTest, HonoursStackSize) {
+  constexpr uint32_t kStackSize = 256 * 1024;
+  Thread thread(ThreadPriorityNormal, kStackSize);
+  std::atomic<size_t> actual{0};
+
+  thread.start([&actual]() {
+    pthread_attr_t attr;
+    size_t size = 0;
+    pthread_getattr_np(pthread_self(), &attr);
+    pthread_attr_getstacksize(&attr, &size);
+    pthread_attr_destroy(&attr);
+    actual = size;
+  });
+  thread.join();
+
+  EXPECT_GE(actual.load(), kStackSize);
+}
+
+// 小さすぎる stack_size は PTHREAD_STACK_MIN に切り上げられること
+TEST(PosixThreadTest, TinyStackSizeIsRoundedUp) {
+  Thread thread(ThreadPriorityNormal, 128);
+  std::atomic<bool> executed{false};
+
+  thread.start([&executed]() { executed = true; });
+  thread.join();
+
+  EXPECT_TRUE(executed.load());
+}
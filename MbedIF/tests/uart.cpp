@@ -69,3 +69,24 @@ TEST(UARTTest, RxIrq) {
 
   SUCCEED();
 }
+
+TEST(UARTTest, TxIrq) {
+  UnbufferedSerial uart(NC, NC, 9600);
+  int written = 0;
+
+  // The stub's transmit register is always empty: the handler runs right
+  // away and keeps being called until it detaches itself
+  uart.attach(
+      [&]() {
+        const char byte = 'x';
+        if (written < 3) {
+          written += static_cast<int>(uart.write(&byte, 1));
+        } else {
+          uart.attach(nullptr, UnbufferedSerial::TxIrq);
+        }
+      },
+      UnbufferedSerial::TxIrq);
+
+  EXPECT_TRUE(uart.writable());
+  EXPECT_EQ(written, 3);
+}
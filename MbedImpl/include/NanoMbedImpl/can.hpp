@@ -3,6 +3,8 @@
 #include <mbed.h>
 #include <NanoHW/can.hpp>
 
+#include "high_res_clock.hpp"
+
 namespace nano_mbed {
 using nano_hw::can::CANFilter;
 using HWCANMessage = nano_hw::can::CANMessage;
@@ -54,16 +56,13 @@ class MbedCAN {
   ~MbedCAN() { can_.attach(nullptr, mbed::CAN::RxIrq); }
 
   bool SendMessage(HWCANMessage msg) {
-    using nano_hw::can::CANMessageFormat;
-
-    MbedCANMessage mbed_msg(msg.id);
-    for (int i = 0; i < msg.len && i < 8; ++i) {
-      mbed_msg.data[i] = msg.data[i];
+#if NANO_HW_CAN_FD
+    // Mbed's CAN API is classic only
+    if (msg.IsFD() || msg.len > sizeof(MbedCANMessage::data)) {
+      return false;
     }
-    mbed_msg.len = msg.len;
-    mbed_msg.format =
-        msg.format == CANMessageFormat::kStandard ? CANStandard : CANExtended;
-    int result = can_.write(mbed_msg);
+#endif
+    int result = can_.write(ToMbed(msg));
 
     if (result == 1) {
       Config::OnCANTransmit::execute(callback_context_, msg);
@@ -105,29 +104,55 @@ class MbedCAN {
 
     MbedCANMessage mbed_msg;
     if (can_read(hal_can, reinterpret_cast<CAN_Message*>(&mbed_msg), 0)) {
-      msg.id = mbed_msg.id;
-      msg.len = mbed_msg.len;
-      for (int i = 0; i < mbed_msg.len && i < 8; ++i) {
-        msg.data[i] = mbed_msg.data[i];
-      }
+      msg = FromMbed(mbed_msg);
+      Stamp(msg);
       return true;
     }
     return false;
   }
 
  private:
+  // The payload is always copied as one 8-byte block, regardless of len
+  // (Mbed's CAN API is classic only, so FD builds copy the first 8 bytes)
+  static MbedCANMessage ToMbed(HWCANMessage const& msg) {
+    using nano_hw::can::CANMessageFormat;
+
+    MbedCANMessage mbed_msg;
+    mbed_msg.id = msg.id;
+    mbed_msg.len = msg.len;
+    mbed_msg.format =
+        msg.Format() == CANMessageFormat::kStandard ? CANStandard : CANExtended;
+    mbed_msg.type = msg.IsRemote() ? CANRemote : CANData;
+    msg.CopyPayloadTo(mbed_msg.data, sizeof(mbed_msg.data));
+    return mbed_msg;
+  }
+
+  static HWCANMessage FromMbed(MbedCANMessage const& mbed_msg) {
+    using nano_hw::can::CANMessageFormat;
+
+    HWCANMessage msg;
+    msg.id = mbed_msg.id;
+    msg.len = mbed_msg.len;
+    msg.SetFormat(mbed_msg.format == CANExtended ? CANMessageFormat::kExtended
+                                                 : CANMessageFormat::kStandard);
+    msg.SetRemote(mbed_msg.type == CANRemote);
+    msg.CopyPayloadFrom(mbed_msg.data, sizeof(mbed_msg.data));
+    return msg;
+  }
+
+  // Capture time is taken right after the frame leaves the mailbox, before
+  // any queueing, so latency measurements exclude consumer delay
+  static void Stamp(HWCANMessage& msg) {
+    nano_hw::can::StampReceived<Config, MbedHighResClock>(msg);
+  }
+
   void OnReceive() {
     auto* hal_can = GetCANAPI(can_);
     MbedCANMessage mbed_msg;
 
     if (can_read(hal_can, reinterpret_cast<CAN_Message*>(&mbed_msg), 0)) {
-      HWCANMessage msg;
-      msg.id = mbed_msg.id;
-      msg.len = mbed_msg.len;
-      for (int i = 0; i < mbed_msg.len && i < 8; ++i) {
-        msg.data[i] = mbed_msg.data[i];
-      }
-
+      auto msg = FromMbed(mbed_msg);
+      Stamp(msg);
       Config::OnCANReceived::execute(callback_context_, msg);
     }
   }
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <mbed.h>
+#include <NanoHW/reactor.hpp>
+
+#include "./high_res_clock.hpp"
+#include "./thread.hpp"
+
+namespace nano_mbed {
+
+// EventFlags::set is ISR-safe and latches until the reactor waits
+class MbedReactorWaker {
+ public:
+  void Notify() { flags_.set(kWake); }
+
+  void WaitFor(std::chrono::milliseconds timeout) {
+    flags_.wait_any_for(kWake, timeout);
+  }
+
+ private:
+  static constexpr uint32_t kWake = 1;
+  rtos::EventFlags flags_;
+};
+
+using MbedReactor = nano_hw::reactor::Reactor<MbedThread, MbedHighResClock,
+                                              MbedReactorWaker>;
+
+/// @brief The one dispatch thread shared by all Mbed peripherals
+/// @details Started on first use. Peripherals register an event source
+///          here instead of owning a thread.
+inline MbedReactor& SharedReactor() {
+  static MbedReactor reactor(ThreadPriorityAboveNormal, 4096,
+                             "NanoReactor");
+  reactor.Start();
+  return reactor;
+}
+
+}  // namespace nano_mbed
@@ -2,9 +2,8 @@
 #include <mbed.h>
 #include <NanoHW/spi.hpp>
 
-#include <vector>
-
 namespace nano_mbed {
+using nano_hw::spi::SPIBuffer;
 using nano_hw::spi::SPIFormat;
 
 namespace {
@@ -38,7 +37,7 @@ class MbedSPI {
 
   void SetFrequency(int frequency) { spi_.frequency(frequency); }
 
-  int Transfer(std::vector<uint8_t> const& tx, std::vector<uint8_t>& rx) {
+  int Transfer(SPIBuffer const& tx, SPIBuffer& rx) {
     rx.resize(tx.size());
     for (size_t i = 0; i < tx.size(); ++i) {
       rx[i] = static_cast<uint8_t>(spi_.write(tx[i]));
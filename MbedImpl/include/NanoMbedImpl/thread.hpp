@@ -1,7 +1,5 @@
 #pragma once
 
-#include <functional>
-
 #include <mbed.h>
 #include <NanoHW/thread.hpp>
 
@@ -49,12 +47,12 @@ class MbedThread {
     }
   }
 
-  void Start(std::function<void()> task) {
+  void Start(nano_hw::thread::ThreadTask task) {
     if (!task || thread_ != nullptr)
       return;
 
     // Store the task for execution
-    task_ = task;
+    task_ = std::move(task);
 
     // Create a Mbed RTOS thread with the specified parameters
     thread_ = new rtos::Thread(MapThreadPriority(priority_),
@@ -98,7 +96,7 @@ class MbedThread {
   [[maybe_unused]] uint32_t stack_size_;
   [[maybe_unused]] unsigned char* stack_mem_;
   [[maybe_unused]] const char* name_;
-  std::function<void()> task_;
+  nano_hw::thread::ThreadTask task_;
   rtos::Thread* thread_;
   bool terminated_;
 };
@@ -1,16 +1,35 @@
 #pragma once
 
 #include <mbed.h>
+#include <Nano/arena.hpp>
 #include <Nano/queue.hpp>
 #include <NanoHW/uart.hpp>
+#include <NanoHW/uart_dma_rx.hpp>
+#include <NanoHW/uart_tx_queue.hpp>
 #include <cstddef>
+#include <optional>
+#include <type_traits>
 
-#include "./thread.hpp"
+#include "./reactor.hpp"
 
 namespace nano_mbed {
 template <nano_hw::uart::UARTConfig UARTConfig>
 class MbedUART {
-  static constexpr size_t kStackSize = 8192;
+  static constexpr size_t kChunkSize = 128;
+  static constexpr size_t kTxRingSize = 256;
+  // Non-zero (Config::kRxDmaSize) selects circular DMA reception
+  static constexpr size_t kRxDmaSize =
+      nano_hw::uart::RxDmaSizeOf<UARTConfig>();
+  // Service order of received bytes among the shared reactor's sources
+  static constexpr uint8_t kRxPriority =
+      nano_hw::reactor::ReactorPriorityOf<UARTConfig>(4);
+
+  struct NoRxDma {
+    explicit NoRxDma(void*) {}
+  };
+  using RxDma = std::conditional_t<
+      kRxDmaSize != 0, nano_hw::uart::DmaRxRing<kRxDmaSize, UARTConfig>,
+      NoRxDma>;
 
   void Init(int baudrate) {
     if (serial_ != nullptr) {
@@ -26,6 +45,7 @@ class MbedUART {
     if (serial_ == nullptr) {
       return;
     }
+    serial_->attach(nullptr, mbed::SerialBase::TxIrq);
     serial_->enable_input(false);
     serial_->enable_output(false);
     serial_->close();
@@ -43,73 +63,91 @@ class MbedUART {
         tx(static_cast<PinName>(transmit_pin.number)),
         rx(static_cast<PinName>(receive_pin.number)),
         cb_ctx_(cb_ctx),
-        thread_dispatch(ThreadPriorityNormal, kStackSize, nullptr,
-                        "UARTStream-Dispatch") {
+        rx_dma_(cb_ctx),
+        reactor_(SharedReactor()) {
     Init(frequency);
 
-    serial_->attach([this]() {
-      if (serial_->readable()) {
-        static uint8_t buf[128] = {};
-        const auto len = serial_->read(buf, 128);
-
-        buffer.PushN(buf, len);
-      }
-    });
-
-    thread_dispatch.Start([this]() {
-      using namespace std::chrono_literals;
-
-      this->is_running = true;
-      while (!serial_) {
-        ThisThread::sleep_for(10ms);
-      }
-
-      while (!stop_token) {
-        if (not buffer.Empty()) {
-          static uint8_t buf[128] = {};
-          auto len = buffer.Size() < 128 ? buffer.Size() : 128;
-          buffer.PopNTo(len, buf);
-          UARTConfig::OnUARTRx::execute(cb_ctx_, buf, len);
-        }
-
-        ThisThread::sleep_for(100ms);
-      }
-
-      this->is_running = false;
-    });
-
-    while (!is_running) {
-      ThisThread::sleep_for(10ms);
+    if constexpr (kRxDmaSize == 0) {
+      rx_event_ =
+          reactor_.Register(&MbedUART::OnRxReady, this, kRxPriority);
+      AttachRx();
     }
   }
 
   ~MbedUART() {
-    using namespace std::chrono_literals;
-
-    stop_token = true;
-    while (is_running) {
-      ThisThread::sleep_for(10ms);
-    }
     Deinit();
+    if (rx_event_) {
+      reactor_.Unregister(*rx_event_);
+    }
   }
 
   void Rebaud(int baudrate) {
     Deinit();
     Init(baudrate);
+    if constexpr (kRxDmaSize == 0) {
+      AttachRx();
+    }
+    StartTx();
   }
 
+  /// @brief Queue buffer for transmission and return without waiting
+  /// @details The TX-empty interrupt drains the ring and calls OnUARTTx
+  ///          (from the interrupt) with the bytes it has handed to the
+  ///          transmitter. One Send may be reported in several calls: the
+  ///          ring splits it where it wraps, and kBlock queues it piece by
+  ///          piece when it does not fit; the sizes add up to the bytes
+  ///          queued. What happens when the ring is full is chosen by
+  ///          SetTxFullPolicy (default: Config::kTxFullPolicy, or kBlock).
+  ///          kBlock cannot sleep in an interrupt, so Send called from ISR
+  ///          context behaves as kFail instead.
+  /// @return Number of bytes queued
   size_t Send(void* buffer, size_t size) {
     if (serial_ == nullptr) {
       return 0;
     }
 
-    const auto written = serial_->write(buffer, size);
-    if (written > 0) {
-      UARTConfig::OnUARTTx::execute(cb_ctx_,
-                                    static_cast<const uint8_t*>(buffer),
-                                    static_cast<size_t>(written));
+    auto policy = tx_policy_;
+    if (policy == nano_hw::uart::TxFullPolicy::kBlock &&
+        core_util_is_isr_active()) {
+      policy = nano_hw::uart::TxFullPolicy::kFail;
     }
-    return written > 0 ? static_cast<size_t>(written) : 0U;
+    const auto queued = tx_.Write(
+        static_cast<const uint8_t*>(buffer), size, policy, [this]() {
+          using namespace std::chrono_literals;
+          StartTx();
+          ThisThread::sleep_for(1ms);
+        });
+    StartTx();
+    return queued;
+  }
+
+  void SetTxFullPolicy(nano_hw::uart::TxFullPolicy policy) {
+    tx_policy_ = policy;
+  }
+
+  /// @brief Bytes discarded by kTruncate / kFail
+  [[nodiscard]] size_t TxDropped() const { return tx_.Dropped(); }
+
+  /// @brief DMA mode only: the buffer to program into a circular DMA
+  ///        stream fed by this UART's receive register
+  /// @details Mbed OS has no portable circular DMA API, so the target code
+  ///          sets up the stream and the idle-line interrupt, and forwards
+  ///          them to OnRxDmaEvent.
+  Nano::collection::Span<uint8_t> RxDmaBuffer() requires(kRxDmaSize != 0) {
+    return rx_dma_.Buffer();
+  }
+
+  /// @brief DMA mode only: call from the half-transfer, transfer-complete
+  ///        and idle-line interrupts with the stream's remaining count.
+  ///        New bytes are passed to OnUARTRx from the interrupt.
+  void OnRxDmaEvent(nano_hw::uart::DmaRxEvent event,
+                    size_t remaining) requires(kRxDmaSize != 0) {
+    rx_dma_.OnEvent(event, remaining);
+  }
+
+  [[nodiscard]] const nano_hw::uart::DmaRxStats& RxDmaStats() const
+      requires(kRxDmaSize != 0) {
+    return rx_dma_.Stats();
   }
 
   size_t Receive(void* buffer, size_t size) {
@@ -147,14 +185,77 @@ class MbedUART {
   }
 
  private:
+  // One interrupt per received chunk; the shared reactor hands the bytes
+  // to OnUARTRx
+  void AttachRx() {
+    serial_->attach([this]() {
+      if (serial_->readable()) {
+        Nano::utils::ArenaScope scope(rx_isr_arena_);
+        auto buf = scope.AllocateBytes(kChunkSize);
+        if (buf.empty()) {
+          return;
+        }
+        const auto len = serial_->read(buf.data(), buf.size());
+
+        buffer.PushN(buf.data(), len);
+        if (rx_event_) {
+          reactor_.Signal(*rx_event_);
+        }
+      }
+    });
+  }
+
+  // Reactor thread
+  static void OnRxReady(void* ctx) {
+    auto* self = static_cast<MbedUART*>(ctx);
+    while (!self->buffer.Empty()) {
+      Nano::utils::ArenaScope scope(self->dispatch_arena_);
+      auto buf = scope.AllocateBytes(kChunkSize);
+      const auto len =
+          self->buffer.Size() < buf.size() ? self->buffer.Size() : buf.size();
+      self->buffer.PopNTo(len, buf.data());
+      UARTConfig::OnUARTRx::execute(self->cb_ctx_, buf.data(), len);
+    }
+  }
+
+  // Enabling the interrupt is idempotent, and an empty ring disables it
+  // again from OnTxEmpty, so Send can call this unconditionally.
+  void StartTx() {
+    if (serial_ != nullptr && !tx_.Empty()) {
+      serial_->attach(mbed::callback(this, &MbedUART::OnTxEmpty),
+                      mbed::SerialBase::TxIrq);
+    }
+  }
+
+  // TX-empty interrupt
+  void OnTxEmpty() {
+    const bool pending = tx_.Drain(
+        [this]() { return serial_->writable(); },
+        [this](uint8_t byte) { serial_->write(&byte, 1); },
+        [this](const uint8_t* data, size_t size) {
+          UARTConfig::OnUARTTx::execute(cb_ctx_, data, size);
+        });
+    if (!pending) {
+      serial_->attach(nullptr, mbed::SerialBase::TxIrq);
+    }
+  }
+
   mbed::UnbufferedSerial* serial_;
   PinName tx, rx;
   void* cb_ctx_;
 
+  RxDma rx_dma_;
   Nano::collection::Queue<uint8_t, 32> buffer;
-  MbedThread thread_dispatch;
-  bool is_running = false;
-  bool stop_token = false;
+  nano_hw::uart::TxQueue<kTxRingSize> tx_;
+  nano_hw::uart::TxFullPolicy tx_policy_ =
+      nano_hw::uart::TxFullPolicyOf<UARTConfig>();
+  // Per-instance scratch for the RX interrupt, so a full kChunkSize read
+  // does not depend on how large the shared ScratchBuffer::ISR() is
+  Nano::utils::StaticArena<kChunkSize> rx_isr_arena_;
+  // OnRxReady 専用の一時領域 (インスタンス間で共有しない)
+  Nano::utils::StaticArena<kChunkSize> dispatch_arena_;
+  MbedReactor& reactor_;
+  std::optional<nano_hw::reactor::EventSource> rx_event_;
 };
 
 static_assert(nano_hw::uart::UART<MbedUART>);
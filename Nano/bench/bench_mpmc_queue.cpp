@@ -0,0 +1,108 @@
+// MpmcQueue のスループット計測 (ホスト上の複数スレッド)
+//   - 比較対象は std::mutex で保護した Queue (クリティカルセクション相当)
+//   - producer / consumer 数を変えて Mops/s を出す
+
+#include <Nano/mpmc_queue.hpp>
+#include <Nano/queue.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Nano::collection::MpmcQueue;
+using Nano::collection::Queue;
+
+constexpr size_t kCapacity = 1024;
+constexpr uint64_t kItemsPerProducer = 500'000;
+
+/// CAN フレーム相当の 16 バイト要素
+struct Item {
+  uint64_t sequence;
+  uint64_t payload;
+};
+
+class LockedQueue {
+ public:
+  bool TryPush(Item const& item) {
+    std::lock_guard lock(mutex_);
+    return queue_.Push(item);
+  }
+
+  bool TryPop(Item& out) {
+    std::lock_guard lock(mutex_);
+    return queue_.TryPop(out);
+  }
+
+ private:
+  std::mutex mutex_;
+  Queue<Item, kCapacity> queue_;
+};
+
+template <typename QueueT>
+void Run(const char* name, int producers, int consumers) {
+  static QueueT* queue = nullptr;
+  queue = new QueueT();
+
+  auto const total = kItemsPerProducer * static_cast<uint64_t>(producers);
+  std::atomic<uint64_t> consumed{0};
+  std::atomic<uint64_t> checksum{0};
+  std::vector<std::thread> threads;
+
+  auto const start = std::chrono::steady_clock::now();
+  for (int p = 0; p < producers; p++) {
+    threads.emplace_back([] {
+      for (uint64_t i = 0; i < kItemsPerProducer; i++) {
+        while (!queue->TryPush(Item{i, i * 3})) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int c = 0; c < consumers; c++) {
+    threads.emplace_back([&] {
+      Item item{};
+      uint64_t local = 0;
+      while (consumed.load(std::memory_order_relaxed) < total) {
+        if (queue->TryPop(item)) {
+          local += item.payload;
+          consumed.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      checksum += local;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+
+  auto const seconds = std::chrono::duration<double>(elapsed).count();
+  std::printf("%-8s %dP/%dC  %7.2f Mops/s  (checksum %llu)\n", name,
+              producers, consumers, static_cast<double>(total) / seconds / 1e6,
+              static_cast<unsigned long long>(checksum.load()));  // NOLINT
+
+  delete queue;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+
+  for (auto [producers, consumers] : {std::pair{1, 1}, std::pair{2, 1},
+                                      std::pair{4, 1}, std::pair{2, 2}}) {
+    Run<MpmcQueue<Item, kCapacity>>("Mpmc", producers, consumers);
+    Run<MpmcQueue<Item, kCapacity, false>>("Packed", producers, consumers);
+    Run<LockedQueue>("Mutex", producers, consumers);
+  }
+
+  return 0;
+}
@@ -0,0 +1,111 @@
+// PriorityQueue と std::priority_queue の push / pop 比較
+//   - 要素数 1024 まで埋めてから push と pop を交互に繰り返す
+//   - DecreaseKey はハンドル経由で既存要素を Top に寄せる
+
+#include <Nano/priority_queue.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Nano::collection::PriorityQueue;
+
+constexpr size_t kCapacity = 1024;
+constexpr size_t kOperations = 1 << 20;
+
+std::vector<uint32_t> MakeKeys() {
+  std::mt19937 rng(1234);
+  std::vector<uint32_t> keys(kOperations);
+  for (auto& key : keys) {
+    key = rng();
+  }
+  return keys;
+}
+
+template <typename F>
+void Report(const char* name, F body) {
+  auto const start = std::chrono::steady_clock::now();
+  auto const checksum = body();
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+
+  auto const ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  std::printf("%-22s %7.2f ns/op  (checksum %llu)\n", name,
+              static_cast<double>(ns) / kOperations,
+              static_cast<unsigned long long>(checksum));  // NOLINT
+}
+
+template <typename Queue>
+uint64_t PushPop(Queue& queue, std::vector<uint32_t> const& keys) {
+  uint64_t checksum = 0;
+  for (size_t i = 0; i < kCapacity; i++) {
+    queue.push(keys[i]);
+  }
+  for (size_t i = kCapacity; i < keys.size(); i++) {
+    checksum += queue.top();
+    queue.pop();
+    queue.push(keys[i]);
+  }
+  return checksum;
+}
+
+/// std::priority_queue と同じ呼び出し方にそろえる
+template <size_t Arity>
+struct NanoAdapter {
+  PriorityQueue<uint32_t, kCapacity, std::less<uint32_t>, Arity> queue;
+
+  void push(uint32_t key) { queue.Push(key); }
+  void pop() { queue.Pop(); }
+  uint32_t top() const { return queue.Top(); }
+};
+
+template <size_t Arity>
+uint64_t DecreaseKey(std::vector<uint32_t> const& keys) {
+  static PriorityQueue<uint32_t, kCapacity, std::greater<uint32_t>, Arity>
+      queue;
+  using Handle = typename decltype(queue)::Handle;
+  static Handle handles[kCapacity];
+
+  queue.Clear();
+  for (size_t i = 0; i < kCapacity; i++) {
+    handles[i] = queue.Push(keys[i] | 0x8000'0000U);
+  }
+
+  uint64_t checksum = 0;
+  for (size_t i = kCapacity; i < keys.size(); i++) {
+    auto& handle = handles[keys[i] % kCapacity];
+    auto const current = queue.Get(handle);
+    queue.DecreaseKey(handle, current - (keys[i] & 0xFFFF));
+    checksum += queue.Top();
+  }
+  return checksum;
+}
+
+}  // namespace
+
+int main() {
+  auto const keys = MakeKeys();
+
+  Report("std::priority_queue", [&] {
+    std::priority_queue<uint32_t> queue;
+    return PushPop(queue, keys);
+  });
+  Report("PriorityQueue<2>", [&] {
+    static NanoAdapter<2> queue;
+    return PushPop(queue, keys);
+  });
+  Report("PriorityQueue<4>", [&] {
+    static NanoAdapter<4> queue;
+    return PushPop(queue, keys);
+  });
+  Report("DecreaseKey<2>", [&] { return DecreaseKey<2>(keys); });
+  Report("DecreaseKey<4>", [&] { return DecreaseKey<4>(keys); });
+
+  return 0;
+}
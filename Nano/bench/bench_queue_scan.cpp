@@ -0,0 +1,102 @@
+// 4 KB のバイトリングからフレーム区切り (0x00) を探すベンチマーク
+//   - Index:    operator[] (要素ごとに剰余)
+//   - Iterator: range-based for (折り返しは分岐のみ)
+//   - Segments: 2 つの Span に memchr
+
+#include <Nano/queue.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+using Nano::collection::Queue;
+
+constexpr size_t kRingSize = 4096;
+constexpr int kIterations = 20000;
+constexpr uint8_t kDelimiter = 0x00;
+
+using Ring = Queue<uint8_t, kRingSize>;
+
+size_t ScanIndex(Ring& ring) {
+  auto const size = ring.Size();
+  for (size_t i = 0; i < size; i++) {
+    if (ring[i] == kDelimiter) {
+      return i;
+    }
+  }
+  return size;
+}
+
+size_t ScanIterator(Ring& ring) {
+  size_t i = 0;
+  for (auto byte : ring) {
+    if (byte == kDelimiter) {
+      return i;
+    }
+    i++;
+  }
+  return i;
+}
+
+size_t ScanSegments(Ring& ring) {
+  auto segments = ring.Segments();
+
+  auto const* first = segments.first.data();
+  if (auto const* hit = static_cast<uint8_t const*>(
+          memchr(first, kDelimiter, segments.first.size()))) {
+    return static_cast<size_t>(hit - first);
+  }
+
+  auto const* second = segments.second.data();
+  if (auto const* hit = static_cast<uint8_t const*>(
+          memchr(second, kDelimiter, segments.second.size()))) {
+    return segments.first.size() + static_cast<size_t>(hit - second);
+  }
+  return segments.size();
+}
+
+template <typename F>
+void Run(const char* name, Ring& ring, F scan) {
+  volatile size_t sink = 0;
+
+  auto const start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; i++) {
+    sink = sink + scan(ring);
+  }
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+
+  auto const ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  std::printf("%-10s %10.1f ns/scan  %6.3f ns/byte  (found at %zu)\n", name,
+              static_cast<double>(ns) / kIterations,
+              static_cast<double>(ns) / kIterations / ring.Size(),
+              scan(ring));
+}
+
+}  // namespace
+
+int main() {
+  static Ring ring;
+
+  // 途中で折り返すように位置をずらし、区切りは末尾に置く
+  for (size_t i = 0; i < kRingSize / 2; i++) {
+    ring.Push(1);
+  }
+  ring.ConsumeN(kRingSize / 2);
+  for (size_t i = 0; i < kRingSize - 2; i++) {
+    ring.Push(static_cast<uint8_t>(1 + i % 255));
+  }
+  ring.Push(kDelimiter);
+
+  std::printf("ring: %zu bytes (segments %zu + %zu)\n", ring.Size(),
+              ring.Segments().first.size(), ring.Segments().second.size());
+
+  Run("Index", ring, ScanIndex);
+  Run("Iterator", ring, ScanIterator);
+  Run("Segments", ring, ScanSegments);
+
+  return 0;
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "non_copyable.hpp"
+#include "span.hpp"
+
+namespace Nano::utils {
+
+/// @brief 外部バッファ上の bump-pointer アロケータ
+/// @details
+///   - Allocate は O(1) で、個別の解放は行わない
+///   - Mark / Release で確保位置を巻き戻す (ArenaScope を使う)
+///   - スレッドセーフではない。ISR / スレッドごとに別の Arena を使うこと
+class Arena : public NonCopyable<Arena> {
+ public:
+  Arena(void* buffer, size_t capacity)
+      : base_(static_cast<uint8_t*>(buffer)), capacity_(capacity) {}
+
+  /// @brief align に揃えた size バイトを確保する
+  /// @return 容量不足なら nullptr
+  void* Allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+    auto const address = reinterpret_cast<uintptr_t>(base_) + offset_;
+    auto const padding = (align - (address % align)) % align;
+    if (padding + size > capacity_ - offset_) {
+      return nullptr;
+    }
+
+    auto* ptr = base_ + offset_ + padding;
+    offset_ += padding + size;
+    if (offset_ > high_water_mark_) {
+      high_water_mark_ = offset_;
+    }
+    return ptr;
+  }
+
+  /// @brief 未初期化の T[count] を確保する
+  template <typename T>
+  T* AllocateArray(size_t count) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Arena never runs destructors");
+    return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+  }
+
+  /// @brief size バイトのバッファを確保する (失敗時は空の Span)
+  Nano::collection::Span<uint8_t> AllocateBytes(size_t size) {
+    auto* ptr = static_cast<uint8_t*>(Allocate(size, 1));
+    return ptr == nullptr ? Nano::collection::Span<uint8_t>()
+                          : Nano::collection::Span<uint8_t>(ptr, size);
+  }
+
+  /// @brief T を構築する (デストラクタは呼ばれない)
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Arena never runs destructors");
+    auto* ptr = Allocate(sizeof(T), alignof(T));
+    if (ptr == nullptr) {
+      return nullptr;
+    }
+    return ::new (ptr) T(std::forward<Args>(args)...);
+  }
+
+  /// @brief 現在の確保位置
+  [[nodiscard]] size_t Mark() const { return offset_; }
+
+  /// @brief Mark 時点まで巻き戻す
+  void Release(size_t mark) {
+    if (mark < offset_) {
+      offset_ = mark;
+    }
+  }
+
+  void Reset() { offset_ = 0; }
+
+  [[nodiscard]] size_t Used() const { return offset_; }
+  [[nodiscard]] size_t Capacity() const { return capacity_; }
+  [[nodiscard]] size_t Remaining() const { return capacity_ - offset_; }
+
+  /// @brief これまでの最大使用量
+  [[nodiscard]] size_t HighWaterMark() const { return high_water_mark_; }
+  void ResetHighWaterMark() { high_water_mark_ = offset_; }
+
+  [[nodiscard]] uint8_t* Data() const { return base_; }
+
+ private:
+  uint8_t* base_;
+  size_t capacity_;
+  size_t offset_ = 0;
+  size_t high_water_mark_ = 0;
+};
+
+namespace arena_detail {
+
+/// Arena より先に構築されるよう、StaticArena の基底として領域を持つ
+template <size_t N>
+struct StaticArenaStorage {
+  alignas(std::max_align_t) std::array<uint8_t, N> storage_;
+};
+
+}  // namespace arena_detail
+
+/// @brief 領域を内部に持つ Arena
+template <size_t N>
+class StaticArena : private arena_detail::StaticArenaStorage<N>,
+                    public Arena {
+ public:
+  StaticArena() : Arena(this->storage_.data(), N) {}
+};
+
+/// @brief スコープを抜けると確保分を巻き戻す RAII
+/// @note ネストした ISR でも LIFO に解放されるので同じ Arena を共有できる
+class ArenaScope : public NonCopyable<ArenaScope> {
+ public:
+  explicit ArenaScope(Arena& arena) : arena_(arena), mark_(arena.Mark()) {}
+  ~ArenaScope() { arena_.Release(mark_); }
+
+  void* Allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+    return arena_.Allocate(size, align);
+  }
+
+  template <typename T>
+  T* AllocateArray(size_t count) {
+    return arena_.AllocateArray<T>(count);
+  }
+
+  Nano::collection::Span<uint8_t> AllocateBytes(size_t size) {
+    return arena_.AllocateBytes(size);
+  }
+
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    return arena_.New<T>(std::forward<Args>(args)...);
+  }
+
+  [[nodiscard]] Arena& GetArena() const { return arena_; }
+
+ private:
+  Arena& arena_;
+  size_t mark_;
+};
+
+}  // namespace Nano::utils
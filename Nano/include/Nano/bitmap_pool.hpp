@@ -0,0 +1,317 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "span.hpp"
+
+namespace Nano::collection {
+
+namespace bitmap_detail {
+template <typename Word>
+inline constexpr size_t kWordBits = sizeof(Word) * 8;
+
+template <size_t N, typename Word>
+inline constexpr size_t kWordCount =
+    (N + kWordBits<Word> - 1) / kWordBits<Word>;
+}  // namespace bitmap_detail
+
+/// @brief スロットの使用状況を 1 ビットずつ詰めて持つビットマップ
+/// @details
+///   - 1 が使用中。ゼロ初期化なので .bss に置ける
+///   - 空きスロットは ~word の count-trailing-zeros で 1 命令で見つかる
+/// @tparam N スロット数
+/// @tparam Word ビットを詰める語 (Cortex-M では uint32_t が速い)
+template <size_t N, typename Word = uint32_t>
+class SlotBitmap {
+  static_assert(std::is_unsigned_v<Word>);
+
+  static constexpr size_t kBits = bitmap_detail::kWordBits<Word>;
+  static constexpr size_t kWords = bitmap_detail::kWordCount<N, Word>;
+
+ public:
+  /// 確保失敗 / 見つからない場合の値
+  static constexpr size_t kNone = N;
+
+  using WordType = Word;
+
+  /// @return 確保したスロット番号 (満杯なら kNone)
+  size_t Acquire() {
+    for (size_t w = 0; w < kWords; w++) {
+      auto const free = static_cast<Word>(~words_[w]);
+      if (free == 0) {
+        continue;
+      }
+
+      auto const bit = static_cast<size_t>(std::countr_zero(free));
+      auto const index = w * kBits + bit;
+      if (index >= N) {
+        return kNone;
+      }
+      words_[w] = static_cast<Word>(words_[w] | (Word{1} << bit));
+      return index;
+    }
+    return kNone;
+  }
+
+  void Release(size_t index) {
+    words_[index / kBits] &= static_cast<Word>(~(Word{1} << (index % kBits)));
+  }
+
+  /// @brief word 番目の語の mask に立っているスロットをまとめて解放する
+  void ReleaseMask(size_t word, Word mask) {
+    words_[word] = static_cast<Word>(words_[word] & ~mask);
+  }
+
+  [[nodiscard]] bool Test(size_t index) const {
+    return ((words_[index / kBits] >> (index % kBits)) & 1U) != 0;
+  }
+
+  /// @return from 以降で最初の使用中スロット (無ければ kNone)
+  [[nodiscard]] size_t FindNext(size_t from) const {
+    for (auto w = from / kBits; w < kWords; w++) {
+      auto word = words_[w];
+      if (w == from / kBits) {
+        word = static_cast<Word>(word & (~Word{0} << (from % kBits)));
+      }
+      if (word != 0) {
+        return w * kBits + static_cast<size_t>(std::countr_zero(word));
+      }
+    }
+    return kNone;
+  }
+
+  [[nodiscard]] size_t Count() const {
+    size_t count = 0;
+    for (auto word : words_) {
+      count += static_cast<size_t>(std::popcount(word));
+    }
+    return count;
+  }
+
+  void Clear() { words_.fill(0); }
+
+  static constexpr size_t Capacity() { return N; }
+  static constexpr size_t kBitsPerWord = kBits;
+
+ private:
+  std::array<Word, kWords> words_{};
+};
+
+/// @brief ISR / 複数スレッドから Acquire / Release できる SlotBitmap
+/// @details Acquire は CAS、Release は fetch_and で行う (ロックなし)
+/// @note FindNext / Count / Clear は並行する変更に対してはスナップショット
+template <size_t N, typename Word = uint32_t>
+class AtomicSlotBitmap {
+  static_assert(std::is_unsigned_v<Word>);
+
+  static constexpr size_t kBits = bitmap_detail::kWordBits<Word>;
+  static constexpr size_t kWords = bitmap_detail::kWordCount<N, Word>;
+
+ public:
+  static constexpr size_t kNone = N;
+
+  using WordType = Word;
+
+  size_t Acquire() {
+    for (size_t w = 0; w < kWords; w++) {
+      auto word = words_[w].load(std::memory_order_relaxed);
+      while (true) {
+        auto const free = static_cast<Word>(~word);
+        if (free == 0) {
+          break;
+        }
+
+        auto const bit = static_cast<size_t>(std::countr_zero(free));
+        auto const index = w * kBits + bit;
+        if (index >= N) {
+          return kNone;
+        }
+        if (words_[w].compare_exchange_weak(
+                word, static_cast<Word>(word | (Word{1} << bit)),
+                std::memory_order_acquire, std::memory_order_relaxed)) {
+          return index;
+        }
+      }
+    }
+    return kNone;
+  }
+
+  void Release(size_t index) {
+    ReleaseMask(index / kBits, static_cast<Word>(Word{1} << (index % kBits)));
+  }
+
+  void ReleaseMask(size_t word, Word mask) {
+    words_[word].fetch_and(static_cast<Word>(~mask), std::memory_order_release);
+  }
+
+  [[nodiscard]] bool Test(size_t index) const {
+    auto const word = words_[index / kBits].load(std::memory_order_acquire);
+    return ((word >> (index % kBits)) & 1U) != 0;
+  }
+
+  [[nodiscard]] size_t FindNext(size_t from) const {
+    for (auto w = from / kBits; w < kWords; w++) {
+      auto word = words_[w].load(std::memory_order_acquire);
+      if (w == from / kBits) {
+        word = static_cast<Word>(word & (~Word{0} << (from % kBits)));
+      }
+      if (word != 0) {
+        return w * kBits + static_cast<size_t>(std::countr_zero(word));
+      }
+    }
+    return kNone;
+  }
+
+  [[nodiscard]] size_t Count() const {
+    size_t count = 0;
+    for (auto const& word : words_) {
+      count += static_cast<size_t>(
+          std::popcount(word.load(std::memory_order_relaxed)));
+    }
+    return count;
+  }
+
+  void Clear() {
+    for (auto& word : words_) {
+      word.store(0, std::memory_order_release);
+    }
+  }
+
+  static constexpr size_t Capacity() { return N; }
+  static constexpr size_t kBitsPerWord = kBits;
+
+ private:
+  std::array<std::atomic<Word>, kWords> words_{};
+};
+
+/// @brief 固定長のオブジェクトプール (空きはビットマップで管理)
+/// @details
+///   - New で空きスロットに構築し、Delete で破棄する
+///   - 未使用スロットは構築しない
+///   - Delete(Span) は語単位でまとめて解放する
+/// @tparam T 要素型
+/// @tparam N スロット数
+/// @tparam Bitmap SlotBitmap または AtomicSlotBitmap
+template <typename T, size_t N, typename Bitmap = SlotBitmap<N>>
+class BitmapPool {
+  union Slot {
+    struct Empty {};
+
+    constexpr Slot() : empty() {}
+    ~Slot() requires std::is_trivially_destructible_v<T> = default;
+    ~Slot() {}
+
+    Empty empty;
+    T value;
+  };
+
+ public:
+  static constexpr size_t kNone = Bitmap::kNone;
+
+  constexpr BitmapPool() = default;
+
+  BitmapPool(BitmapPool const&) = delete;
+  BitmapPool& operator=(BitmapPool const&) = delete;
+
+  ~BitmapPool() requires std::is_trivially_destructible_v<T> = default;
+  ~BitmapPool() { Clear(); }
+
+  /// @return 構築した要素 (満杯なら nullptr)
+  template <typename... Args>
+  T* New(Args&&... args) {
+    auto const index = used_.Acquire();
+    if (index == kNone) {
+      return nullptr;
+    }
+    return std::construct_at(&slots_[index].value,
+                             std::forward<Args>(args)...);
+  }
+
+  void Delete(T* ptr) {
+    if (ptr == nullptr) {
+      return;
+    }
+    auto const index = IndexOf(ptr);
+    std::destroy_at(ptr);
+    used_.Release(index);
+  }
+
+  /// @brief まとめて破棄する (ビットマップの更新は語ごとに 1 回)
+  void Delete(Span<T* const> ptrs) {
+    using Word = typename Bitmap::WordType;
+    constexpr auto kBits = Bitmap::kBitsPerWord;
+
+    size_t current = kNone;
+    Word mask = 0;
+    for (auto* ptr : ptrs) {
+      if (ptr == nullptr) {
+        continue;
+      }
+      auto const index = IndexOf(ptr);
+      std::destroy_at(ptr);
+
+      if (index / kBits != current) {
+        if (mask != 0) {
+          used_.ReleaseMask(current, mask);
+        }
+        current = index / kBits;
+        mask = 0;
+      }
+      mask = static_cast<Word>(mask | (Word{1} << (index % kBits)));
+    }
+    if (mask != 0) {
+      used_.ReleaseMask(current, mask);
+    }
+  }
+
+  /// @brief 全ての要素を破棄する
+  void Clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (auto i = used_.FindNext(0); i != kNone; i = used_.FindNext(i + 1)) {
+        std::destroy_at(&slots_[i].value);
+      }
+    }
+    used_.Clear();
+  }
+
+  /// @brief ptr がこのプールの使用中スロットを指すか
+  [[nodiscard]] bool Contains(T const* ptr) const {
+    auto const* base = &slots_[0].value;
+    if (ptr < base || ptr >= base + N) {
+      return false;
+    }
+    return used_.Test(static_cast<size_t>(ptr - base));
+  }
+
+  [[nodiscard]] size_t IndexOf(T const* ptr) const {
+    return static_cast<size_t>(ptr - &slots_[0].value);
+  }
+
+  /// @brief index 番目の要素 (使用中でない場合は未定義動作)
+  T& operator[](size_t index) { return slots_[index].value; }
+  T const& operator[](size_t index) const { return slots_[index].value; }
+
+  /// @brief 使用中スロットのビットマップ (FindNext で走査できる)
+  Bitmap const& Used() const { return used_; }
+
+  [[nodiscard]] size_t Count() const { return used_.Count(); }
+  [[nodiscard]] bool Empty() const { return used_.FindNext(0) == kNone; }
+  static constexpr size_t Capacity() { return N; }
+
+ private:
+  std::array<Slot, N> slots_{};
+  Bitmap used_{};
+};
+
+/// @brief ISR から New / Delete できる BitmapPool
+template <typename T, size_t N>
+using AtomicBitmapPool = BitmapPool<T, N, AtomicSlotBitmap<N>>;
+
+}  // namespace Nano::collection
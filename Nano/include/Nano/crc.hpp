@@ -0,0 +1,289 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "span.hpp"
+
+#if defined(__ARM_FEATURE_CRC32) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_acle.h>
+#define NANO_CRC_ARM_HARDWARE 1
+#elif defined(__x86_64__) && defined(__GNUC__)
+#define NANO_CRC_X86_HARDWARE 1
+#endif
+
+namespace Nano::utils {
+
+using Nano::collection::Span;
+
+namespace crc_detail {
+
+template <size_t Width>
+using Register = std::conditional_t<
+    Width <= 8, uint8_t,
+    std::conditional_t<Width <= 16, uint16_t,
+                       std::conditional_t<Width <= 32, uint32_t, uint64_t>>>;
+
+constexpr uint64_t Reflect(uint64_t value, size_t width) {
+  uint64_t out = 0;
+  for (size_t i = 0; i < width; i++) {
+    out = (out << 1U) | ((value >> i) & 1U);
+  }
+  return out;
+}
+
+constexpr uint32_t LoadLe32(uint8_t const* p) {
+  return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8U |
+         static_cast<uint32_t>(p[2]) << 16U |
+         static_cast<uint32_t>(p[3]) << 24U;
+}
+
+constexpr uint32_t LoadBe32(uint8_t const* p) {
+  return static_cast<uint32_t>(p[0]) << 24U |
+         static_cast<uint32_t>(p[1]) << 16U |
+         static_cast<uint32_t>(p[2]) << 8U | static_cast<uint32_t>(p[3]);
+}
+
+/// @brief crc に 1 バイト流す (table は 0 バイト目のテーブル)
+template <size_t Width, bool Reflected, typename Work, typename Table>
+constexpr Work Step(Work crc, uint8_t byte, Work mask, Table const& table) {
+  if constexpr (Reflected) {
+    return (crc >> 8U) ^ table[(crc ^ byte) & 0xFFU];
+  } else {
+    return ((crc << 8U) & mask) ^ table[((crc >> (Width - 8)) ^ byte) & 0xFFU];
+  }
+}
+
+/// @brief tables[k][i]: i の後ろに 0 が k バイト続いたときの値
+template <typename Value, size_t Width, bool Reflected, size_t Slices,
+          typename Work>
+constexpr auto MakeTables(Work poly, Work mask) {
+  std::array<std::array<Value, 256>, Slices> tables{};
+  for (uint32_t i = 0; i < 256; i++) {
+    Work crc = Reflected ? i : static_cast<Work>(i) << (Width - 8);
+    for (int bit = 0; bit < 8; bit++) {
+      if constexpr (Reflected) {
+        crc = (crc & 1U) != 0 ? (crc >> 1U) ^ poly : crc >> 1U;
+      } else {
+        auto const top = (crc >> (Width - 1)) & 1U;
+        crc = ((crc << 1U) ^ (top != 0 ? poly : 0)) & mask;
+      }
+    }
+    tables[0][i] = static_cast<Value>(crc);
+  }
+  for (size_t k = 1; k < Slices; k++) {
+    for (size_t i = 0; i < 256; i++) {
+      tables[k][i] = static_cast<Value>(Step<Width, Reflected>(
+          static_cast<Work>(tables[k - 1][i]), 0, mask, tables[0]));
+    }
+  }
+  return tables;
+}
+
+inline constexpr uint64_t kCrc32Poly = 0x04C11DB7;
+inline constexpr uint64_t kCrc32cPoly = 0x1EDC6F41;
+
+/// @brief 命令で計算できる (反射した 32 bit の) 多項式か
+constexpr bool HasHardwareCrc(uint64_t poly) {
+#if defined(NANO_CRC_ARM_HARDWARE)
+  return poly == kCrc32Poly || poly == kCrc32cPoly;
+#elif defined(NANO_CRC_X86_HARDWARE)
+  return poly == kCrc32cPoly;
+#else
+  static_cast<void>(poly);
+  return false;
+#endif
+}
+
+#if defined(NANO_CRC_ARM_HARDWARE)
+inline bool HardwareCrcEnabled() { return true; }
+
+template <uint64_t Poly>
+inline uint32_t HardwareCrc(uint32_t crc, uint8_t const* p, size_t n) {
+  constexpr bool kCastagnoli = Poly == kCrc32cPoly;
+  for (; n >= 4; p += 4, n -= 4) {
+    uint32_t word;
+    std::memcpy(&word, p, 4);
+    crc = kCastagnoli ? __crc32cw(crc, word) : __crc32w(crc, word);
+  }
+  for (; n > 0; p++, n--) {
+    crc = kCastagnoli ? __crc32cb(crc, *p) : __crc32b(crc, *p);
+  }
+  return crc;
+}
+#elif defined(NANO_CRC_X86_HARDWARE)
+/// -msse4.2 無しでビルドしても、実行時に CPU を見て切り替える
+inline bool HardwareCrcEnabled() {
+#if defined(__SSE4_2__)
+  return true;
+#else
+  static bool const enabled = __builtin_cpu_supports("sse4.2");
+  return enabled;
+#endif
+}
+
+template <uint64_t Poly>
+__attribute__((target("sse4.2"))) inline uint32_t HardwareCrc(
+    uint32_t crc, uint8_t const* p, size_t n) {
+  uint64_t wide = crc;
+  for (; n >= 8; p += 8, n -= 8) {
+    uint64_t word;
+    std::memcpy(&word, p, 8);
+    wide = __builtin_ia32_crc32di(wide, word);
+  }
+  crc = static_cast<uint32_t>(wide);
+  for (; n > 0; p++, n--) {
+    crc = __builtin_ia32_crc32qi(crc, *p);
+  }
+  return crc;
+}
+#else
+inline bool HardwareCrcEnabled() { return false; }
+
+template <uint64_t Poly>
+inline uint32_t HardwareCrc(uint32_t crc, uint8_t const*, size_t) {
+  return crc;
+}
+#endif
+
+}  // namespace crc_detail
+
+/// @brief テーブル駆動の CRC
+/// @details
+///   - テーブルはコンパイル時に作る (Slices 枚 x 256 エントリ)
+///   - Slices = 4 / 8 では 4 / 8 バイトずつまとめて引く (slice-by-N)。
+///     テーブルの大きさとの兼ね合いで選ぶ (CRC-32 で 1 KB / 4 KB / 8 KB)
+///   - CRC-32C (ARMv8 では CRC-32 も) は、CPU が命令を持っていればそれを使う
+///   - Update を繰り返して分割したデータを順に流せる
+///   - 入力と出力の反射は同じとする (RefIn == RefOut)
+/// @tparam Poly 多項式 (反射しない表記)
+/// @tparam Width ビット幅 (8 の倍数、64 まで)
+/// @tparam UseHardware false ならテーブルだけで計算する
+template <uint64_t Poly, size_t Width, uint64_t Init = 0,
+          bool Reflected = false, uint64_t XorOut = 0, size_t Slices = 4,
+          bool UseHardware = true>
+class Crc {
+  static_assert(Width % 8 == 0 && Width >= 8 && Width <= 64,
+                "Width must be 8, 16, 24, 32, ... 64");
+  static_assert(Slices == 1 || Slices == 4 || Slices == 8,
+                "Slices must be 1, 4 or 8");
+  static_assert(Slices == 1 || Width <= 32,
+                "slice-by-N supports up to 32 bit CRCs");
+
+  using Work = std::conditional_t<Width <= 32, uint32_t, uint64_t>;
+
+ public:
+  using Value = crc_detail::Register<Width>;
+
+  static constexpr Work kMask =
+      static_cast<Work>(Width == 64 ? ~0ULL : (1ULL << Width) - 1);
+
+  constexpr Crc() = default;
+
+  constexpr Crc& Update(Span<uint8_t const> data) {
+    state_ = Run(state_, data.data(), data.size());
+    return *this;
+  }
+
+  /// @brief Queue の中身を先頭から流す (2 つの Segment を順に処理する)
+  template <typename Q>
+  requires requires(Q const& queue) {
+    { queue.Segments().first } -> std::convertible_to<Span<uint8_t const>>;
+  }
+  constexpr Crc& Update(Q const& queue) {
+    auto const segments = queue.Segments();
+    Update(segments.first);
+    return Update(segments.second);
+  }
+
+  [[nodiscard]] constexpr Value Final() const {
+    return static_cast<Value>((state_ ^ XorOut) & kMask);
+  }
+
+  constexpr void Reset() { state_ = kInitState; }
+
+  static constexpr Value Compute(Span<uint8_t const> data) {
+    return Crc{}.Update(data).Final();
+  }
+
+ private:
+  static constexpr Work kPoly = static_cast<Work>(
+      Reflected ? crc_detail::Reflect(Poly, Width) : Poly & kMask);
+  static constexpr Work kInitState = static_cast<Work>(
+      Reflected ? crc_detail::Reflect(Init, Width) : Init & kMask);
+  static constexpr bool kHardware = UseHardware && Width == 32 &&
+                                    Reflected &&
+                                    crc_detail::HasHardwareCrc(Poly);
+
+  static constexpr auto kTables =
+      crc_detail::MakeTables<Value, Width, Reflected, Slices>(kPoly, kMask);
+
+  static constexpr Work Step(Work crc, uint8_t byte) {
+    return crc_detail::Step<Width, Reflected>(crc, byte, kMask, kTables[0]);
+  }
+
+  /// 4 バイトをまとめた v の 1 バイト目を tables[base + 3] で引く
+  static constexpr Work Fold4(uint32_t v, size_t base) {
+    auto const& t = kTables;
+    if constexpr (Reflected) {
+      return t[base + 3][v & 0xFFU] ^ t[base + 2][(v >> 8U) & 0xFFU] ^
+             t[base + 1][(v >> 16U) & 0xFFU] ^ t[base][v >> 24U];
+    } else {
+      return t[base + 3][v >> 24U] ^ t[base + 2][(v >> 16U) & 0xFFU] ^
+             t[base + 1][(v >> 8U) & 0xFFU] ^ t[base][v & 0xFFU];
+    }
+  }
+
+  /// CRC を先頭 4 バイトに XOR した語
+  static constexpr uint32_t Head(Work crc, uint8_t const* p) {
+    if constexpr (Reflected) {
+      return static_cast<uint32_t>(crc) ^ crc_detail::LoadLe32(p);
+    } else {
+      return static_cast<uint32_t>(crc << (32 - Width)) ^
+             crc_detail::LoadBe32(p);
+    }
+  }
+
+  static constexpr uint32_t Tail(uint8_t const* p) {
+    return Reflected ? crc_detail::LoadLe32(p) : crc_detail::LoadBe32(p);
+  }
+
+  static constexpr Work Run(Work crc, uint8_t const* p, size_t n) {
+    if constexpr (kHardware) {
+      if (!std::is_constant_evaluated() && crc_detail::HardwareCrcEnabled()) {
+        return crc_detail::HardwareCrc<Poly>(crc, p, n);
+      }
+    }
+    if constexpr (Slices == 8) {
+      for (; n >= 8; p += 8, n -= 8) {
+        crc = Fold4(Head(crc, p), 4) ^ Fold4(Tail(p + 4), 0);
+      }
+    }
+    if constexpr (Slices >= 4) {
+      for (; n >= 4; p += 4, n -= 4) {
+        crc = Fold4(Head(crc, p), 0);
+      }
+    }
+    for (; n > 0; p++, n--) {
+      crc = Step(crc, *p);
+    }
+    return crc;
+  }
+
+  Work state_ = kInitState;
+};
+
+/// CRC-8 (多項式 0x07、SMBus PEC)
+using Crc8 = Crc<0x07, 8>;
+/// CRC-16/CCITT-FALSE (多項式 0x1021、初期値 0xFFFF)
+using Crc16Ccitt = Crc<0x1021, 16, 0xFFFF>;
+/// CRC-32 (Ethernet / zlib)
+using Crc32 = Crc<crc_detail::kCrc32Poly, 32, 0xFFFFFFFF, true, 0xFFFFFFFF>;
+/// CRC-32C (Castagnoli、iSCSI / ext4)
+using Crc32c = Crc<crc_detail::kCrc32cPoly, 32, 0xFFFFFFFF, true, 0xFFFFFFFF>;
+
+}  // namespace Nano::utils
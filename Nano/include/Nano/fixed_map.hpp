@@ -1,6 +1,7 @@
+#include <array>
 #include <cstddef>
 
-#include "managed_list.hpp"
+#include "bitmap_pool.hpp"
 
 namespace Nano::collection {
 /// @tparam N max count of key-value pairs
@@ -15,40 +16,62 @@ class FixedMap {
   };
 
  private:
-  ManagedList<V, N> value_pool_;
-  ManagedList<Pair, N> keys_;
+  // keys_[i] と values_ の i 番目のスロットが対応する
+  BitmapPool<V, N> values_;
+  std::array<Pair, N> keys_ = {};
+  V overflow_ = {};
 
  public:
   V* Find(const K& key) {
-    for (auto&& key_data : keys_) {
-      if (key_data.is_valid && key_data.key == key) {
-        return key_data.value;
+    auto const& used = values_.Used();
+    for (auto i = used.FindNext(0); i != used.kNone; i = used.FindNext(i + 1)) {
+      if (keys_[i].key == key) {
+        return keys_[i].value;
       }
     }
 
     return nullptr;
   }
 
+  /// @note 満杯で新しいキーを追加しようとした場合は共有のダミー領域を返す
   V& operator[](const K& key) {
     if (auto found = Find(key); found) {
       return *found;
     }
 
-    auto new_key = keys_.New();
-    if (!new_key) {
-      return *value_pool_.New();
+    auto* value = values_.New();
+    if (value == nullptr) {
+      overflow_ = V{};
+      return overflow_;
     }
 
-    new_key->key = key;
-    new_key->is_valid = true;
-    new_key->value = value_pool_.New();
+    auto& pair = keys_[values_.IndexOf(value)];
+    pair.key = key;
+    pair.is_valid = true;
+    pair.value = value;
 
-    return *new_key->value;
+    return *value;
   }
 
   bool Contains(const K& key) { return Find(key) != nullptr; }
 
+  /// @return key が無ければ false
+  bool Remove(const K& key) {
+    auto* value = Find(key);
+    if (value == nullptr) {
+      return false;
+    }
+
+    auto& pair = keys_[values_.IndexOf(value)];
+    pair.is_valid = false;
+    pair.value = nullptr;
+    values_.Delete(value);
+    return true;
+  }
+
+  [[nodiscard]] size_t Size() const { return values_.Count(); }
+
   auto begin() { return keys_.begin(); }
   auto end() { return keys_.end(); }
 };
-}  // namespace Nano::collection
\ No newline at end of file
+}  // namespace Nano::collection
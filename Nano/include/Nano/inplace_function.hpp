@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Nano::utils {
+
+namespace inplace_function_detail {
+
+template <typename R, typename... Args>
+struct VTable {
+  R (*invoke)(void* storage, Args&&... args);
+  void (*copy)(void* dst, const void* src);
+  void (*move)(void* dst, void* src);
+  void (*destroy)(void* storage);
+};
+
+template <typename F, typename R, typename... Args>
+inline constexpr VTable<R, Args...> kVTableFor = {
+    // メンバポインタも呼べるよう std::invoke を通す
+    [](void* storage, Args&&... args) -> R {
+      if constexpr (std::is_void_v<R>) {
+        std::invoke(*static_cast<F*>(storage), static_cast<Args&&>(args)...);
+      } else {
+        return std::invoke(*static_cast<F*>(storage),
+                           static_cast<Args&&>(args)...);
+      }
+    },
+    [](void* dst, const void* src) {
+      ::new (dst) F(*static_cast<const F*>(src));
+    },
+    [](void* dst, void* src) {
+      ::new (dst) F(std::move(*static_cast<F*>(src)));
+      static_cast<F*>(src)->~F();
+    },
+    [](void* storage) { static_cast<F*>(storage)->~F(); },
+};
+
+}  // namespace inplace_function_detail
+
+inline constexpr size_t kInplaceFunctionDefaultCapacity = 3 * sizeof(void*);
+
+template <typename Signature,
+          size_t Capacity = kInplaceFunctionDefaultCapacity>
+class InplaceFunction;
+
+namespace inplace_function_detail {
+template <typename Signature, size_t Capacity>
+std::true_type IsInplaceFunction(InplaceFunction<Signature, Capacity> const*);
+std::false_type IsInplaceFunction(...);
+
+/// InplaceFunction とその派生クラス (mbed::Callback など)
+template <typename F>
+inline constexpr bool kIsInplaceFunction =
+    decltype(IsInplaceFunction(static_cast<F const*>(nullptr)))::value;
+}  // namespace inplace_function_detail
+
+/// @brief ヒープを使わない固定容量の std::function 代替
+/// @details
+///   - 呼び出し可能オブジェクトは内部バッファに直接置く
+///   - Capacity を超えるキャプチャはコンパイルエラーになる
+///   - より小さい Capacity の InplaceFunction からは変換できる
+template <typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+  using VTable = inplace_function_detail::VTable<R, Args...>;
+
+  template <typename, size_t>
+  friend class InplaceFunction;
+
+ public:
+  InplaceFunction() noexcept = default;
+  InplaceFunction(std::nullptr_t) noexcept {}  // NOLINT
+
+  template <typename F, typename D = std::decay_t<F>>
+  requires(!inplace_function_detail::kIsInplaceFunction<D> &&
+           std::is_invocable_r_v<R, D&, Args...>)
+      InplaceFunction(F&& fn) {  // NOLINT
+    static_assert(sizeof(D) <= Capacity,
+                  "callable is too large for this InplaceFunction");
+    static_assert(alignof(D) <= alignof(std::max_align_t),
+                  "callable is over-aligned for InplaceFunction");
+    static_assert(std::is_copy_constructible_v<D>,
+                  "InplaceFunction requires a copyable callable");
+
+    // 関数への参照は null になり得ないので、減衰前の型で判定する
+    using Raw = std::remove_cvref_t<F>;
+    if constexpr (std::is_pointer_v<Raw> || std::is_member_pointer_v<Raw>) {
+      if (fn == nullptr) {
+        return;
+      }
+    }
+    ::new (storage_) D(static_cast<F&&>(fn));
+    vtable_ = &inplace_function_detail::kVTableFor<D, R, Args...>;
+  }
+
+  InplaceFunction(InplaceFunction const& other) { CopyFrom(other); }
+  InplaceFunction(InplaceFunction&& other) noexcept {
+    MoveFrom(std::move(other));
+  }
+
+  template <size_t N>
+  requires(N < Capacity) InplaceFunction(  // NOLINT
+      InplaceFunction<R(Args...), N> const& other) {
+    CopyFrom(other);
+  }
+
+  template <size_t N>
+  requires(N < Capacity) InplaceFunction(  // NOLINT
+      InplaceFunction<R(Args...), N>&& other) noexcept {
+    MoveFrom(std::move(other));
+  }
+
+  ~InplaceFunction() { Reset(); }
+
+  InplaceFunction& operator=(InplaceFunction const& other) {
+    if (this != &other) {
+      Reset();
+      CopyFrom(other);
+    }
+    return *this;
+  }
+
+  InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(std::move(other));
+    }
+    return *this;
+  }
+
+  InplaceFunction& operator=(std::nullptr_t) noexcept {
+    Reset();
+    return *this;
+  }
+
+  R operator()(Args... args) const {
+    return vtable_->invoke(storage_, static_cast<Args&&>(args)...);
+  }
+
+  explicit operator bool() const noexcept { return vtable_ != nullptr; }
+
+  bool operator==(std::nullptr_t) const noexcept { return vtable_ == nullptr; }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+ private:
+  void Reset() noexcept {
+    if (vtable_ != nullptr) {
+      vtable_->destroy(storage_);
+      vtable_ = nullptr;
+    }
+  }
+
+  template <size_t N>
+  void CopyFrom(InplaceFunction<R(Args...), N> const& other) {
+    if (other.vtable_ != nullptr) {
+      other.vtable_->copy(storage_, other.storage_);
+      vtable_ = other.vtable_;
+    }
+  }
+
+  template <size_t N>
+  void MoveFrom(InplaceFunction<R(Args...), N>&& other) noexcept {
+    if (other.vtable_ != nullptr) {
+      other.vtable_->move(storage_, other.storage_);
+      vtable_ = std::exchange(other.vtable_, nullptr);
+    }
+  }
+
+  VTable const* vtable_ = nullptr;
+  alignas(std::max_align_t) mutable std::byte storage_[Capacity];  // NOLINT
+};
+
+}  // namespace Nano::utils
@@ -3,6 +3,8 @@
 #include <array>
 #include <iterator>
 
+#include "bitmap_pool.hpp"
+
 namespace Nano::collection {
 template <typename T>
 class LinkedListNode {
@@ -13,6 +15,7 @@ class LinkedListNode {
   [[nodiscard]] auto Next() { return next_; }
   void Next(T* ptr) { next_ = ptr; }
 
+  /// @note 空きの管理は LinkedList のビットマップで行い、これは写し
   [[nodiscard]] bool InUse() const { return in_use_; }
   void InUse(bool value) { in_use_ = value; }
 
@@ -31,14 +34,15 @@ template <typename T, std::size_t N>
 class LinkedList {
  public:
   T* NewNode() {
-    for (auto& node : nodes_) {
-      if (!node.InUse()) {
-        node.InUse(true);
-        return &node;
-      }
+    auto const index = used_.Acquire();
+    if (index == used_.kNone) {
+      return nullptr;
     }
 
-    return nullptr;
+    auto& node = nodes_[index];
+    node.InUse(true);
+    node.ResetLinkNode();
+    return &node;
   }
 
   class Iterator : public std::contiguous_iterator_tag {
@@ -72,16 +76,19 @@ class LinkedList {
   auto end() { return Iterator(nullptr); }
 
   void Clear() {
-    for (auto& node : nodes_) {
-      node.InUse(false);
-      node.ResetLinkNode();
+    for (auto i = used_.FindNext(0); i != used_.kNone;
+         i = used_.FindNext(i + 1)) {
+      nodes_[i].InUse(false);
+      nodes_[i].ResetLinkNode();
     }
+    used_.Clear();
     head_ = nullptr;
     tail_ = nullptr;
   }
 
   void Remove(T* node) {
     node->InUse(false);
+    used_.Release(static_cast<size_t>(node - nodes_.data()));
 
     if (node == head_) {
       head_ = node->Next();
@@ -121,6 +128,7 @@ class LinkedList {
 
  private:
   std::array<T, N> nodes_;
+  SlotBitmap<N> used_;
   T* head_ = nullptr;
   T* tail_ = nullptr;
 };
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#ifndef NANO_CACHE_LINE_SIZE
+#define NANO_CACHE_LINE_SIZE 64
+#endif
+
+namespace Nano::collection {
+
+inline constexpr size_t kCacheLineSize = NANO_CACHE_LINE_SIZE;
+
+/// @brief 複数 producer / 複数 consumer のロックフリー有界キュー
+/// @details
+///   - Vyukov 方式: スロットごとのシーケンス番号で所有権を受け渡す
+///   - TryPush / TryPop はブロックせず、満杯 / 空なら false を返す
+///   - ISR から TryPush し、スレッドで TryPop する用途にも使える
+///   - シーケンス番号は「番号 - スロット位置」で持つので、ゼロ初期化の
+///     まま使える (constinit 可、初期化ループなし)
+/// @tparam T 要素型
+/// @tparam N 容量 (2 のべき乗)
+/// @tparam kPadded スロットをキャッシュライン境界に揃えるか
+///         (マルチコアのホストでは偽共有を防ぐ。MCU では false で省メモリ)
+template <typename T, size_t N, bool kPadded = true>
+class MpmcQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+  static constexpr size_t kMask = N - 1;
+
+  struct Cell {
+    struct Empty {};
+
+    constexpr Cell() : empty() {}
+    ~Cell() requires std::is_trivially_destructible_v<T> = default;
+    ~Cell() {}
+
+    std::atomic<size_t> sequence{0};
+    union {
+      Empty empty;
+      T value;
+    };
+  };
+
+  static constexpr size_t kCellAlign =
+      kPadded && alignof(Cell) < kCacheLineSize ? kCacheLineSize
+                                                : alignof(Cell);
+
+  struct alignas(kCellAlign) PaddedCell : Cell {};
+
+ public:
+  constexpr MpmcQueue() = default;
+
+  MpmcQueue(MpmcQueue const&) = delete;
+  MpmcQueue& operator=(MpmcQueue const&) = delete;
+
+  ~MpmcQueue() requires std::is_trivially_destructible_v<T> = default;
+  ~MpmcQueue() {
+    auto const head = enqueue_pos_.load(std::memory_order_acquire);
+    for (auto pos = dequeue_pos_.load(std::memory_order_acquire); pos != head;
+         pos++) {
+      std::destroy_at(&cells_[pos & kMask].value);
+    }
+  }
+
+  /// @return 満杯なら false
+  template <typename... Args>
+  bool TryEmplace(Args&&... args) {
+    auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& cell = cells_[pos & kMask];
+      auto const seq = Sequence(cell, pos);
+      auto const diff = static_cast<ptrdiff_t>(seq - pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          std::construct_at(&cell.value, std::forward<Args>(args)...);
+          Publish(cell, pos, pos + 1);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool TryPush(T const& value) { return TryEmplace(value); }
+  bool TryPush(T&& value) { return TryEmplace(std::move(value)); }
+
+  /// @return 空なら false
+  bool TryPop(T& out) {
+    auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& cell = cells_[pos & kMask];
+      auto const seq = Sequence(cell, pos);
+      auto const diff = static_cast<ptrdiff_t>(seq - (pos + 1));
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          out = std::move(cell.value);
+          std::destroy_at(&cell.value);
+          Publish(cell, pos, pos + N);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// @brief おおよその要素数 (並行する操作中は目安)
+  [[nodiscard]] size_t SizeApprox() const {
+    auto const tail = dequeue_pos_.load(std::memory_order_relaxed);
+    auto const head = enqueue_pos_.load(std::memory_order_relaxed);
+    return head > tail ? head - tail : 0;
+  }
+
+  [[nodiscard]] bool EmptyApprox() const { return SizeApprox() == 0; }
+
+  static constexpr size_t Capacity() { return N; }
+
+ private:
+  // シーケンス番号はスロット位置を引いた値で保持する
+  static size_t Sequence(Cell const& cell, size_t pos) {
+    return cell.sequence.load(std::memory_order_acquire) + (pos & kMask);
+  }
+
+  static void Publish(Cell& cell, size_t pos, size_t sequence) {
+    cell.sequence.store(sequence - (pos & kMask), std::memory_order_release);
+  }
+
+  std::array<PaddedCell, N> cells_{};
+  alignas(kCacheLineSize) std::atomic<size_t> enqueue_pos_{0};
+  alignas(kCacheLineSize) std::atomic<size_t> dequeue_pos_{0};
+};
+
+}  // namespace Nano::collection
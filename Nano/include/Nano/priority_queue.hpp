@@ -0,0 +1,267 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace Nano::collection {
+
+namespace priority_queue_detail {
+/// N 個のハンドルと無効値を表せる最小の符号なし整数
+template <size_t N>
+using IndexType = std::conditional_t<
+    (N < UINT8_MAX), uint8_t,
+    std::conditional_t<(N < UINT16_MAX), uint16_t, uint32_t>>;
+}  // namespace priority_queue_detail
+
+/// @brief ヒープ確保を行わない固定長の優先度付きキュー (d-ary heap)
+/// @details
+///   - 順序は std::priority_queue と同じ (std::less なら最大値が Top)
+///   - Push が返す Handle は Pop / Erase されるまで要素を指し続ける。
+///     スロットには世代番号があり、再利用されても古い Handle は無効のまま
+///   - 要素は値のままヒープ配列に並べるので比較時に間接参照しない
+/// @tparam T 要素型 (デフォルト構築可能であること)
+/// @tparam N 最大要素数
+/// @tparam Compare Compare(a, b) が true なら a は b より優先度が低い
+/// @tparam Arity 子の数 (4 にすると浅くなり、キャッシュラインに収まりやすい)
+template <typename T, size_t N, typename Compare = std::less<T>,
+          size_t Arity = 2>
+class PriorityQueue {
+  static_assert(N > 0, "PriorityQueue needs at least one slot");
+  static_assert(Arity >= 2, "Arity must be at least 2");
+
+  using Index = priority_queue_detail::IndexType<N>;
+  using Generation = uint32_t;
+  static constexpr Index kNone = static_cast<Index>(-1);
+
+  struct Entry {
+    T value;
+    Index slot;
+  };
+
+ public:
+  /// @brief 要素を指す安定なハンドル
+  class Handle {
+   public:
+    Handle() = default;
+
+    explicit operator bool() const { return index_ != kNone; }
+    bool operator==(Handle const&) const = default;
+
+   private:
+    friend class PriorityQueue;
+    Handle(Index index, Generation generation)
+        : index_(index), generation_(generation) {}
+
+    Index index_ = kNone;
+    Generation generation_ = 0;
+  };
+
+  constexpr PriorityQueue() = default;
+  explicit PriorityQueue(Compare compare) : compare_(std::move(compare)) {}
+
+  [[nodiscard]] bool Empty() const { return size_ == 0; }
+  [[nodiscard]] bool Full() const { return size_ == N; }
+  [[nodiscard]] size_t Size() const { return size_; }
+  static constexpr size_t Capacity() { return N; }
+
+  /// @return 満杯なら無効な Handle
+  Handle Push(T const& value) { return Emplace(value); }
+  Handle Push(T&& value) { return Emplace(std::move(value)); }
+
+  template <typename... Args>
+  Handle Emplace(Args&&... args) {
+    if (Full()) {
+      return Handle();
+    }
+
+    auto const slot = AllocateSlot();
+    SiftUp(size_++, Entry{T(std::forward<Args>(args)...), slot});
+    return Handle(slot, generation_[slot]);
+  }
+
+  /// @brief 最も優先度の高い要素 (空の場合は未定義動作)
+  T const& Top() const { return heap_[0].value; }
+
+  /// @brief Top を取り除く
+  /// @return 空なら false
+  bool Pop() {
+    if (Empty()) {
+      return false;
+    }
+    RemoveAt(0);
+    return true;
+  }
+
+  /// @brief Top を out にムーブして取り除く
+  /// @return 空なら false
+  bool TryPop(T& out) {
+    if (Empty()) {
+      return false;
+    }
+    out = std::move(heap_[0].value);
+    RemoveAt(0);
+    return true;
+  }
+
+  /// @brief handle がまだキューに残っているか
+  [[nodiscard]] bool Contains(Handle handle) const {
+    return handle.index_ < next_slot_ && position_[handle.index_] != kNone &&
+           generation_[handle.index_] == handle.generation_;
+  }
+
+  /// @brief handle の指す要素 (Contains でない場合は未定義動作)
+  T const& Get(Handle handle) const {
+    return heap_[position_[handle.index_]].value;
+  }
+
+  /// @brief handle の指す要素を取り除く
+  bool Erase(Handle handle) {
+    if (!Contains(handle)) {
+      return false;
+    }
+    RemoveAt(position_[handle.index_]);
+    return true;
+  }
+
+  /// @brief 優先度を上げる (Top 側へ移動させる)
+  /// @return value が元より優先度の低い場合は何もせず false
+  bool DecreaseKey(Handle handle, T value) {
+    if (!Contains(handle)) {
+      return false;
+    }
+
+    auto const index = position_[handle.index_];
+    if (compare_(value, heap_[index].value)) {
+      return false;
+    }
+    SiftUp(index, Entry{std::move(value), handle.index_});
+    return true;
+  }
+
+  /// @brief 値を置き換えて位置を直す (優先度はどちら向きでもよい)
+  bool Update(Handle handle, T value) {
+    if (!Contains(handle)) {
+      return false;
+    }
+
+    auto const index = position_[handle.index_];
+    Entry entry{std::move(value), handle.index_};
+    if (index > 0 && compare_(heap_[Parent(index)].value, entry.value)) {
+      SiftUp(index, std::move(entry));
+    } else {
+      SiftDown(index, std::move(entry));
+    }
+    return true;
+  }
+
+  void Clear() {
+    for (size_t i = 0; i < size_; i++) {
+      heap_[i].value = T();
+    }
+    // 残っていた要素の Handle も無効にする
+    for (size_t slot = 0; slot < next_slot_; slot++) {
+      if (position_[slot] != kNone) {
+        position_[slot] = kNone;
+        generation_[slot]++;
+      }
+    }
+    size_ = 0;
+    next_slot_ = 0;
+    free_count_ = 0;
+  }
+
+ private:
+  static constexpr size_t Parent(size_t index) { return (index - 1) / Arity; }
+  static constexpr size_t FirstChild(size_t index) {
+    return index * Arity + 1;
+  }
+
+  Index AllocateSlot() {
+    if (free_count_ > 0) {
+      return free_slots_[--free_count_];
+    }
+    return static_cast<Index>(next_slot_++);
+  }
+
+  void FreeSlot(Index slot) {
+    position_[slot] = kNone;
+    generation_[slot]++;
+    free_slots_[free_count_++] = slot;
+  }
+
+  void Place(size_t index, Entry&& entry) {
+    position_[entry.slot] = static_cast<Index>(index);
+    heap_[index] = std::move(entry);
+  }
+
+  /// index を穴として entry を上へ移す
+  void SiftUp(size_t index, Entry&& entry) {
+    while (index > 0) {
+      auto const parent = Parent(index);
+      if (!compare_(heap_[parent].value, entry.value)) {
+        break;
+      }
+      Place(index, std::move(heap_[parent]));
+      index = parent;
+    }
+    Place(index, std::move(entry));
+  }
+
+  /// index を穴として entry を下へ移す
+  void SiftDown(size_t index, Entry&& entry) {
+    while (true) {
+      auto const first = FirstChild(index);
+      if (first >= size_) {
+        break;
+      }
+
+      auto const last = first + Arity < size_ ? first + Arity : size_;
+      auto best = first;
+      for (auto child = first + 1; child < last; child++) {
+        if (compare_(heap_[best].value, heap_[child].value)) {
+          best = child;
+        }
+      }
+
+      if (!compare_(entry.value, heap_[best].value)) {
+        break;
+      }
+      Place(index, std::move(heap_[best]));
+      index = best;
+    }
+    Place(index, std::move(entry));
+  }
+
+  void RemoveAt(size_t index) {
+    FreeSlot(heap_[index].slot);
+
+    auto const last = --size_;
+    if (index == last) {
+      heap_[last].value = T();
+      return;
+    }
+
+    Entry moved = std::move(heap_[last]);
+    heap_[last].value = T();
+    if (index > 0 && compare_(heap_[Parent(index)].value, moved.value)) {
+      SiftUp(index, std::move(moved));
+    } else {
+      SiftDown(index, std::move(moved));
+    }
+  }
+
+  std::array<Entry, N> heap_{};
+  std::array<Index, N> position_{};
+  std::array<Index, N> free_slots_{};
+  std::array<Generation, N> generation_{};
+  size_t size_ = 0;
+  size_t next_slot_ = 0;
+  size_t free_count_ = 0;
+  [[no_unique_address]] Compare compare_{};
+};
+
+}  // namespace Nano::collection
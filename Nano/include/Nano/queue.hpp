@@ -3,6 +3,12 @@
 #include <array>
 #include <cstddef>
 #include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "span.hpp"
 
 namespace Nano::collection {
 template <typename T, size_t N>
@@ -53,66 +59,104 @@ class Queue {
    *   auto data = buffer_[tail_]
    */
 
-  std::array<T, N> buffer_ = {};
+  union Slot {
+    struct Empty {};
+
+    constexpr Slot() : empty() {}
+    ~Slot() requires std::is_trivially_destructible_v<T> = default;
+    ~Slot() {}
+
+    Empty empty;
+    T value;
+  };
+  static_assert(sizeof(Slot) == sizeof(T));
+
+  static constexpr bool kTrivial = std::is_trivially_copyable_v<T>;
+
+  // 未構築の領域。[tail_ + 1, head_) のみが生きている
+  std::array<Slot, N> buffer_{};
   size_t head_ = 0;
   size_t tail_ = N - 1;
 
- public:
-  Queue() {
-    while (!Full()) {
-      Push({});
+  T* At(size_t index) { return &buffer_[index].value; }
+  T const* At(size_t index) const { return &buffer_[index].value; }
+
+  void DestroyN(size_t start, size_t n) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t i = 0; i < n; i++) {
+        std::destroy_at(At((start + i) % N));
+      }
     }
-    while (!Empty()) {
-      Pop();
+  }
+
+ public:
+  /// @note 要素を構築しないので constinit で .bss に置ける
+  constexpr Queue() = default;
+
+  /// @note コピーは生きている要素だけを同じ位置に複製する
+  Queue(Queue const&) requires kTrivial = default;
+  Queue(Queue const& other) requires(!kTrivial &&
+                                     std::is_copy_constructible_v<T>) {
+    CopyFrom(other);
+  }
+
+  Queue& operator=(Queue const&) requires kTrivial = default;
+  Queue& operator=(Queue const& other) requires(
+      !kTrivial && std::is_copy_constructible_v<T>) {
+    if (this != &other) {
+      Clear();
+      CopyFrom(other);
     }
+    return *this;
   }
 
+  ~Queue() requires std::is_trivially_destructible_v<T> = default;
+  ~Queue() { Clear(); }
+
   bool Empty() const volatile { return (N + tail_ - head_ + 1) % N == 0; }
 
   bool Full() const { return head_ == tail_; }
 
   void Clear() {
+    DestroyN(tail_ + 1, Size());
     head_ = 0;
     tail_ = N - 1;
   }
 
-  void ClearDatas() { memset(buffer_.data(), 0, sizeof(buffer_)); }
+  void ClearDatas() requires std::is_trivially_copyable_v<T> {
+    memset(static_cast<void*>(buffer_.data()), 0, sizeof(buffer_));
+  }
 
-  bool Push(T const& data) {
+  /// @brief 末尾に直接構築する
+  template <typename... Args>
+  bool Emplace(Args&&... args) {
     if (Full()) {
       return false;
     }
 
-    buffer_[head_] = data;
+    std::construct_at(At(head_), std::forward<Args>(args)...);
     head_ = (head_ + 1) % N;
 
     return true;
   }
 
+  bool Push(T const& data) { return Emplace(data); }
+  bool Push(T&& data) { return Emplace(std::move(data)); }
+
   bool PushN(T const* data, size_t n) {
-    if (Size() + n > Capacity()) {
+    if (n == 0) {
+      return true;
+    }
+    // 使えるのは N - 1 要素まで (head_ == tail_ が満杯)
+    if (Size() + n > N - 1) {
       return false;
     }
 
-    auto start = head_;
-    auto end = (head_ + n) % N;
-
-    if (start < end) {
-      std::copy(data, data + n, buffer_.begin() + start);
-    } else {
-      auto first_range_lo = start;
-      auto first_range_hi = N;
-      auto first_range_size = first_range_hi - first_range_lo;
-
-      auto second_range_lo = 0;
+    auto const first = n < N - head_ ? n : N - head_;
+    CopyIn(head_, data, first);
+    CopyIn(0, data + first, n - first);
 
-      std::copy(data, data + first_range_size,
-                buffer_.begin() + first_range_lo);
-      std::copy(data + first_range_size, data + n,
-                buffer_.begin() + second_range_lo);
-    }
-
-    head_ = end;
+    head_ = (head_ + n) % N;
 
     return true;
   }
@@ -122,22 +166,10 @@ class Queue {
       return;
     }
 
-    auto start = tail_ + 1;
-
-    if (auto end = (tail_ + n + 1) % N; start < end) {
-      std::copy(buffer_.begin() + start, buffer_.begin() + end, data);
-    } else {
-      auto first_range_lo = start;
-      auto first_range_hi = N;
-      auto first_range_size = first_range_hi - first_range_lo;
-
-      auto second_range_lo = 0;
-
-      std::copy(buffer_.begin() + first_range_lo,
-                buffer_.begin() + first_range_hi, data);
-      std::copy(buffer_.begin() + second_range_lo, buffer_.begin() + end,
-                data + first_range_size);
-    }
+    auto const start = (tail_ + 1) % N;
+    auto const first = n < N - start ? n : N - start;
+    MoveOut(start, data, first);
+    MoveOut(0, data + first, n - first);
 
     tail_ = (tail_ + n) % N;
   }
@@ -148,30 +180,179 @@ class Queue {
     return data_count;
   }
 
-  T Pop() {
+  /// @brief 先頭を取り出す (空なら T{})
+  T Pop() requires std::is_default_constructible_v<T> {
     if (Empty()) {
       return {};
     }
 
     tail_ = (tail_ + 1) % N;
-    auto data = buffer_[tail_];
+    T data = std::move(*At(tail_));
+    std::destroy_at(At(tail_));
 
     return data;
   }
 
+  /// @brief 先頭を out にムーブして取り出す
+  /// @return 空なら false
+  bool TryPop(T& out) {
+    if (Empty()) {
+      return false;
+    }
+
+    tail_ = (tail_ + 1) % N;
+    out = std::move(*At(tail_));
+    std::destroy_at(At(tail_));
+
+    return true;
+  }
+
+  /// @brief 先頭への参照 (空の場合は未定義動作)
+  T& Front() { return *At((tail_ + 1) % N); }
+  T const& Front() const { return *At((tail_ + 1) % N); }
+
+  /// @brief 先頭へのポインタ (空なら nullptr)
+  T* Peek() { return Empty() ? nullptr : &Front(); }
+  T const* Peek() const { return Empty() ? nullptr : &Front(); }
+
   void ConsumeN(size_t n) {
     if (n > Size()) {
       return;
     }
 
+    DestroyN(tail_ + 1, n);
     tail_ = (tail_ + n) % N;
   }
 
-  T& operator[](size_t index) { return buffer_[(1 + tail_ + index) % N]; }
+  T& operator[](size_t index) { return *At((1 + tail_ + index) % N); }
 
   size_t Size() const { return (N - (tail_ - head_) - 1) % N; }
 
   size_t Capacity() const { return N; }
+
+  /// @brief キューの中身を表す高々 2 つの連続領域
+  /// @details first -> second の順に先頭から並ぶ。折り返していなければ
+  ///          second は空
+  template <typename U>
+  struct SegmentPair {
+    Span<U> first;
+    Span<U> second;
+
+    [[nodiscard]] size_t size() const { return first.size() + second.size(); }
+  };
+
+  /// @brief 中身を連続領域として参照する (memchr や CRC をそのまま回せる)
+  /// @note 返した Span は次の Push / Pop まで有効
+  SegmentPair<T> Segments() { return MakeSegments<T>(this); }
+  SegmentPair<const T> Segments() const { return MakeSegments<const T>(this); }
+
+  /// @brief 内部の配列 (N 要素) を外部 (循環 DMA など) に書かせる
+  /// @details 書き込みは末尾 (Segments の後ろ) から順に折り返して進め、
+  ///          書き終えた分を CommitN で見せる
+  Span<T> Storage() requires kTrivial { return Span<T>(At(0), N); }
+
+  /// @brief Storage に外部から書き込まれた n 要素を末尾に加える
+  /// @return 入りきらなければ false (何もしない)
+  bool CommitN(size_t n) requires kTrivial {
+    if (Size() + n > N - 1) {
+      return false;
+    }
+    head_ = (head_ + n) % N;
+    return true;
+  }
+
+  /// @brief 先頭から順に辿るイテレータ (剰余を使わずに折り返す)
+  template <typename U>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_cv_t<U>;
+    using difference_type = std::ptrdiff_t;
+    using reference = U&;
+    using pointer = U*;
+
+    Iterator() = default;
+    Iterator(U* pos, U* buffer) : pos_(pos), buffer_(buffer) {}
+
+    U& operator*() const { return *pos_; }
+    U* operator->() const { return pos_; }
+
+    Iterator& operator++() {
+      if (++pos_ == buffer_ + N) {
+        pos_ = buffer_;
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    // 満杯 (head_ == tail_) でも begin != end なので位置だけで比較できる
+    bool operator==(Iterator const& other) const { return pos_ == other.pos_; }
+
+   private:
+    U* pos_ = nullptr;
+    U* buffer_ = nullptr;
+  };
+
+  using iterator = Iterator<T>;
+  using const_iterator = Iterator<const T>;
+
+  iterator begin() { return {At((tail_ + 1) % N), At(0)}; }
+  iterator end() { return {At(head_), At(0)}; }
+  const_iterator begin() const { return {At((tail_ + 1) % N), At(0)}; }
+  const_iterator end() const { return {At(head_), At(0)}; }
+
+ private:
+  template <typename U, typename Self>
+  static SegmentPair<U> MakeSegments(Self* self) {
+    auto const size = self->Size();
+    auto const start = (self->tail_ + 1) % N;
+    auto const first = size < N - start ? size : N - start;
+
+    return {Span<U>(self->At(start), first),
+            Span<U>(self->At(0), size - first)};
+  }
+
+  // 空のキューに other の中身を同じ位置で構築する
+  void CopyFrom(Queue const& other) {
+    auto const segments = other.Segments();
+    auto const start = (other.tail_ + 1) % N;
+    CopyIn(start, segments.first.data(), segments.first.size());
+    CopyIn(0, segments.second.data(), segments.second.size());
+    head_ = other.head_;
+    tail_ = other.tail_;
+  }
+
+  void CopyIn(size_t index, T const* data, size_t n) {
+    if (n == 0) {
+      return;
+    }
+    if constexpr (kTrivial) {
+      memcpy(static_cast<void*>(At(index)), data, n * sizeof(T));
+    } else {
+      for (size_t i = 0; i < n; i++) {
+        std::construct_at(At(index + i), data[i]);
+      }
+    }
+  }
+
+  void MoveOut(size_t index, T* data, size_t n) {
+    if (n == 0) {
+      return;
+    }
+    if constexpr (kTrivial) {
+      memcpy(data, static_cast<void*>(At(index)), n * sizeof(T));
+    } else {
+      for (size_t i = 0; i < n; i++) {
+        data[i] = std::move(*At(index + i));
+        std::destroy_at(At(index + i));
+      }
+    }
+  }
 };
 
 }  // namespace Nano::collection
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
 namespace Nano::utils::result {
@@ -10,11 +12,28 @@ struct ResultErrorType {
   E error;
 };
 
+template <>
+struct ResultErrorType<void> {};
+
 template <typename T>
 struct ResultValueType {
   T value;
 };
 
+template <>
+struct ResultValueType<void> {};
+
+template <typename T, typename E>
+class Result;
+
+namespace detail {
+template <typename R>
+struct IsResult : std::false_type {};
+
+template <typename T, typename E>
+struct IsResult<Result<T, E>> : std::true_type {};
+}  // namespace detail
+
 template <typename T, typename E>
 class Result {
   using ValueT = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
@@ -28,43 +47,317 @@ class Result {
     kError,
   };
 
-  Tag tag_;
+  static constexpr bool kTrivial = std::is_trivially_copyable_v<ValueT> &&
+                                   std::is_trivially_copyable_v<ErrorT> &&
+                                   std::is_trivially_destructible_v<ValueT> &&
+                                   std::is_trivially_destructible_v<ErrorT>;
 
-  ValueT value_;
-  ErrorT error_;
+  // value_ と error_ は同じ領域を共有し、tag_ が生きている方を示す
+  union {
+    ValueT value_;
+    ErrorT error_;
+  };
+  Tag tag_;
 
  public:
-  Result(T value) = delete;
-  Result(E error) = delete;
+  using ValueType = T;
+  using ErrorType = E;
+
+  template <typename U>
+  requires(std::is_same_v<std::decay_t<U>, ValueT> ||
+           std::is_same_v<std::decay_t<U>, ErrorT>) Result(U&&) = delete;
+
+  explicit(false) Result(ResultErrorType<E> error) requires(!std::is_void_v<E>)
+      : error_(std::move(error.error)), tag_(Tag::kError) {}
+
+  explicit(false) Result(ResultErrorType<E>) requires(std::is_void_v<E>)
+      : error_(), tag_(Tag::kError) {}
+
+  explicit(false) Result(ResultValueType<T> value) requires(!std::is_void_v<T>)
+      : value_(std::move(value.value)), tag_(Tag::kOk) {}
+
+  explicit(false) Result(ResultValueType<T>) requires(std::is_void_v<T>)
+      : value_(), tag_(Tag::kOk) {}
+
+  Result() requires std::is_default_constructible_v<ValueT>
+      : value_(), tag_(Tag::kOk) {}
+
+  Result(Result const& other) requires kTrivial = default;
+  Result(Result const& other) : tag_(other.tag_) {
+    if (IsOk()) {
+      std::construct_at(&value_, other.value_);
+    } else {
+      std::construct_at(&error_, other.error_);
+    }
+  }
+
+  Result(Result&& other) requires kTrivial = default;
+  Result(Result&& other) noexcept(
+      std::is_nothrow_move_constructible_v<ValueT>&&
+          std::is_nothrow_move_constructible_v<ErrorT>)
+      : tag_(other.tag_) {
+    if (IsOk()) {
+      std::construct_at(&value_, std::move(other.value_));
+    } else {
+      std::construct_at(&error_, std::move(other.error_));
+    }
+  }
+
+  Result& operator=(Result const& other) requires kTrivial = default;
+  Result& operator=(Result const& other) {
+    if (this != &other) {
+      Destroy();
+      std::construct_at(this, other);
+    }
+    return *this;
+  }
 
-  explicit(false) Result(ResultErrorType<E> error)
-      : tag_(Tag::kError), error_(error.error) {}
+  Result& operator=(Result&& other) requires kTrivial = default;
+  Result& operator=(Result&& other) noexcept(
+      std::is_nothrow_move_constructible_v<ValueT>&&
+          std::is_nothrow_move_constructible_v<ErrorT>) {
+    if (this != &other) {
+      Destroy();
+      std::construct_at(this, std::move(other));
+    }
+    return *this;
+  }
 
-  explicit(false) Result(ResultValueType<T> value)
-      : tag_(Tag::kOk), value_(value.value) {}
+  ~Result() requires kTrivial = default;
+  ~Result() { Destroy(); }
 
-  Result() = default;
+  [[nodiscard]] bool IsOk() const { return tag_ == Tag::kOk; }
+  [[nodiscard]] bool IsErr() const { return tag_ == Tag::kError; }
 
-  std::optional<T> Value() const requires(!std::is_void_v<T>) {
-    if (tag_ == Tag::kError) {
+  /// @brief 値のコピーを返す (エラーなら std::nullopt)
+  std::optional<T> Value() const& requires(!std::is_void_v<T>) {
+    if (IsErr()) {
       return std::nullopt;
     }
     return value_;
   }
 
-  std::optional<E> Error() const {
-    if (tag_ == Tag::kOk) {
+  std::optional<T> Value() && requires(!std::is_void_v<T>) {
+    if (IsErr()) {
+      return std::nullopt;
+    }
+    return std::move(value_);
+  }
+
+  /// @brief エラーのコピーを返す (成功なら std::nullopt)
+  std::optional<E> Error() const& requires(!std::is_void_v<E>) {
+    if (IsOk()) {
       return std::nullopt;
     }
     return error_;
   }
 
-  [[nodiscard]] bool IsOk() const { return tag_ == Tag::kOk; }
+  std::optional<E> Error() && requires(!std::is_void_v<E>) {
+    if (IsOk()) {
+      return std::nullopt;
+    }
+    return std::move(error_);
+  }
+
+  /// @brief 値への参照を返す
+  /// @note IsOk() でない場合は未定義動作
+  ValueT& Unwrap() & requires(!std::is_void_v<T>) { return value_; }
+  ValueT const& Unwrap() const& requires(!std::is_void_v<T>) {
+    return value_;
+  }
+  ValueT&& Unwrap() && requires(!std::is_void_v<T>) {
+    return std::move(value_);
+  }
+
+  /// @brief エラーへの参照を返す
+  /// @note IsErr() でない場合は未定義動作
+  ErrorT& UnwrapErr() & requires(!std::is_void_v<E>) { return error_; }
+  ErrorT const& UnwrapErr() const& requires(!std::is_void_v<E>) {
+    return error_;
+  }
+  ErrorT&& UnwrapErr() && requires(!std::is_void_v<E>) {
+    return std::move(error_);
+  }
+
+  template <typename U>
+  T ValueOr(U&& fallback) const& requires(!std::is_void_v<T>) {
+    return IsOk() ? value_ : static_cast<T>(static_cast<U&&>(fallback));
+  }
+
+  /// @brief 成功なら fn(value) -> Result<U, E> を続けて実行する
+  template <typename F>
+  auto AndThen(F&& fn) & {
+    return AndThenImpl(*this, static_cast<F&&>(fn));
+  }
+  template <typename F>
+  auto AndThen(F&& fn) const& {
+    return AndThenImpl(*this, static_cast<F&&>(fn));
+  }
+  template <typename F>
+  auto AndThen(F&& fn) && {
+    return AndThenImpl(std::move(*this), static_cast<F&&>(fn));
+  }
+
+  /// @brief 成功なら値を fn(value) に変換する
+  template <typename F>
+  auto Map(F&& fn) & {
+    return MapImpl(*this, static_cast<F&&>(fn));
+  }
+  template <typename F>
+  auto Map(F&& fn) const& {
+    return MapImpl(*this, static_cast<F&&>(fn));
+  }
+  template <typename F>
+  auto Map(F&& fn) && {
+    return MapImpl(std::move(*this), static_cast<F&&>(fn));
+  }
+
+  /// @brief エラーなら fn(error) -> Result<T, E2> で回復を試みる
+  template <typename F>
+  auto OrElse(F&& fn) & {
+    return OrElseImpl(*this, static_cast<F&&>(fn));
+  }
+  template <typename F>
+  auto OrElse(F&& fn) const& {
+    return OrElseImpl(*this, static_cast<F&&>(fn));
+  }
+  template <typename F>
+  auto OrElse(F&& fn) && {
+    return OrElseImpl(std::move(*this), static_cast<F&&>(fn));
+  }
+
+  /// @brief エラーなら fn(error) でエラーを変換する
+  template <typename F>
+  auto MapErr(F&& fn) & {
+    return MapErrImpl(*this, static_cast<F&&>(fn));
+  }
+  template <typename F>
+  auto MapErr(F&& fn) const& {
+    return MapErrImpl(*this, static_cast<F&&>(fn));
+  }
+  template <typename F>
+  auto MapErr(F&& fn) && {
+    return MapErrImpl(std::move(*this), static_cast<F&&>(fn));
+  }
+
+ private:
+  template <typename, typename>
+  friend class Result;
+
+  void Destroy() {
+    if (IsOk()) {
+      std::destroy_at(&value_);
+    } else {
+      std::destroy_at(&error_);
+    }
+  }
+
+  template <typename Self, typename F>
+  static decltype(auto) InvokeWithValue(Self&& self, F&& fn) {
+    if constexpr (std::is_void_v<T>) {
+      return static_cast<F&&>(fn)();
+    } else {
+      return static_cast<F&&>(fn)(std::forward<Self>(self).value_);
+    }
+  }
+
+  template <typename Self, typename F>
+  static decltype(auto) InvokeWithError(Self&& self, F&& fn) {
+    if constexpr (std::is_void_v<E>) {
+      return static_cast<F&&>(fn)();
+    } else {
+      return static_cast<F&&>(fn)(std::forward<Self>(self).error_);
+    }
+  }
+
+  template <typename Self>
+  static auto ForwardError(Self&& self) {
+    if constexpr (std::is_void_v<E>) {
+      return ResultErrorType<E>{};
+    } else {
+      return ResultErrorType<E>{std::forward<Self>(self).error_};
+    }
+  }
+
+  template <typename Self>
+  static auto ForwardValue(Self&& self) {
+    if constexpr (std::is_void_v<T>) {
+      return ResultValueType<T>{};
+    } else {
+      return ResultValueType<T>{std::forward<Self>(self).value_};
+    }
+  }
+
+  template <typename Self, typename F>
+  static auto AndThenImpl(Self&& self, F&& fn) {
+    using R = std::remove_cvref_t<decltype(InvokeWithValue(
+        std::forward<Self>(self), static_cast<F&&>(fn)))>;
+    static_assert(detail::IsResult<R>::value,
+                  "AndThen callback must return a Result");
+    static_assert(std::is_same_v<typename R::ErrorType, E>,
+                  "AndThen callback must keep the error type");
+
+    if (self.IsErr()) {
+      return R(ForwardError(std::forward<Self>(self)));
+    }
+    return InvokeWithValue(std::forward<Self>(self), static_cast<F&&>(fn));
+  }
+
+  template <typename Self, typename F>
+  static auto MapImpl(Self&& self, F&& fn) {
+    using U = std::remove_cvref_t<decltype(InvokeWithValue(
+        std::forward<Self>(self), static_cast<F&&>(fn)))>;
+    using R = Result<U, E>;
+
+    if (self.IsErr()) {
+      return R(ForwardError(std::forward<Self>(self)));
+    }
+    if constexpr (std::is_void_v<U>) {
+      InvokeWithValue(std::forward<Self>(self), static_cast<F&&>(fn));
+      return R(ResultValueType<void>{});
+    } else {
+      return R(ResultValueType<U>{
+          InvokeWithValue(std::forward<Self>(self), static_cast<F&&>(fn))});
+    }
+  }
+
+  template <typename Self, typename F>
+  static auto OrElseImpl(Self&& self, F&& fn) {
+    using R = std::remove_cvref_t<decltype(InvokeWithError(
+        std::forward<Self>(self), static_cast<F&&>(fn)))>;
+    static_assert(detail::IsResult<R>::value,
+                  "OrElse callback must return a Result");
+    static_assert(std::is_same_v<typename R::ValueType, T>,
+                  "OrElse callback must keep the value type");
+
+    if (self.IsOk()) {
+      return R(ForwardValue(std::forward<Self>(self)));
+    }
+    return InvokeWithError(std::forward<Self>(self), static_cast<F&&>(fn));
+  }
+
+  template <typename Self, typename F>
+  static auto MapErrImpl(Self&& self, F&& fn) {
+    using E2 = std::remove_cvref_t<decltype(InvokeWithError(
+        std::forward<Self>(self), static_cast<F&&>(fn)))>;
+    using R = Result<T, E2>;
+
+    if (self.IsOk()) {
+      return R(ForwardValue(std::forward<Self>(self)));
+    }
+    if constexpr (std::is_void_v<E2>) {
+      InvokeWithError(std::forward<Self>(self), static_cast<F&&>(fn));
+      return R(ResultErrorType<void>{});
+    } else {
+      return R(ResultErrorType<E2>{
+          InvokeWithError(std::forward<Self>(self), static_cast<F&&>(fn))});
+    }
+  }
 };
 
 template <typename T>
 static ResultValueType<T> Ok(T value) requires(!std::is_void_v<T>) {
-  return ResultValueType{value};
+  return ResultValueType<T>{std::move(value)};
 }
 
 template <std::same_as<void> T>
@@ -74,7 +367,7 @@ static ResultValueType<T> Ok() {
 
 template <typename E>
 static ResultErrorType<E> Err(E error) {
-  return ResultErrorType<E>{error};
+  return ResultErrorType<E>{std::move(error)};
 }
 
 }  // namespace Nano::utils::result
@@ -83,4 +376,4 @@ namespace Nano::utils {
 using result::Err;
 using result::Ok;
 using result::Result;
-}  // namespace Nano::utils
\ No newline at end of file
+}  // namespace Nano::utils
@@ -1,21 +1,45 @@
 #pragma once
 
-#include <array>
 #include <cstddef>
 
+#include "arena.hpp"
+
+#ifndef NANO_SCRATCH_ISR_SIZE
+#define NANO_SCRATCH_ISR_SIZE 0x80
+#endif
+
+#ifndef NANO_SCRATCH_APP_SIZE
+#define NANO_SCRATCH_APP_SIZE 0x80
+#endif
+
 namespace Nano::utils {
 
+/// @brief 実行コンテキストごとの一時領域
+/// @details
+///   ArenaScope scope(ScratchBuffer::ISR()); のようにスコープ単位で使う。
+///   スレッドごとの領域が必要な場合はスレッド側で StaticArena を持つこと
 class ScratchBuffer {
-  static constexpr const std::size_t kBufferSize = 0x80;
-  static inline std::array<char, kBufferSize> buffer_isr_{};
-  static inline std::array<char, kBufferSize> buffer_app_{};
-
  public:
+  static constexpr std::size_t kISRSize = NANO_SCRATCH_ISR_SIZE;
+  static constexpr std::size_t kAppSize = NANO_SCRATCH_APP_SIZE;
+
+  /// @brief ISR 用の Arena を取得する
+  static Arena& ISR() { return isr_; }
+
+  /// @brief アプリケーション (メインスレッド) 用の Arena を取得する
+  static Arena& App() { return app_; }
+
   /// @brief ISR 用のバッファを取得する
-  static void* GetISRBuffer() { return buffer_isr_.data(); }
+  /// @deprecated ISR() と ArenaScope を使うこと
+  static void* GetISRBuffer() { return isr_.Data(); }
 
   /// @brief アプリケーション用のバッファを取得する
-  static void* GetAppBuffer() { return buffer_app_.data(); }
+  /// @deprecated App() と ArenaScope を使うこと
+  static void* GetAppBuffer() { return app_.Data(); }
+
+ private:
+  static inline StaticArena<kISRSize> isr_{};
+  static inline StaticArena<kAppSize> app_{};
 };
 
-}  // namespace Nano::utils
\ No newline at end of file
+}  // namespace Nano::utils
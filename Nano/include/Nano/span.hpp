@@ -1,33 +1,218 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <span>
 #include <type_traits>
 
 namespace Nano::collection {
-template <typename T>
-class Span {
+
+inline constexpr size_t kDynamicExtent = static_cast<size_t>(-1);
+
+namespace span_detail {
+
+// 固定長の場合はサイズを持たない
+template <size_t Extent>
+class ExtentStorage {
+ public:
+  constexpr ExtentStorage() = default;
+  constexpr explicit ExtentStorage(size_t) {}
+
+  [[nodiscard]] constexpr size_t size() const { return Extent; }
+};
+
+template <>
+class ExtentStorage<kDynamicExtent> {
+ public:
+  constexpr ExtentStorage() = default;
+  constexpr explicit ExtentStorage(size_t size) : size_(size) {}
+
+  [[nodiscard]] constexpr size_t size() const { return size_; }
+
+ private:
+  size_t size_ = 0;
+};
+
+template <typename From, typename To>
+inline constexpr bool kIsArrayConvertible =
+    std::is_convertible_v<From (*)[], To (*)[]>;  // NOLINT
+
+}  // namespace span_detail
+
+/// @brief 連続領域への参照 (コピーせずに部分列を切り出せる)
+/// @tparam T 要素型
+/// @tparam Extent 要素数 (kDynamicExtent なら実行時に保持)
+template <typename T, size_t Extent = kDynamicExtent>
+class Span : private span_detail::ExtentStorage<Extent> {
+  using Storage = span_detail::ExtentStorage<Extent>;
+
  public:
-  Span(T* data, size_t size) : data_(data), size_(size) {}
-  Span() : data_(nullptr), size_(0) {}
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = size_t;
+  using pointer = T*;
+  using reference = T&;
+  using iterator = T*;
+
+  static constexpr size_t extent = Extent;
+
+  constexpr Span() requires(Extent == kDynamicExtent || Extent == 0)
+      : data_(nullptr) {}
+
+  constexpr explicit(Extent != kDynamicExtent) Span(T* data, size_t size)
+      : Storage(size), data_(data) {}
+
+  template <size_t N>
+  requires(Extent == kDynamicExtent || Extent == N) constexpr Span(
+      T (&array)[N])  // NOLINT
+      : Storage(N), data_(array) {}
+
+  template <typename U, size_t N>
+  requires((Extent == kDynamicExtent || Extent == N) &&
+           span_detail::kIsArrayConvertible<U, T>) constexpr Span(
+      std::array<U, N>& array)  // NOLINT
+      : Storage(N), data_(array.data()) {}
+
+  template <typename U, size_t N>
+  requires((Extent == kDynamicExtent || Extent == N) &&
+           span_detail::kIsArrayConvertible<const U, T>) constexpr Span(
+      std::array<U, N> const& array)  // NOLINT
+      : Storage(N), data_(array.data()) {}
 
   // copy
-  Span(Span<T>& other) = default;
+  constexpr Span(Span const& other) = default;
+  constexpr Span& operator=(Span const& other) = default;
 
-  template <typename U>
-  explicit(false)
-      Span(const Span<U>& other) requires std::is_convertible_v<U*, T*>
-      : data_(other.data()), size_(other.size()) {}
+  template <typename U, size_t N>
+  requires((Extent == kDynamicExtent || N == kDynamicExtent || Extent == N) &&
+           span_detail::kIsArrayConvertible<U, T>) constexpr explicit(
+      Extent != kDynamicExtent && N == kDynamicExtent)
+      Span(const Span<U, N>& other)
+      : Storage(other.size()), data_(other.data()) {}
 
-  T* data() const { return data_; }
-  [[nodiscard]] size_t size() const { return size_; }
+  /// @brief std::span からの変換
+  template <typename U, size_t N>
+  requires((Extent == kDynamicExtent || N == std::dynamic_extent ||
+            Extent == N) &&
+           span_detail::kIsArrayConvertible<U, T>) constexpr explicit(
+      Extent != kDynamicExtent && N == std::dynamic_extent)
+      Span(std::span<U, N> other)
+      : Storage(other.size()), data_(other.data()) {}
 
-  T& operator[](size_t index) {
+  /// @brief std::span への変換
+  constexpr operator std::span<T, Extent == kDynamicExtent  // NOLINT
+                                      ? std::dynamic_extent
+                                      : Extent>() const {
+    return std::span<T, Extent == kDynamicExtent ? std::dynamic_extent
+                                                 : Extent>(data_, size());
+  }
+
+  constexpr T* data() const { return data_; }
+  [[nodiscard]] constexpr size_t size() const { return Storage::size(); }
+  [[nodiscard]] constexpr size_t size_bytes() const {
+    return size() * sizeof(T);
+  }
+  [[nodiscard]] constexpr bool empty() const { return size() == 0; }
+
+  constexpr T& operator[](size_t index) const {
     // NOLINTNEXTLINE (cppcoreguidelines-pro-bounds-pointer-arithmetic)
     return data_[index];
   }
 
+  constexpr T& front() const { return data_[0]; }
+  constexpr T& back() const { return data_[size() - 1]; }
+
+  constexpr iterator begin() const { return data_; }
+  constexpr iterator end() const { return data_ + size(); }
+
+  /// @brief 先頭 Count 要素
+  template <size_t Count>
+  constexpr Span<T, Count> first() const {
+    static_assert(Extent == kDynamicExtent || Count <= Extent);
+    return Span<T, Count>(data_, Count);
+  }
+
+  constexpr Span<T> first(size_t count) const { return {data_, count}; }
+
+  /// @brief 末尾 Count 要素
+  template <size_t Count>
+  constexpr Span<T, Count> last() const {
+    static_assert(Extent == kDynamicExtent || Count <= Extent);
+    return Span<T, Count>(data_ + size() - Count, Count);
+  }
+
+  constexpr Span<T> last(size_t count) const {
+    return {data_ + size() - count, count};
+  }
+
+  /// @brief Offset から Count 要素 (Count 省略時は末尾まで)
+  template <size_t Offset, size_t Count = kDynamicExtent>
+  constexpr auto subspan() const {
+    static_assert(Extent == kDynamicExtent || Offset <= Extent);
+    static_assert(Extent == kDynamicExtent || Count == kDynamicExtent ||
+                  Offset + Count <= Extent);
+
+    if constexpr (Count != kDynamicExtent) {
+      return Span<T, Count>(data_ + Offset, Count);
+    } else if constexpr (Extent != kDynamicExtent) {
+      return Span<T, Extent - Offset>(data_ + Offset, Extent - Offset);
+    } else {
+      return Span<T>(data_ + Offset, size() - Offset);
+    }
+  }
+
+  constexpr Span<T> subspan(size_t offset,
+                            size_t count = kDynamicExtent) const {
+    return {data_ + offset, count == kDynamicExtent ? size() - offset : count};
+  }
+
  private:
   T* data_;
-  size_t size_;
 };
-}  // namespace Nano::collection
\ No newline at end of file
+
+template <typename T, size_t N>
+Span(T (&)[N]) -> Span<T, N>;  // NOLINT
+
+template <typename T, size_t N>
+Span(std::array<T, N>&) -> Span<T, N>;
+
+template <typename T, size_t N>
+Span(std::array<T, N> const&) -> Span<const T, N>;
+
+template <typename T>
+Span(T*, size_t) -> Span<T>;
+
+namespace span_detail {
+template <typename T, size_t Extent>
+inline constexpr size_t kBytesExtent =
+    Extent == kDynamicExtent ? kDynamicExtent : Extent * sizeof(T);
+}  // namespace span_detail
+
+/// @brief 要素列をバイト列として参照する
+template <typename T, size_t Extent>
+Span<const uint8_t, span_detail::kBytesExtent<T, Extent>> AsBytes(
+    Span<T, Extent> span) {
+  return Span<const uint8_t, span_detail::kBytesExtent<T, Extent>>(
+      reinterpret_cast<const uint8_t*>(span.data()), span.size_bytes());
+}
+
+/// @brief 要素列を書き込み可能なバイト列として参照する
+template <typename T, size_t Extent>
+requires(!std::is_const_v<T>)
+    Span<uint8_t, span_detail::kBytesExtent<T, Extent>> AsWritableBytes(
+        Span<T, Extent> span) {
+  return Span<uint8_t, span_detail::kBytesExtent<T, Extent>>(
+      reinterpret_cast<uint8_t*>(span.data()), span.size_bytes());
+}
+
+/// @brief バイト列を U の列として参照する (端数は切り捨て)
+/// @note data() が alignof(U) に揃っていることは呼び出し側が保証する
+template <typename U, typename Byte, size_t Extent>
+requires(sizeof(Byte) == 1 && std::is_trivially_copyable_v<U> &&
+         (std::is_const_v<U> || !std::is_const_v<Byte>)) Span<U>
+    ReinterpretAs(Span<Byte, Extent> bytes) {
+  return Span<U>(reinterpret_cast<U*>(bytes.data()), bytes.size() / sizeof(U));
+}
+
+}  // namespace Nano::collection
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "span.hpp"
+
+namespace Nano::collection {
+
+/// @brief 容量固定でヒープを使わない std::vector 代替
+/// @details
+///   - 要素は内部の配列に直接構築する (未使用領域は構築しない)
+///   - 容量を超える追加は失敗 (false / nullptr) として扱い、例外は投げない
+///   - trivially copyable な T は memcpy / memmove でまとめて移動する
+///   - Span<T> / Span<const T> に暗黙変換できる
+/// @tparam T 要素型
+/// @tparam N 最大要素数
+template <typename T, size_t N>
+class StaticVector {
+  union Slot {
+    struct Empty {};
+
+    constexpr Slot() : empty() {}
+    ~Slot() requires std::is_trivially_destructible_v<T> = default;
+    ~Slot() {}
+
+    Empty empty;
+    T value;
+  };
+  static_assert(sizeof(Slot) == sizeof(T));
+
+  static constexpr bool kTrivial = std::is_trivially_copyable_v<T>;
+
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using reference = T&;
+  using const_reference = T const&;
+  using pointer = T*;
+  using const_pointer = T const*;
+  using iterator = T*;
+  using const_iterator = T const*;
+
+  constexpr StaticVector() = default;
+
+  /// @brief count 個の値初期化された要素 (N を超える分は切り捨て)
+  explicit StaticVector(size_t count) { resize(count); }
+  StaticVector(size_t count, T const& value) { assign(count, value); }
+  StaticVector(std::initializer_list<T> init) {
+    assign(init.begin(), init.size());
+  }
+  explicit StaticVector(Span<const T> values) {
+    assign(values.data(), values.size());
+  }
+
+  StaticVector(StaticVector const& other) {
+    assign(other.data(), other.size());
+  }
+  StaticVector(StaticVector&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    MoveFrom(std::move(other));
+  }
+
+  StaticVector& operator=(StaticVector const& other) {
+    if (this != &other) {
+      assign(other.data(), other.size());
+    }
+    return *this;
+  }
+
+  StaticVector& operator=(StaticVector&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      clear();
+      MoveFrom(std::move(other));
+    }
+    return *this;
+  }
+
+  ~StaticVector() requires std::is_trivially_destructible_v<T> = default;
+  ~StaticVector() { clear(); }
+
+  // 要素アクセス
+  T* data() { return &buffer_[0].value; }
+  T const* data() const { return &buffer_[0].value; }
+
+  T& operator[](size_t index) { return data()[index]; }
+  T const& operator[](size_t index) const { return data()[index]; }
+
+  T& front() { return data()[0]; }
+  T const& front() const { return data()[0]; }
+  T& back() { return data()[size_ - 1]; }
+  T const& back() const { return data()[size_ - 1]; }
+
+  iterator begin() { return data(); }
+  iterator end() { return data() + size_; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + size_; }
+
+  // 容量
+  [[nodiscard]] size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] bool full() const { return size_ == N; }
+  static constexpr size_t capacity() { return N; }
+  static constexpr size_t max_size() { return N; }
+
+  operator Span<T>() { return {data(), size_}; }              // NOLINT
+  operator Span<const T>() const { return {data(), size_}; }  // NOLINT
+
+  // 変更
+  void clear() {
+    std::destroy(begin(), end());
+    size_ = 0;
+  }
+
+  /// @return 満杯なら false
+  bool push_back(T const& value) { return emplace_back(value) != nullptr; }
+  bool push_back(T&& value) {
+    return emplace_back(std::move(value)) != nullptr;
+  }
+
+  /// @return 構築した要素 (満杯なら nullptr)
+  template <typename... Args>
+  T* emplace_back(Args&&... args) {
+    if (full()) {
+      return nullptr;
+    }
+    return std::construct_at(data() + size_++, std::forward<Args>(args)...);
+  }
+
+  void pop_back() {
+    if (size_ > 0) {
+      std::destroy_at(data() + --size_);
+    }
+  }
+
+  /// @brief pos の前に value を挿入する
+  /// @return 挿入した位置 (満杯なら nullptr)
+  T* insert(const_iterator pos, T value) {
+    auto const index = static_cast<size_t>(pos - begin());
+    if (full() || index > size_) {
+      return nullptr;
+    }
+
+    OpenGap(index, 1);
+    std::construct_at(data() + index, std::move(value));
+    size_++;
+    return data() + index;
+  }
+
+  /// @brief pos の前に [values, values + count) を挿入する
+  /// @return 挿入した先頭位置 (入りきらなければ何もせず nullptr)
+  T* insert(const_iterator pos, T const* values, size_t count) {
+    auto const index = static_cast<size_t>(pos - begin());
+    if (count > N - size_ || index > size_) {
+      return nullptr;
+    }
+
+    OpenGap(index, count);
+    CopyConstruct(data() + index, values, count);
+    size_ += count;
+    return data() + index;
+  }
+
+  /// @return 削除した要素の次の位置
+  T* erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  T* erase(const_iterator first, const_iterator last) {
+    auto const index = static_cast<size_t>(first - begin());
+    auto const count = static_cast<size_t>(last - first);
+    if (count == 0) {
+      return data() + index;
+    }
+
+    auto* dst = data() + index;
+    auto* src = dst + count;
+    auto const tail = size_ - index - count;
+    if constexpr (kTrivial) {
+      memmove(static_cast<void*>(dst), src, tail * sizeof(T));
+    } else {
+      std::move(src, src + tail, dst);
+      std::destroy(dst + tail, end());
+    }
+    size_ -= count;
+    return dst;
+  }
+
+  /// @brief 要素数を変える (増えた分は値初期化)
+  /// @return N を超える場合は N にして false
+  bool resize(size_t count) {
+    auto const fits = count <= N;
+    count = fits ? count : N;
+
+    if (count < size_) {
+      std::destroy(data() + count, end());
+    } else if constexpr (kTrivial &&
+                         std::is_trivially_default_constructible_v<T>) {
+      // 既定メンバ初期化子を持つ型は 0 埋めにできない
+      memset(static_cast<void*>(end()), 0, (count - size_) * sizeof(T));
+    } else {
+      for (auto* it = end(); it != data() + count; ++it) {
+        std::construct_at(it);
+      }
+    }
+    size_ = count;
+    return fits;
+  }
+
+  /// @return N を超える分は切り捨てて false
+  bool assign(T const* values, size_t count) {
+    clear();
+    auto const fits = count <= N;
+    size_ = fits ? count : N;
+    CopyConstruct(data(), values, size_);
+    return fits;
+  }
+
+  bool assign(size_t count, T const& value) {
+    clear();
+    auto const fits = count <= N;
+    size_ = fits ? count : N;
+    std::uninitialized_fill_n(data(), size_, value);
+    return fits;
+  }
+
+  bool operator==(StaticVector const& other) const {
+    if (size_ != other.size_) {
+      return false;
+    }
+    for (size_t i = 0; i < size_; i++) {
+      if (!((*this)[i] == other[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static void CopyConstruct(T* dst, T const* src, size_t count) {
+    if (count == 0) {
+      return;
+    }
+    if constexpr (kTrivial) {
+      memcpy(static_cast<void*>(dst), src, count * sizeof(T));
+    } else {
+      std::uninitialized_copy_n(src, count, dst);
+    }
+  }
+
+  void MoveFrom(StaticVector&& other) {
+    if constexpr (kTrivial) {
+      CopyConstruct(data(), other.data(), other.size_);
+    } else {
+      std::uninitialized_move_n(other.data(), other.size_, data());
+    }
+    size_ = other.size_;
+    other.clear();
+  }
+
+  /// [index, size_) を count だけ後ろにずらし、[index, index + count) を
+  /// 未構築の領域にする
+  void OpenGap(size_t index, size_t count) {
+    auto* src = data() + index;
+    auto const tail = size_ - index;
+    if constexpr (kTrivial) {
+      memmove(static_cast<void*>(src + count), src, tail * sizeof(T));
+    } else {
+      for (size_t i = tail; i > 0; i--) {
+        std::construct_at(src + i - 1 + count, std::move(src[i - 1]));
+        std::destroy_at(src + i - 1);
+      }
+    }
+  }
+
+  std::array<Slot, N> buffer_{};
+  size_t size_ = 0;
+};
+
+}  // namespace Nano::collection
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <Nano/arena.hpp>
+#include <Nano/scratch.hpp>
+
+#include <cstdint>
+
+using Nano::utils::Arena;
+using Nano::utils::ArenaScope;
+using Nano::utils::ScratchBuffer;
+using Nano::utils::StaticArena;
+
+// 基本的な確保と使用量のテスト
+TEST(ArenaTest, BasicAllocate) {
+  StaticArena<64> arena;
+
+  EXPECT_EQ(arena.Capacity(), 64);
+  EXPECT_EQ(arena.Used(), 0);
+
+  auto* a = arena.Allocate(10, 1);
+  auto* b = arena.Allocate(10, 1);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(static_cast<uint8_t*>(b) - static_cast<uint8_t*>(a), 10);
+  EXPECT_EQ(arena.Used(), 20);
+  EXPECT_EQ(arena.Remaining(), 44);
+}
+
+// アラインメントが守られること
+TEST(ArenaTest, Alignment) {
+  StaticArena<128> arena;
+
+  arena.Allocate(1, 1);
+  auto* p = arena.Allocate(8, 8);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 8, 0);
+
+  arena.Allocate(3, 1);
+  auto* words = arena.AllocateArray<uint32_t>(4);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(words) % alignof(uint32_t), 0);
+}
+
+// 容量を超える確保は nullptr / 空の Span になること
+TEST(ArenaTest, Exhaustion) {
+  StaticArena<16> arena;
+
+  EXPECT_NE(arena.Allocate(16, 1), nullptr);
+  EXPECT_EQ(arena.Allocate(1, 1), nullptr);
+  EXPECT_TRUE(arena.AllocateBytes(1).empty());
+
+  arena.Reset();
+  EXPECT_EQ(arena.AllocateBytes(16).size(), 16);
+}
+
+// ArenaScope がネストして LIFO に巻き戻すこと
+TEST(ArenaTest, NestedScopes) {
+  StaticArena<64> arena;
+  arena.Allocate(8, 1);
+
+  {
+    ArenaScope outer(arena);
+    outer.AllocateBytes(16);
+    EXPECT_EQ(arena.Used(), 24);
+    {
+      ArenaScope inner(arena);
+      inner.AllocateBytes(32);
+      EXPECT_EQ(arena.Used(), 56);
+    }
+    EXPECT_EQ(arena.Used(), 24);
+  }
+  EXPECT_EQ(arena.Used(), 8);
+  EXPECT_EQ(arena.HighWaterMark(), 56);
+
+  arena.ResetHighWaterMark();
+  EXPECT_EQ(arena.HighWaterMark(), 8);
+}
+
+// New で構築したオブジェクトを使えること
+TEST(ArenaTest, NewObject) {
+  struct Point {
+    int x, y;
+  };
+
+  StaticArena<32> arena;
+  ArenaScope scope(arena);
+  auto* p = scope.New<Point>(Point{3, 4});
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(p->x + p->y, 7);
+}
+
+// 外部バッファ上にも Arena を作れること
+TEST(ArenaTest, ExternalBuffer) {
+  alignas(8) uint8_t buffer[32];
+  Arena arena(buffer, sizeof(buffer));
+
+  auto bytes = arena.AllocateBytes(4);
+  EXPECT_EQ(bytes.data(), buffer);
+}
+
+// ScratchBuffer がコンテキストごとの Arena を提供すること
+TEST(ArenaTest, ScratchBufferContexts) {
+  EXPECT_NE(&ScratchBuffer::ISR(), &ScratchBuffer::App());
+  EXPECT_EQ(ScratchBuffer::ISR().Capacity(), ScratchBuffer::kISRSize);
+
+  {
+    ArenaScope scope(ScratchBuffer::App());
+    auto buf = scope.AllocateBytes(128);
+    EXPECT_EQ(buf.size(), 128);
+  }
+  EXPECT_EQ(ScratchBuffer::App().Used(), 0);
+  EXPECT_EQ(ScratchBuffer::GetAppBuffer(), ScratchBuffer::App().Data());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <Nano/bitmap_pool.hpp>
+
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using Nano::collection::AtomicBitmapPool;
+using Nano::collection::AtomicSlotBitmap;
+using Nano::collection::BitmapPool;
+using Nano::collection::SlotBitmap;
+
+// 若い番号から順に確保され、解放したスロットが再利用されること
+TEST(SlotBitmapTest, AcquireRelease) {
+  SlotBitmap<40> bitmap;
+
+  for (size_t i = 0; i < 40; i++) {
+    EXPECT_EQ(bitmap.Acquire(), i);
+  }
+  EXPECT_EQ(bitmap.Acquire(), bitmap.kNone);
+  EXPECT_EQ(bitmap.Count(), 40u);
+
+  bitmap.Release(35);
+  bitmap.Release(3);
+  EXPECT_FALSE(bitmap.Test(3));
+  EXPECT_EQ(bitmap.Acquire(), 3u);
+  EXPECT_EQ(bitmap.Acquire(), 35u);
+}
+
+// 語の途中で N が終わる場合に範囲外を返さないこと
+TEST(SlotBitmapTest, PartialLastWord) {
+  SlotBitmap<5, uint8_t> bitmap;
+
+  for (size_t i = 0; i < 5; i++) {
+    EXPECT_NE(bitmap.Acquire(), bitmap.kNone);
+  }
+  EXPECT_EQ(bitmap.Acquire(), bitmap.kNone);
+}
+
+// FindNext で使用中スロットだけを辿れること
+TEST(SlotBitmapTest, FindNext) {
+  SlotBitmap<100, uint64_t> bitmap;
+  for (size_t i = 0; i < 100; i++) {
+    bitmap.Acquire();
+  }
+  for (size_t i = 0; i < 100; i++) {
+    if (i != 2 && i != 63 && i != 64 && i != 99) {
+      bitmap.Release(i);
+    }
+  }
+
+  std::vector<size_t> found;
+  for (auto i = bitmap.FindNext(0); i != bitmap.kNone;
+       i = bitmap.FindNext(i + 1)) {
+    found.push_back(i);
+  }
+  EXPECT_EQ(found, (std::vector<size_t>{2, 63, 64, 99}));
+}
+
+// New / Delete で構築と破棄が行われること
+TEST(BitmapPoolTest, NewDelete) {
+  auto shared = std::make_shared<int>(0);
+  {
+    BitmapPool<std::shared_ptr<int>, 4> pool;
+
+    auto* a = pool.New(shared);
+    auto* b = pool.New(shared);
+    ASSERT_NE(a, nullptr);
+    EXPECT_TRUE(pool.Contains(a));
+    EXPECT_EQ(shared.use_count(), 3);
+
+    pool.Delete(a);
+    EXPECT_FALSE(pool.Contains(a));
+    EXPECT_EQ(shared.use_count(), 2);
+    EXPECT_EQ(pool.New(shared), a);
+
+    EXPECT_EQ(pool.IndexOf(b), 1u);
+    EXPECT_EQ(pool.Count(), 2u);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+// 満杯なら nullptr を返すこと
+TEST(BitmapPoolTest, Exhausted) {
+  BitmapPool<int, 3> pool;
+
+  EXPECT_NE(pool.New(1), nullptr);
+  EXPECT_NE(pool.New(2), nullptr);
+  EXPECT_NE(pool.New(3), nullptr);
+  EXPECT_EQ(pool.New(4), nullptr);
+}
+
+// 複数の語にまたがる一括解放
+TEST(BitmapPoolTest, BulkDelete) {
+  BitmapPool<int, 70> pool;
+  std::vector<int*> ptrs;
+  for (int i = 0; i < 70; i++) {
+    ptrs.push_back(pool.New(i));
+  }
+
+  std::vector<int*> victims;
+  for (size_t i = 0; i < ptrs.size(); i += 3) {
+    victims.push_back(ptrs[i]);
+  }
+  pool.Delete(Nano::collection::Span<int* const>(victims.data(),
+                                                 victims.size()));
+
+  EXPECT_EQ(pool.Count(), 70u - victims.size());
+  for (size_t i = 0; i < ptrs.size(); i++) {
+    EXPECT_EQ(pool.Contains(ptrs[i]), i % 3 != 0);
+  }
+}
+
+// 複数スレッドから同時に確保しても重複しないこと
+TEST(AtomicBitmapPoolTest, ConcurrentAcquire) {
+  static AtomicBitmapPool<int, 256> pool;
+  constexpr int kThreads = 4;
+  std::vector<int*> results[kThreads];
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&results, t] {
+      for (int i = 0; i < 64; i++) {
+        results[t].push_back(pool.New(t));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::set<int*> unique;
+  for (auto& result : results) {
+    for (auto* ptr : result) {
+      ASSERT_NE(ptr, nullptr);
+      unique.insert(ptr);
+    }
+  }
+  EXPECT_EQ(unique.size(), 256u);
+  EXPECT_EQ(pool.New(0), nullptr);
+
+  pool.Clear();
+  EXPECT_TRUE(pool.Empty());
+}
+
+// AtomicSlotBitmap 単体でも確保と解放ができること
+TEST(AtomicSlotBitmapTest, AcquireRelease) {
+  AtomicSlotBitmap<33> bitmap;
+
+  for (size_t i = 0; i < 33; i++) {
+    EXPECT_EQ(bitmap.Acquire(), i);
+  }
+  EXPECT_EQ(bitmap.Acquire(), bitmap.kNone);
+
+  bitmap.Release(32);
+  EXPECT_EQ(bitmap.FindNext(31), 31u);
+  EXPECT_EQ(bitmap.FindNext(32), bitmap.kNone);
+  EXPECT_EQ(bitmap.Acquire(), 32u);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <Nano/crc.hpp>
+#include <Nano/queue.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using Nano::collection::Queue;
+using Nano::collection::Span;
+using Nano::utils::Crc;
+using Nano::utils::Crc16Ccitt;
+using Nano::utils::Crc32;
+using Nano::utils::Crc32c;
+using Nano::utils::Crc8;
+
+namespace {
+
+constexpr uint8_t kCheck[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+/// 1 ビットずつ計算する参照実装
+template <uint64_t Poly, size_t Width, uint64_t Init, bool Reflected,
+          uint64_t XorOut>
+uint64_t Bitwise(std::vector<uint8_t> const& data) {
+  uint64_t const mask = Width == 64 ? ~0ULL : (1ULL << Width) - 1;
+  uint64_t const top = 1ULL << (Width - 1);
+  uint64_t crc = Init;
+  for (auto byte : data) {
+    for (int bit = 0; bit < 8; bit++) {
+      auto const in =
+          Reflected ? (byte >> bit) & 1U : (byte >> (7 - bit)) & 1U;
+      bool const feedback = ((crc & top) != 0) != (in != 0);
+      crc = ((crc << 1U) ^ (feedback ? Poly : 0)) & mask;
+    }
+  }
+  if (Reflected) {
+    uint64_t out = 0;
+    for (size_t i = 0; i < Width; i++) {
+      out = (out << 1U) | ((crc >> i) & 1U);
+    }
+    crc = out;
+  }
+  return (crc ^ XorOut) & mask;
+}
+
+std::vector<uint8_t> Random(size_t size, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<uint8_t> data(size);
+  for (auto& value : data) {
+    value = static_cast<uint8_t>(byte(rng));
+  }
+  return data;
+}
+
+/// slice-by-1/4/8 がずれた位置から始めても参照実装と一致すること
+template <uint64_t Poly, size_t Width, uint64_t Init, bool Reflected,
+          uint64_t XorOut>
+void ExpectSlicesMatch() {
+  auto const buffer = Random(80, Width);
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (size_t size = 0; size + offset <= buffer.size(); size += 3) {
+      std::vector<uint8_t> const data(buffer.begin() + offset,
+                                      buffer.begin() + offset + size);
+      Span<uint8_t const> const span(data.data(), data.size());
+      auto const expected =
+          Bitwise<Poly, Width, Init, Reflected, XorOut>(data);
+      EXPECT_EQ(
+          (Crc<Poly, Width, Init, Reflected, XorOut, 1>::Compute(span)),
+          expected);
+      if constexpr (Width <= 32) {
+        EXPECT_EQ(
+            (Crc<Poly, Width, Init, Reflected, XorOut, 4>::Compute(span)),
+            expected);
+        EXPECT_EQ(
+            (Crc<Poly, Width, Init, Reflected, XorOut, 8>::Compute(span)),
+            expected);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+// 代表的な CRC の検査値 ("123456789")
+TEST(CrcTest, CheckValues) {
+  static_assert(Crc8::Compute(kCheck) == 0xF4);
+  static_assert(Crc16Ccitt::Compute(kCheck) == 0x29B1);
+  static_assert(Crc32::Compute(kCheck) == 0xCBF43926);
+
+  EXPECT_EQ(Crc32::Compute(kCheck), 0xCBF43926u);
+  // ハードウェア命令があればそちらで計算される
+  EXPECT_EQ(Crc32c::Compute(kCheck), 0xE3069283u);
+  EXPECT_EQ((Crc<0x1EDC6F41, 32, 0xFFFFFFFF, true, 0xFFFFFFFF, 4,
+                 false>::Compute(kCheck)),
+            0xE3069283u);
+  // CRC-16/ARC (反射あり)
+  EXPECT_EQ((Crc<0x8005, 16, 0, true>::Compute(kCheck)), 0xBB3D);
+  // CRC-64/XZ
+  EXPECT_EQ((Crc<0x42F0E1EBA9EA3693, 64, ~0ULL, true, ~0ULL, 1>::Compute(
+                kCheck)),
+            0x995DC9BBDF1939FAULL);
+}
+
+// テーブル・slice-by-N が参照実装と一致すること
+TEST(CrcTest, SlicesMatchBitwise) {
+  ExpectSlicesMatch<0x07, 8, 0, false, 0>();
+  ExpectSlicesMatch<0x31, 8, 0xFF, true, 0>();
+  ExpectSlicesMatch<0x1021, 16, 0xFFFF, false, 0>();
+  ExpectSlicesMatch<0x8005, 16, 0, true, 0>();
+  ExpectSlicesMatch<0x864CFB, 24, 0xB704CE, false, 0>();
+  ExpectSlicesMatch<0x04C11DB7, 32, 0xFFFFFFFF, false, 0xFFFFFFFF>();
+  ExpectSlicesMatch<0x04C11DB7, 32, 0xFFFFFFFF, true, 0xFFFFFFFF>();
+  ExpectSlicesMatch<0x1EDC6F41, 32, 0xFFFFFFFF, true, 0xFFFFFFFF>();
+  ExpectSlicesMatch<0x42F0E1EBA9EA3693, 64, ~0ULL, true, ~0ULL>();
+}
+
+// 分割して Update しても一度に計算したのと同じになること
+TEST(CrcTest, Incremental) {
+  auto const data = Random(1000, 1);
+  for (size_t split : {0, 1, 5, 333, 999, 1000}) {
+    Crc32c crc;
+    crc.Update({data.data(), split});
+    crc.Update({data.data() + split, data.size() - split});
+    EXPECT_EQ(crc.Final(), Crc32c::Compute({data.data(), data.size()}));
+
+    Crc16Ccitt crc16;
+    crc16.Update({data.data(), split});
+    crc16.Update({data.data() + split, data.size() - split});
+    EXPECT_EQ(crc16.Final(),
+              Crc16Ccitt::Compute({data.data(), data.size()}));
+  }
+
+  Crc32 crc;
+  crc.Update(kCheck);
+  crc.Reset();
+  EXPECT_EQ(crc.Update(kCheck).Final(), 0xCBF43926u);
+}
+
+// 折り返した Queue の中身を 2 つの Segment として流せること
+TEST(CrcTest, QueueSegments) {
+  Queue<uint8_t, 32> queue;
+  auto const filler = Random(20, 2);
+  ASSERT_TRUE(queue.PushN(filler.data(), filler.size()));
+  queue.ConsumeN(filler.size());
+
+  auto const data = Random(25, 3);
+  ASSERT_TRUE(queue.PushN(data.data(), data.size()));
+  ASSERT_FALSE(queue.Segments().second.empty());
+
+  Crc32 crc;
+  EXPECT_EQ(crc.Update(queue).Final(),
+            Crc32::Compute({data.data(), data.size()}));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
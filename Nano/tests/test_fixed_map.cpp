@@ -183,6 +183,37 @@ TEST(FixedMapTest, OperatorBracketCreatesNewEntry) {
   EXPECT_EQ(*map.Find(42), 4200);
 }
 
+// Remove で削除した領域を新しいキーで再利用できること
+TEST(FixedMapTest, RemoveAndReuse) {
+  FixedMap<int, int, 2> map;
+
+  map[1] = 100;
+  map[2] = 200;
+  EXPECT_EQ(map.Size(), 2u);
+
+  EXPECT_TRUE(map.Remove(1));
+  EXPECT_FALSE(map.Remove(1));
+  EXPECT_FALSE(map.Contains(1));
+  EXPECT_EQ(map.Size(), 1u);
+
+  map[3] = 300;
+  EXPECT_EQ(*map.Find(3), 300);
+  EXPECT_EQ(*map.Find(2), 200);
+}
+
+// 満杯で新しいキーを追加してもマップが壊れないこと
+TEST(FixedMapTest, Overflow) {
+  FixedMap<int, int, 2> map;
+
+  map[1] = 100;
+  map[2] = 200;
+  map[3] = 300;
+
+  EXPECT_FALSE(map.Contains(3));
+  EXPECT_EQ(*map.Find(1), 100);
+  EXPECT_EQ(*map.Find(2), 200);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <Nano/inplace_function.hpp>
+
+#include <memory>
+
+using Nano::utils::InplaceFunction;
+
+namespace {
+int Twice(int x) {
+  return x * 2;
+}
+
+struct Counter {
+  int* copies;
+  int* destroyed;
+
+  Counter(int* copies, int* destroyed) : copies(copies), destroyed(destroyed) {}
+  Counter(Counter const& other)
+      : copies(other.copies), destroyed(other.destroyed) {
+    ++*copies;
+  }
+  ~Counter() { ++*destroyed; }
+
+  int operator()() const { return 1; }
+};
+}  // namespace
+
+// 空の状態と nullptr 比較のテスト
+TEST(InplaceFunctionTest, Empty) {
+  InplaceFunction<void()> fn;
+  EXPECT_FALSE(fn);
+  EXPECT_TRUE(fn == nullptr);
+
+  InplaceFunction<void()> from_null = nullptr;
+  EXPECT_FALSE(from_null);
+
+  int (*null_ptr)(int) = nullptr;
+  InplaceFunction<int(int)> from_null_ptr = null_ptr;
+  EXPECT_FALSE(from_null_ptr);
+}
+
+// 関数ポインタとラムダを呼び出せること
+TEST(InplaceFunctionTest, Invoke) {
+  InplaceFunction<int(int)> fn = Twice;
+  EXPECT_TRUE(fn);
+  EXPECT_EQ(fn(21), 42);
+
+  int base = 10;
+  fn = [&base](int x) { return base + x; };
+  EXPECT_EQ(fn(5), 15);
+
+  fn = nullptr;
+  EXPECT_TRUE(fn == nullptr);
+}
+
+// メンバ関数・メンバ変数へのポインタも呼び出せること
+TEST(InplaceFunctionTest, MemberPointer) {
+  struct Sensor {
+    int value;
+    int Get() const { return value; }
+  };
+  Sensor sensor{7};
+
+  InplaceFunction<int(Sensor const&)> get = &Sensor::Get;
+  EXPECT_EQ(get(sensor), 7);
+
+  InplaceFunction<int(Sensor&)> field = &Sensor::value;
+  EXPECT_EQ(field(sensor), 7);
+
+  int (Sensor::*null_member)() const = nullptr;
+  InplaceFunction<int(Sensor const&)> from_null = null_member;
+  EXPECT_FALSE(from_null);
+
+  // 戻り値は void のシグネチャで捨てられる
+  InplaceFunction<void(Sensor const&)> discard = &Sensor::Get;
+  discard(sensor);
+}
+
+// キャプチャしたオブジェクトの状態が呼び出し間で保持されること
+TEST(InplaceFunctionTest, MutableState) {
+  InplaceFunction<int()> fn = [count = 0]() mutable { return ++count; };
+  EXPECT_EQ(fn(), 1);
+  EXPECT_EQ(fn(), 2);
+
+  auto copy = fn;
+  EXPECT_EQ(copy(), 3);
+  EXPECT_EQ(fn(), 3);
+}
+
+// コピー/ムーブ/破棄で呼び出し可能オブジェクトの寿命が正しく管理されること
+TEST(InplaceFunctionTest, Lifetime) {
+  int copies = 0;
+  int destroyed = 0;
+  {
+    Counter counter(&copies, &destroyed);
+    InplaceFunction<int()> a = counter;
+    EXPECT_EQ(copies, 1);
+
+    InplaceFunction<int()> b = a;
+    EXPECT_EQ(copies, 2);
+
+    // ムーブ元の中身はムーブ時に破棄される
+    InplaceFunction<int()> c = std::move(b);
+    EXPECT_FALSE(b);
+    EXPECT_EQ(c(), 1);
+    EXPECT_EQ(destroyed, 1);
+
+    a = nullptr;
+    EXPECT_EQ(destroyed, 2);
+  }
+  // 残りの counter と c が破棄される
+  EXPECT_EQ(destroyed, 4);
+}
+
+// 小さい容量からより大きい容量へ変換できること
+TEST(InplaceFunctionTest, ConvertToLargerCapacity) {
+  int value = 7;
+  InplaceFunction<int(), sizeof(void*)> small = [&value]() { return value; };
+  InplaceFunction<int(), 4 * sizeof(void*)> large = small;
+  EXPECT_EQ(large(), 7);
+
+  InplaceFunction<int(), 4 * sizeof(void*)> moved = std::move(small);
+  EXPECT_FALSE(small);
+  EXPECT_EQ(moved(), 7);
+}
+
+// 容量いっぱいのキャプチャを保持できること
+TEST(InplaceFunctionTest, FullCapacity) {
+  void* a = nullptr;
+  void* b = nullptr;
+  void* c = nullptr;
+  InplaceFunction<bool()> fn = [a, b, c]() {
+    return a == nullptr && b == nullptr && c == nullptr;
+  };
+  EXPECT_TRUE(fn());
+  static_assert(decltype(fn)::capacity() == 3 * sizeof(void*));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -261,6 +261,24 @@ TEST(LinkedListTest, ResetLinkNode) {
   // ResetLinkNode は個別ノードのポインタをクリアするだけ
 }
 
+// 削除したノードが古いリンクを持たずに再利用されること
+TEST(LinkedListTest, ReuseRemovedNode) {
+  LinkedList<TestNode, 3> list;
+
+  TestNode* node1 = list.NewBack();
+  TestNode* node2 = list.NewBack();
+  TestNode* node3 = list.NewBack();
+  EXPECT_EQ(list.NewBack(), nullptr);
+
+  list.Remove(node2);
+  TestNode* reused = list.NewBack();
+  EXPECT_EQ(reused, node2);
+  EXPECT_TRUE(reused->InUse());
+  EXPECT_EQ(reused->Next(), nullptr);
+  EXPECT_EQ(reused->Prev(), node3);
+  EXPECT_EQ(node1->Next(), node3);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
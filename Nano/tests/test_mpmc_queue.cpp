@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <Nano/mpmc_queue.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using Nano::collection::MpmcQueue;
+
+// 単一スレッドでは FIFO として動くこと
+TEST(MpmcQueueTest, Fifo) {
+  MpmcQueue<int, 4> queue;
+  int value = 0;
+
+  EXPECT_FALSE(queue.TryPop(value));
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(queue.TryPush(i));
+  }
+  EXPECT_FALSE(queue.TryPush(4));
+  EXPECT_EQ(queue.SizeApprox(), 4u);
+
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.TryPop(value));
+  EXPECT_TRUE(queue.EmptyApprox());
+}
+
+// 何周も折り返してもシーケンス番号が崩れないこと
+TEST(MpmcQueueTest, WrapAround) {
+  MpmcQueue<int, 8, false> queue;
+  int value = 0;
+
+  for (int round = 0; round < 1000; round++) {
+    EXPECT_TRUE(queue.TryPush(round));
+    EXPECT_TRUE(queue.TryPush(-round));
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, round);
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, -round);
+  }
+}
+
+// ゼロ初期化のまま静的領域に置けること
+constinit MpmcQueue<int, 16, false> g_static_queue;
+
+TEST(MpmcQueueTest, Constinit) {
+  EXPECT_TRUE(g_static_queue.TryPush(7));
+  int value = 0;
+  EXPECT_TRUE(g_static_queue.TryPop(value));
+  EXPECT_EQ(value, 7);
+}
+
+// 非トリビアルな型が取り出し時・破棄時に解放されること
+TEST(MpmcQueueTest, NonTrivial) {
+  auto shared = std::make_shared<int>(1);
+  {
+    MpmcQueue<std::shared_ptr<int>, 4> queue;
+    queue.TryPush(shared);
+    queue.TryPush(shared);
+    EXPECT_EQ(shared.use_count(), 3);
+
+    std::shared_ptr<int> out;
+    queue.TryPop(out);
+    out.reset();
+    EXPECT_EQ(shared.use_count(), 2);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+// 複数 producer / consumer で要素が欠けも重複もしないこと
+TEST(MpmcQueueTest, MultiProducerMultiConsumer) {
+  static MpmcQueue<int, 64> queue;
+  constexpr int kProducers = 3;
+  constexpr int kConsumers = 2;
+  constexpr int kPerProducer = 20000;
+
+  std::atomic<long long> sum{0};
+  std::atomic<int> popped{0};
+  std::vector<std::thread> threads;
+
+  for (int p = 0; p < kProducers; p++) {
+    threads.emplace_back([] {
+      for (int i = 1; i <= kPerProducer; i++) {
+        while (!queue.TryPush(i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int c = 0; c < kConsumers; c++) {
+    threads.emplace_back([&] {
+      int value = 0;
+      while (popped.load() < kProducers * kPerProducer) {
+        if (queue.TryPop(value)) {
+          sum += value;
+          popped++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  constexpr long long kExpected =
+      static_cast<long long>(kPerProducer) * (kPerProducer + 1) / 2 *
+      kProducers;
+  EXPECT_EQ(sum.load(), kExpected);
+  EXPECT_TRUE(queue.EmptyApprox());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
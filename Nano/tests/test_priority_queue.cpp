@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include <Nano/priority_queue.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+using Nano::collection::PriorityQueue;
+
+// std::priority_queue と同じく最大値から取り出されること
+TEST(PriorityQueueTest, PopsInOrder) {
+  PriorityQueue<int, 8> queue;
+
+  for (int value : {5, 1, 7, 3, 9, 2}) {
+    EXPECT_TRUE(queue.Push(value));
+  }
+  EXPECT_EQ(queue.Size(), 6u);
+
+  std::vector<int> popped;
+  int value = 0;
+  while (queue.TryPop(value)) {
+    popped.push_back(value);
+  }
+  EXPECT_EQ(popped, (std::vector<int>{9, 7, 5, 3, 2, 1}));
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_FALSE(queue.Pop());
+}
+
+// 満杯なら無効なハンドルを返すこと
+TEST(PriorityQueueTest, Full) {
+  PriorityQueue<int, 2> queue;
+
+  EXPECT_TRUE(queue.Push(1));
+  EXPECT_TRUE(queue.Push(2));
+  EXPECT_TRUE(queue.Full());
+  EXPECT_FALSE(queue.Push(3));
+
+  queue.Pop();
+  EXPECT_TRUE(queue.Push(3));
+  EXPECT_EQ(queue.Top(), 3);
+}
+
+// std::greater で締め切りの早い順に並べられること
+TEST(PriorityQueueTest, MinHeap) {
+  PriorityQueue<int, 8, std::greater<int>> deadlines;
+
+  deadlines.Push(30);
+  deadlines.Push(10);
+  deadlines.Push(20);
+
+  EXPECT_EQ(deadlines.Top(), 10);
+  deadlines.Pop();
+  EXPECT_EQ(deadlines.Top(), 20);
+}
+
+// ハンドルは他の要素が動いても同じ要素を指し続けること
+TEST(PriorityQueueTest, StableHandles) {
+  PriorityQueue<int, 8, std::greater<int>> queue;
+
+  auto a = queue.Push(50);
+  auto b = queue.Push(40);
+  auto c = queue.Push(60);
+  queue.Push(10);
+  queue.Push(20);
+
+  EXPECT_EQ(queue.Get(a), 50);
+  EXPECT_EQ(queue.Get(b), 40);
+  EXPECT_EQ(queue.Get(c), 60);
+
+  queue.Pop();
+  queue.Pop();
+  EXPECT_TRUE(queue.Contains(a));
+  EXPECT_EQ(queue.Get(a), 50);
+
+  queue.Pop();  // 40
+  EXPECT_FALSE(queue.Contains(b));
+}
+
+// DecreaseKey で Top 側に移動し、逆向きの変更は拒否されること
+TEST(PriorityQueueTest, DecreaseKey) {
+  PriorityQueue<int, 8, std::greater<int>> queue;
+
+  queue.Push(10);
+  queue.Push(20);
+  auto handle = queue.Push(30);
+
+  EXPECT_FALSE(queue.DecreaseKey(handle, 40));
+  EXPECT_EQ(queue.Get(handle), 30);
+
+  EXPECT_TRUE(queue.DecreaseKey(handle, 5));
+  EXPECT_EQ(queue.Top(), 5);
+  EXPECT_EQ(queue.Get(handle), 5);
+}
+
+// Update と Erase で任意の位置の要素を動かせること
+TEST(PriorityQueueTest, UpdateAndErase) {
+  PriorityQueue<int, 8> queue;
+
+  auto low = queue.Push(1);
+  auto mid = queue.Push(5);
+  queue.Push(9);
+
+  EXPECT_TRUE(queue.Update(low, 100));
+  EXPECT_EQ(queue.Top(), 100);
+  EXPECT_TRUE(queue.Update(low, 0));
+  EXPECT_EQ(queue.Top(), 9);
+
+  EXPECT_TRUE(queue.Erase(mid));
+  EXPECT_FALSE(queue.Erase(mid));
+  EXPECT_EQ(queue.Size(), 2u);
+
+  queue.Pop();
+  EXPECT_EQ(queue.Top(), 0);
+}
+
+// スロットが再利用されても古いハンドルは新しい要素を指さないこと
+TEST(PriorityQueueTest, StaleHandleAfterReuse) {
+  PriorityQueue<int, 4> queue;
+
+  auto stale = queue.Push(1);
+  EXPECT_TRUE(queue.Erase(stale));
+  auto fresh = queue.Push(2);
+  EXPECT_FALSE(stale == fresh);
+
+  EXPECT_FALSE(queue.Contains(stale));
+  EXPECT_FALSE(queue.Erase(stale));
+  EXPECT_FALSE(queue.DecreaseKey(stale, 10));
+  EXPECT_FALSE(queue.Update(stale, 10));
+  EXPECT_TRUE(queue.Contains(fresh));
+  EXPECT_EQ(queue.Get(fresh), 2);
+
+  queue.Pop();
+  queue.Push(3);
+  EXPECT_FALSE(queue.Contains(fresh));
+
+  auto before_clear = queue.Push(4);
+  queue.Clear();
+  queue.Push(5);
+  queue.Push(6);
+  EXPECT_FALSE(queue.Contains(before_clear));
+  EXPECT_EQ(queue.Size(), 2u);
+}
+
+// 4-ary でもランダムな操作列が std::priority_queue と一致すること
+TEST(PriorityQueueTest, QuaternaryMatchesReference) {
+  PriorityQueue<int, 256, std::less<int>, 4> queue;
+  std::vector<int> reference;
+  std::mt19937 rng(42);
+
+  for (int i = 0; i < 2000; i++) {
+    if (rng() % 3 != 0 && !queue.Full()) {
+      auto const value = static_cast<int>(rng() % 1000);
+      queue.Push(value);
+      reference.push_back(value);
+      std::push_heap(reference.begin(), reference.end());
+    } else if (!queue.Empty()) {
+      ASSERT_EQ(queue.Top(), reference.front());
+      queue.Pop();
+      std::pop_heap(reference.begin(), reference.end());
+      reference.pop_back();
+    }
+    ASSERT_EQ(queue.Size(), reference.size());
+  }
+}
+
+// 非トリビアルな型も取り出し後に解放されること
+TEST(PriorityQueueTest, ReleasesPoppedElements) {
+  struct Compare {
+    bool operator()(std::shared_ptr<int> const& a,
+                    std::shared_ptr<int> const& b) const {
+      return *a < *b;
+    }
+  };
+
+  auto one = std::make_shared<int>(1);
+  auto two = std::make_shared<int>(2);
+  PriorityQueue<std::shared_ptr<int>, 4, Compare> queue;
+
+  queue.Push(one);
+  queue.Push(two);
+  EXPECT_EQ(two.use_count(), 2);
+
+  queue.Pop();
+  EXPECT_EQ(two.use_count(), 1);
+  EXPECT_EQ(one.use_count(), 2);
+
+  queue.Clear();
+  EXPECT_EQ(one.use_count(), 1);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include <Nano/queue.hpp>
 
+#include <iterator>
+#include <memory>
+#include <string>
+
 using Nano::collection::Queue;
 
 constexpr size_t kBufferSize = 8;
@@ -290,6 +294,243 @@ TEST(QueueTest, PushNPopNToWrapAround) {
   }
 }
 
+// constinit で静的領域に置けること (要素は構築されない)
+struct LargeMessage {
+  uint32_t id;
+  uint8_t data[8];
+};
+constinit Queue<LargeMessage, 256> g_static_queue;
+
+TEST(QueueTest, ConstinitStorage) {
+  EXPECT_TRUE(g_static_queue.Empty());
+  EXPECT_TRUE(g_static_queue.Push(LargeMessage{0x123, {1}}));
+  EXPECT_EQ(g_static_queue.Front().id, 0x123u);
+  g_static_queue.Clear();
+}
+
+// デフォルト構築できない型を Emplace / TryPop で扱えること
+TEST(QueueTest, NonDefaultConstructible) {
+  struct Item {
+    explicit Item(int v) : value(v) {}
+    int value;
+  };
+
+  Queue<Item, 4> queue;
+  EXPECT_TRUE(queue.Emplace(1));
+  EXPECT_TRUE(queue.Emplace(2));
+
+  Item out(0);
+  EXPECT_TRUE(queue.TryPop(out));
+  EXPECT_EQ(out.value, 1);
+  EXPECT_TRUE(queue.TryPop(out));
+  EXPECT_EQ(out.value, 2);
+  EXPECT_FALSE(queue.TryPop(out));
+}
+
+// ムーブ専用の型を Push / Pop できること
+TEST(QueueTest, MoveOnly) {
+  Queue<std::unique_ptr<int>, 4> queue;
+
+  EXPECT_TRUE(queue.Push(std::make_unique<int>(10)));
+  EXPECT_TRUE(queue.Emplace(new int(20)));
+
+  auto first = queue.Pop();
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(*first, 10);
+  EXPECT_EQ(*queue.Front(), 20);
+}
+
+// Peek / Front がコピーせずに先頭を参照すること
+TEST(QueueTest, PeekFront) {
+  Queue<std::string, 4> queue;
+  EXPECT_EQ(queue.Peek(), nullptr);
+
+  queue.Push("hello");
+  ASSERT_NE(queue.Peek(), nullptr);
+  EXPECT_EQ(queue.Peek(), &queue.Front());
+
+  queue.Front() += " world";
+  EXPECT_EQ(queue.Pop(), "hello world");
+  EXPECT_EQ(queue.Peek(), nullptr);
+}
+
+// 生きている要素だけが破棄されること
+TEST(QueueTest, DestroysLiveElements) {
+  auto shared = std::make_shared<int>(0);
+  {
+    Queue<std::shared_ptr<int>, 4> queue;
+    queue.Push(shared);
+    queue.Push(shared);
+    queue.Push(shared);
+    EXPECT_EQ(shared.use_count(), 4);
+
+    queue.ConsumeN(1);
+    EXPECT_EQ(shared.use_count(), 3);
+
+    queue.Pop();
+    EXPECT_EQ(shared.use_count(), 2);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+// コピーしたキューは生きている要素だけを独立に持つこと
+TEST(QueueTest, Copy) {
+  Queue<int, 4> ints;
+  ints.Push(1);
+  ints.Pop();
+  ints.Push(2);
+  ints.Push(3);
+  ints.Push(4);
+  auto int_copy = ints;
+  EXPECT_EQ(int_copy.Pop(), 2);
+  EXPECT_EQ(ints.Size(), 3u);
+
+  auto shared = std::make_shared<int>(0);
+  Queue<std::shared_ptr<int>, 4> queue;
+  queue.Push(nullptr);
+  queue.Pop();
+  queue.Push(shared);
+  queue.Push(shared);
+  queue.Push(shared);
+  {
+    auto copy = queue;
+    EXPECT_EQ(copy.Size(), 3u);
+    EXPECT_EQ(shared.use_count(), 7);
+
+    Queue<std::shared_ptr<int>, 4> assigned;
+    assigned.Push(std::make_shared<int>(1));
+    assigned = copy;
+    EXPECT_EQ(assigned.Size(), 3u);
+    EXPECT_EQ(assigned.Front(), shared);
+    EXPECT_EQ(shared.use_count(), 10);
+  }
+  EXPECT_EQ(shared.use_count(), 4);
+
+  static_assert(!std::is_copy_constructible_v<Queue<std::unique_ptr<int>, 4>>);
+}
+
+// 非トリビアルな型でも PushN / PopNTo がラップアラウンドすること
+TEST(QueueTest, PushNPopNToNonTrivial) {
+  Queue<std::string, 4> queue;
+  queue.Push("a");
+  queue.Push("b");
+  queue.Pop();
+  queue.Pop();
+
+  std::string in[] = {"x", "y", "z"};
+  EXPECT_TRUE(queue.PushN(in, 3));
+  EXPECT_FALSE(queue.PushN(in, 1));
+
+  std::string out[3];
+  queue.PopNTo(3, out);
+  EXPECT_EQ(out[0], "x");
+  EXPECT_EQ(out[2], "z");
+  EXPECT_TRUE(queue.Empty());
+}
+
+// 空きがちょうど足りない PushN は失敗し、キューが壊れないこと
+TEST(QueueTest, PushNExactOverflow) {
+  Queue<int, kBufferSize> queue;
+  int data[kBufferSize] = {};
+
+  EXPECT_FALSE(queue.PushN(data, kBufferSize));
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_TRUE(queue.PushN(data, 0));
+  EXPECT_TRUE(queue.Empty());
+}
+
+// 折り返していなければ Segments は 1 つの連続領域になること
+TEST(QueueTest, SegmentsContiguous) {
+  Queue<int, kBufferSize> queue;
+  EXPECT_EQ(queue.Segments().size(), 0u);
+
+  queue.Push(1);
+  queue.Push(2);
+  queue.Push(3);
+
+  auto segments = queue.Segments();
+  ASSERT_EQ(segments.first.size(), 3u);
+  EXPECT_TRUE(segments.second.empty());
+  EXPECT_EQ(segments.first[0], 1);
+  EXPECT_EQ(segments.first[2], 3);
+}
+
+// 折り返した中身が 2 つの Span に分かれ、順序が保たれること
+TEST(QueueTest, SegmentsWrapped) {
+  Queue<uint8_t, 8> queue;
+  for (int i = 0; i < 6; i++) {
+    queue.Push(0);
+  }
+  queue.ConsumeN(6);
+
+  uint8_t const data[] = {10, 11, 12, 13, 14};
+  ASSERT_TRUE(queue.PushN(data, 5));
+
+  auto segments = queue.Segments();
+  EXPECT_EQ(segments.first.size(), 2u);
+  EXPECT_EQ(segments.second.size(), 3u);
+  EXPECT_EQ(segments.first[0], 10);
+  EXPECT_EQ(segments.second[0], 12);
+
+  // Span 経由で書き換えたものが Pop で見えること
+  segments.second[2] = 99;
+  uint8_t out[5];
+  queue.PopNTo(5, out);
+  EXPECT_EQ(out[4], 99);
+}
+
+// range-based for が折り返しを跨いで先頭から辿ること
+TEST(QueueTest, RangeIteration) {
+  Queue<int, 4> queue;
+  queue.Push(0);
+  queue.Push(0);
+  queue.ConsumeN(2);
+  queue.Push(1);
+  queue.Push(2);
+  queue.Push(3);
+
+  int expected = 1;
+  for (int value : queue) {
+    EXPECT_EQ(value, expected++);
+  }
+  EXPECT_EQ(expected, 4);
+
+  for (int& value : queue) {
+    value *= 10;
+  }
+  auto const& const_queue = queue;
+  EXPECT_EQ(*const_queue.begin(), 10);
+  EXPECT_EQ(std::distance(const_queue.begin(), const_queue.end()), 3);
+}
+
+// 外部から Storage に書き込んだ分を CommitN で取り出せること
+TEST(QueueTest, StorageCommit) {
+  Queue<uint8_t, 8> queue;
+  auto storage = queue.Storage();
+  ASSERT_EQ(storage.size(), 8u);
+
+  // DMA のように先頭から折り返して書く
+  for (uint8_t i = 0; i < 6; i++) {
+    storage[i] = i;
+  }
+  ASSERT_TRUE(queue.CommitN(6));
+  EXPECT_EQ(queue.Pop(), 0);
+  queue.ConsumeN(4);
+
+  storage[6] = 6;
+  storage[7] = 7;
+  storage[0] = 8;
+  ASSERT_TRUE(queue.CommitN(3));
+  auto const segments = queue.Segments();
+  EXPECT_EQ(segments.first.size(), 3u);
+  EXPECT_EQ(segments.second.size(), 1u);
+  EXPECT_EQ(segments.second[0], 8);
+
+  // 空きを越える分は受け付けない
+  EXPECT_FALSE(queue.CommitN(4));
+  EXPECT_EQ(queue.Size(), 4u);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,11 +1,30 @@
 #include <gtest/gtest.h>
 #include <Nano/result.hpp>
+#include <memory>
 #include <string>
 
 using Nano::utils::Err;
 using Nano::utils::Ok;
 using Nano::utils::Result;
 
+namespace {
+template <typename T>
+using StorageOf = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+template <typename T, typename E>
+constexpr bool kNoLargerThanVariant =
+    sizeof(Result<T, E>) <= sizeof(std::variant<StorageOf<T>, StorageOf<E>>);
+}  // namespace
+
+// 代表的な組み合わせで std::variant より大きくならないこと
+static_assert(kNoLargerThanVariant<int, void*>);
+static_assert(kNoLargerThanVariant<uint8_t, uint8_t>);
+static_assert(kNoLargerThanVariant<double, char>);
+static_assert(kNoLargerThanVariant<void, int>);
+static_assert(kNoLargerThanVariant<int, void>);
+static_assert(kNoLargerThanVariant<std::string, int>);
+static_assert(kNoLargerThanVariant<std::unique_ptr<int>, std::string>);
+
 // 基本的なOk結果のテスト
 TEST(ResultTest, BasicOkValue) {
   auto result = []() -> Result<int, void*> {
@@ -89,6 +108,138 @@ TEST(ResultTest, MoveSemantics) {
   EXPECT_EQ(moved.Value().value(), "movable string");
 }
 
+// 値とエラーが領域を共有し、std::variant 以下のサイズであること
+TEST(ResultTest, OverlappingStorage) {
+  struct Payload {
+    uint8_t data[64];
+  };
+
+  static_assert(sizeof(Result<Payload, int>) <=
+                sizeof(std::variant<Payload, int>));
+  static_assert(sizeof(Result<Payload, int>) < sizeof(Payload) + sizeof(int) +
+                                                   sizeof(bool));
+  static_assert(std::is_trivially_copyable_v<Result<Payload, int>>);
+  static_assert(!std::is_trivially_copyable_v<Result<std::string, int>>);
+
+  Result<Payload, int> result = Ok(Payload{{1, 2, 3}});
+  EXPECT_EQ(result.Unwrap().data[2], 3);
+}
+
+// デフォルト構築できない型も保持できること
+TEST(ResultTest, NonDefaultConstructible) {
+  struct NoDefault {
+    explicit NoDefault(int v) : value(v) {}
+    int value;
+  };
+
+  Result<NoDefault, std::string> ok = Ok(NoDefault(7));
+  EXPECT_EQ(ok.Unwrap().value, 7);
+
+  Result<NoDefault, std::string> err = Err(std::string("bad"));
+  EXPECT_EQ(err.UnwrapErr(), "bad");
+}
+
+// Unwrap が参照を返し、rvalue からはムーブできること
+TEST(ResultTest, UnwrapReferences) {
+  Result<std::string, int> result = Ok(std::string("hello"));
+  result.Unwrap() += " world";
+  EXPECT_EQ(result.Unwrap(), "hello world");
+
+  std::string moved = std::move(result).Unwrap();
+  EXPECT_EQ(moved, "hello world");
+
+  Result<std::unique_ptr<int>, int> owner = Ok(std::make_unique<int>(5));
+  auto ptr = std::move(owner).Value();
+  ASSERT_TRUE(ptr.has_value());
+  EXPECT_EQ(**ptr, 5);
+}
+
+// コピー/代入で中身の寿命が正しく管理されること
+TEST(ResultTest, AssignAcrossStates) {
+  auto shared = std::make_shared<int>(1);
+  {
+    Result<std::shared_ptr<int>, std::string> a = Ok(shared);
+    EXPECT_EQ(shared.use_count(), 2);
+
+    Result<std::shared_ptr<int>, std::string> b = a;
+    EXPECT_EQ(shared.use_count(), 3);
+
+    b = Err(std::string("replaced"));
+    EXPECT_EQ(shared.use_count(), 2);
+    EXPECT_EQ(b.UnwrapErr(), "replaced");
+
+    a = b;
+    EXPECT_EQ(shared.use_count(), 1);
+    EXPECT_FALSE(a.IsOk());
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+// AndThen / Map で成功時の処理を連結できること
+TEST(ResultTest, AndThenAndMap) {
+  auto parse = [](int v) -> Result<int, std::string> {
+    if (v < 0) {
+      return Err(std::string("negative"));
+    }
+    return Ok(v * 2);
+  };
+
+  Result<int, std::string> ok = Ok(10);
+  auto chained = ok.AndThen(parse).Map([](int v) { return v + 1; });
+  EXPECT_EQ(chained.Unwrap(), 21);
+
+  Result<int, std::string> negative = Ok(-1);
+  auto failed = negative.AndThen(parse).Map([](int v) { return v + 1; });
+  EXPECT_TRUE(failed.IsErr());
+  EXPECT_EQ(failed.UnwrapErr(), "negative");
+
+  auto as_string = ok.Map([](int v) { return std::to_string(v); });
+  static_assert(
+      std::is_same_v<decltype(as_string), Result<std::string, std::string>>);
+  EXPECT_EQ(as_string.Unwrap(), "10");
+}
+
+// OrElse / MapErr でエラー側を回復・変換できること
+TEST(ResultTest, OrElseAndMapErr) {
+  Result<int, std::string> err = Err(std::string("timeout"));
+
+  auto recovered = err.OrElse([](std::string const& e) -> Result<int, int> {
+    if (e == "timeout") {
+      return Ok(0);
+    }
+    return Err(-1);
+  });
+  EXPECT_TRUE(recovered.IsOk());
+  EXPECT_EQ(recovered.Unwrap(), 0);
+
+  auto code = err.MapErr([](std::string const& e) {
+    return static_cast<int>(e.size());
+  });
+  static_assert(std::is_same_v<decltype(code), Result<int, int>>);
+  EXPECT_EQ(code.UnwrapErr(), 7);
+
+  Result<int, std::string> ok = Ok(3);
+  EXPECT_EQ(ok.MapErr([](std::string const&) { return 0; }).Unwrap(), 3);
+  EXPECT_EQ(err.ValueOr(42), 42);
+}
+
+// void を値に持つ Result を扱えること
+TEST(ResultTest, VoidValue) {
+  Result<void, int> ok = Ok<void>();
+  EXPECT_TRUE(ok.IsOk());
+
+  int called = 0;
+  auto mapped = ok.Map([&called]() {
+    called++;
+    return 5;
+  });
+  EXPECT_EQ(called, 1);
+  EXPECT_EQ(mapped.Unwrap(), 5);
+
+  Result<void, int> err = Err(3);
+  EXPECT_EQ(err.Error().value(), 3);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
 #include <Nano/span.hpp>
 
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <span>
+
+using Nano::collection::AsBytes;
+using Nano::collection::AsWritableBytes;
+using Nano::collection::ReinterpretAs;
 using Nano::collection::Span;
 
 // Span の基本的なコンストラクタテスト
@@ -86,6 +94,125 @@ TEST(SpanTest, SizeCheck) {
   EXPECT_EQ(span.size(), 100);
 }
 
+// 固定長 Span はサイズを保持しないこと
+TEST(SpanTest, StaticExtentStoresNoSize) {
+  static_assert(sizeof(Span<int, 4>) == sizeof(int*));
+  static_assert(sizeof(Span<int>) == sizeof(int*) + sizeof(size_t));
+
+  int data[] = {1, 2, 3, 4};
+  Span span(data);
+  static_assert(std::is_same_v<decltype(span), Span<int, 4>>);
+  EXPECT_EQ(span.size(), 4);
+  EXPECT_EQ(span.size_bytes(), 4 * sizeof(int));
+
+  Span<int> dynamic = span;
+  EXPECT_EQ(dynamic.size(), 4);
+
+  Span<int, 4> back(dynamic);
+  EXPECT_EQ(back.data(), data);
+}
+
+// const な Span から要素を読み書きできること
+TEST(SpanTest, ConstSpanAccess) {
+  int data[] = {1, 2, 3};
+  const Span<int> span(data, 3);
+
+  span[1] = 20;
+  EXPECT_EQ(span[1], 20);
+  EXPECT_EQ(span.front(), 1);
+  EXPECT_EQ(span.back(), 3);
+  EXPECT_FALSE(span.empty());
+}
+
+// range-for と標準アルゴリズムで走査できること
+TEST(SpanTest, Iteration) {
+  std::array<int, 5> data = {1, 2, 3, 4, 5};
+  Span span(data);
+
+  int sum = 0;
+  for (int v : span) {
+    sum += v;
+  }
+  EXPECT_EQ(sum, 15);
+  EXPECT_EQ(std::accumulate(span.begin(), span.end(), 0), 15);
+}
+
+// first / last / subspan で部分列を切り出せること
+TEST(SpanTest, Slicing) {
+  uint8_t frame[] = {0xAA, 0x05, 1, 2, 3, 4, 5, 0x55};
+  Span span(frame);
+
+  auto header = span.first<2>();
+  static_assert(std::is_same_v<decltype(header), Span<uint8_t, 2>>);
+  EXPECT_EQ(header[0], 0xAA);
+
+  auto footer = span.last<1>();
+  EXPECT_EQ(footer[0], 0x55);
+
+  auto payload = span.subspan<2, 5>();
+  static_assert(decltype(payload)::extent == 5);
+  EXPECT_EQ(payload.front(), 1);
+  EXPECT_EQ(payload.back(), 5);
+
+  auto rest = span.subspan<2>();
+  static_assert(decltype(rest)::extent == 6);
+
+  auto dynamic = span.subspan(2, header[1]);
+  EXPECT_EQ(dynamic.size(), 5);
+  EXPECT_EQ(dynamic.data(), &frame[2]);
+  EXPECT_EQ(span.first(3).size(), 3);
+  EXPECT_EQ(span.last(3)[0], 4);
+  EXPECT_EQ(span.subspan(6).size(), 2);
+}
+
+// constexpr で切り出しができること
+TEST(SpanTest, Constexpr) {
+  static constexpr int kData[] = {1, 2, 3, 4};
+  constexpr Span<const int, 4> span(kData);
+  constexpr auto tail = span.subspan<1>();
+  static_assert(tail.size() == 3);
+  static_assert(tail[0] == 2);
+  static_assert(span.last<1>()[0] == 4);
+  SUCCEED();
+}
+
+// std::span と相互に変換できること
+TEST(SpanTest, StdSpanInterop) {
+  int data[] = {1, 2, 3};
+  std::span<int> std_span(data);
+
+  Span<int> span = std_span;
+  EXPECT_EQ(span.size(), 3);
+
+  std::span<int> back = span;
+  EXPECT_EQ(back.data(), data);
+
+  Span<int, 3> fixed(data);
+  std::span<int, 3> std_fixed = fixed;
+  EXPECT_EQ(std_fixed[2], 3);
+}
+
+// バイト列として参照し、別の型として解釈できること
+TEST(SpanTest, ByteReinterpretation) {
+  uint32_t words[] = {0x04030201, 0x08070605};
+  auto bytes = AsBytes(Span(words));
+  static_assert(decltype(bytes)::extent == 8);
+  EXPECT_EQ(bytes.size(), 8);
+
+  uint32_t expected = 0;
+  std::memcpy(&expected, bytes.data(), sizeof(expected));
+  EXPECT_EQ(expected, words[0]);
+
+  auto writable = AsWritableBytes(Span(words));
+  writable[0] = 0xFF;
+  EXPECT_EQ(words[0] & 0xFF, 0xFFu);
+
+  alignas(uint16_t) uint8_t raw[5] = {1, 0, 2, 0, 9};
+  auto halves = ReinterpretAs<const uint16_t>(Span<const uint8_t>(raw, 5));
+  EXPECT_EQ(halves.size(), 2);
+  EXPECT_EQ(halves[1], 2);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <Nano/static_vector.hpp>
+
+#include <memory>
+#include <string>
+
+using Nano::collection::Span;
+using Nano::collection::StaticVector;
+
+// 基本的な追加と参照
+TEST(StaticVectorTest, PushBack) {
+  StaticVector<int, 4> vec;
+  EXPECT_TRUE(vec.empty());
+
+  EXPECT_TRUE(vec.push_back(1));
+  EXPECT_TRUE(vec.push_back(2));
+  EXPECT_NE(vec.emplace_back(3), nullptr);
+  EXPECT_EQ(vec.size(), 3u);
+  EXPECT_EQ(vec.front(), 1);
+  EXPECT_EQ(vec.back(), 3);
+
+  EXPECT_TRUE(vec.push_back(4));
+  EXPECT_TRUE(vec.full());
+  EXPECT_FALSE(vec.push_back(5));
+  EXPECT_EQ(vec.emplace_back(5), nullptr);
+  EXPECT_EQ(vec.size(), 4u);
+}
+
+// std::vector と同じ形で構築できること
+TEST(StaticVectorTest, Construct) {
+  StaticVector<uint8_t, 8> zeros(3);
+  EXPECT_EQ(zeros.size(), 3u);
+  EXPECT_EQ(zeros[2], 0);
+
+  StaticVector<uint8_t, 8> list{1, 2, 3};
+  EXPECT_EQ(list.size(), 3u);
+  EXPECT_EQ(list[1], 2);
+
+  StaticVector<uint8_t, 8> filled(4, 0xAA);
+  EXPECT_EQ(filled[3], 0xAA);
+
+  // 容量を超えた分は切り捨てる
+  StaticVector<uint8_t, 2> clipped{1, 2, 3};
+  EXPECT_EQ(clipped.size(), 2u);
+
+  auto copy = list;
+  EXPECT_EQ(copy, list);
+}
+
+// 途中への挿入と削除で順序が保たれること
+TEST(StaticVectorTest, InsertErase) {
+  StaticVector<int, 8> vec{1, 2, 5};
+
+  EXPECT_NE(vec.insert(vec.begin() + 2, 4), nullptr);
+  EXPECT_NE(vec.insert(vec.begin() + 2, 3), nullptr);
+  EXPECT_EQ(vec, (StaticVector<int, 8>{1, 2, 3, 4, 5}));
+
+  int const more[] = {6, 7, 8};
+  EXPECT_NE(vec.insert(vec.end(), more, 3), nullptr);
+  EXPECT_EQ(vec.size(), 8u);
+  EXPECT_EQ(vec.insert(vec.begin(), 0), nullptr);
+
+  auto* next = vec.erase(vec.begin());
+  EXPECT_EQ(*next, 2);
+  vec.erase(vec.begin() + 1, vec.begin() + 4);
+  EXPECT_EQ(vec, (StaticVector<int, 8>{2, 6, 7, 8}));
+}
+
+// 非トリビアルな型でも挿入・削除・破棄が正しく行われること
+TEST(StaticVectorTest, NonTrivial) {
+  auto shared = std::make_shared<int>(0);
+  {
+    StaticVector<std::shared_ptr<int>, 4> vec;
+    vec.push_back(shared);
+    vec.push_back(shared);
+    vec.insert(vec.begin(), shared);
+    EXPECT_EQ(shared.use_count(), 4);
+
+    vec.erase(vec.begin() + 1);
+    EXPECT_EQ(shared.use_count(), 3);
+
+    auto moved = std::move(vec);
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(shared.use_count(), 3);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+
+  StaticVector<std::string, 4> strings{"a", "c"};
+  strings.insert(strings.begin() + 1, "b");
+  EXPECT_EQ(strings[1], "b");
+  EXPECT_EQ(strings[2], "c");
+}
+
+// resize で伸縮し、容量超過は N で止まること
+TEST(StaticVectorTest, Resize) {
+  StaticVector<int, 4> vec{1, 2, 3};
+
+  EXPECT_TRUE(vec.resize(1));
+  EXPECT_EQ(vec.size(), 1u);
+
+  EXPECT_TRUE(vec.resize(3));
+  EXPECT_EQ(vec[0], 1);
+  EXPECT_EQ(vec[2], 0);
+
+  EXPECT_FALSE(vec.resize(10));
+  EXPECT_EQ(vec.size(), 4u);
+}
+
+// 既定メンバ初期化子を持つ trivially copyable な型も値初期化されること
+TEST(StaticVectorTest, ResizeWithMemberInitializer) {
+  struct Point {
+    int x = 7;
+    int y = -1;
+  };
+  static_assert(std::is_trivially_copyable_v<Point>);
+
+  StaticVector<Point, 4> vec;
+  EXPECT_TRUE(vec.resize(2));
+  EXPECT_EQ(vec[1].x, 7);
+  EXPECT_EQ(vec[1].y, -1);
+
+  StaticVector<Point, 4> sized(3);
+  EXPECT_EQ(sized[2].x, 7);
+}
+
+// Span に暗黙変換できること
+TEST(StaticVectorTest, SpanConversion) {
+  StaticVector<uint8_t, 8> vec{1, 2, 3};
+
+  Span<uint8_t> span = vec;
+  EXPECT_EQ(span.size(), 3u);
+  span[0] = 10;
+  EXPECT_EQ(vec[0], 10);
+
+  auto const& const_vec = vec;
+  Span<const uint8_t> const_span = const_vec;
+  EXPECT_EQ(const_span.data(), vec.data());
+
+  StaticVector<uint8_t, 8> from_span(const_span);
+  EXPECT_EQ(from_span, vec);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
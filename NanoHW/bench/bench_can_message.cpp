@@ -0,0 +1,132 @@
+// CANMessage の旧レイアウト (20 バイト) と 16 バイト版の比較
+//   - Queue:   受信キューに 32 フレームずつ積んで取り出す
+//   - Receive: mbed::CANMessage 相当からの変換 + キュー経由の受け渡し
+//              (旧: len までのバイトループ、新: 8 バイト一括コピー)
+
+#include <Nano/queue.hpp>
+#include <NanoHW/can_message.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+using Nano::collection::Queue;
+using nano_hw::can::CANMessage;
+using nano_hw::can::CANMessageFormat;
+
+constexpr size_t kQueueSize = 64;
+constexpr size_t kBurst = 32;
+constexpr size_t kFrames = 1 << 22;
+
+/// 変更前の nano_hw::can::CANMessage
+struct LegacyCANMessage {
+  uint32_t id = 0;
+  uint8_t data[8] = {};  // NOLINT
+  uint8_t len = 0;
+  enum class Format { kStandard, kExtended } format;
+};
+
+/// mbed::CANMessage と同じ並び
+struct MbedLikeMessage {
+  unsigned int id;
+  unsigned char data[8];  // NOLINT
+  unsigned char len;
+  uint8_t format;
+  uint8_t type;
+};
+
+LegacyCANMessage ConvertLegacy(MbedLikeMessage const& src) {
+  LegacyCANMessage msg;
+  msg.id = src.id;
+  msg.len = src.len;
+  for (int i = 0; i < src.len && i < 8; ++i) {
+    msg.data[i] = src.data[i];
+  }
+  return msg;
+}
+
+CANMessage ConvertCompact(MbedLikeMessage const& src) {
+  CANMessage msg;
+  msg.id = src.id;
+  msg.SetFormat(src.format != 0 ? CANMessageFormat::kExtended
+                                : CANMessageFormat::kStandard);
+  msg.SetRemote(src.type != 0);
+  msg.len = src.len;
+  msg.CopyPayloadFrom(src.data);
+  return msg;
+}
+
+template <typename F>
+void Report(const char* name, F body) {
+  auto const start = std::chrono::steady_clock::now();
+  auto const checksum = body();
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+
+  auto const ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  std::printf("%-18s %6.2f ns/frame  %7.1f Mframes/s  (checksum %llu)\n",
+              name, static_cast<double>(ns) / kFrames,
+              static_cast<double>(kFrames) * 1e3 / static_cast<double>(ns),
+              static_cast<unsigned long long>(checksum));  // NOLINT
+}
+
+template <typename Message>
+uint64_t QueueThroughput() {
+  static Queue<Message, kQueueSize> queue;
+
+  Message msg{};
+  msg.len = 8;
+  uint64_t checksum = 0;
+  for (size_t i = 0; i < kFrames; i += kBurst) {
+    for (size_t j = 0; j < kBurst; j++) {
+      msg.id = static_cast<uint32_t>(i + j) & 0x7FF;
+      msg.data[0] = static_cast<uint8_t>(j);
+      queue.Push(msg);
+    }
+    while (!queue.Empty()) {
+      auto const out = queue.Pop();
+      checksum += out.id + out.data[0];
+    }
+  }
+  return checksum;
+}
+
+template <typename Convert>
+uint64_t ReceivePath(Convert convert) {
+  using Message = decltype(convert(MbedLikeMessage{}));
+  static Queue<Message, kQueueSize> queue;
+
+  MbedLikeMessage raw[kBurst];
+  for (size_t j = 0; j < kBurst; j++) {
+    raw[j] = {static_cast<unsigned>(0x100 + j), {1, 2, 3, 4, 5, 6, 7, 8},
+              static_cast<unsigned char>(1 + j % 8), 0, 0};
+  }
+
+  uint64_t checksum = 0;
+  for (size_t i = 0; i < kFrames; i += kBurst) {
+    for (auto const& frame : raw) {
+      queue.Push(convert(frame));
+    }
+    while (!queue.Empty()) {
+      auto const out = queue.Pop();
+      checksum += out.id + out.data[out.len - 1];
+    }
+  }
+  return checksum;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("sizeof: legacy %zu, compact %zu\n", sizeof(LegacyCANMessage),
+              sizeof(CANMessage));
+
+  Report("Queue (legacy)", QueueThroughput<LegacyCANMessage>);
+  Report("Queue (compact)", QueueThroughput<CANMessage>);
+  Report("Receive (legacy)", [] { return ReceivePath(ConvertLegacy); });
+  Report("Receive (compact)", [] { return ReceivePath(ConvertCompact); });
+
+  return 0;
+}
@@ -0,0 +1,418 @@
+#pragma once
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include "high_res_clock.hpp"
+#include "instance_pool.hpp"
+
+#ifndef NANO_HW_ASYNC_FRAME_SIZE
+#define NANO_HW_ASYNC_FRAME_SIZE 256
+#endif
+
+#ifndef NANO_HW_ASYNC_FRAME_COUNT
+#define NANO_HW_ASYNC_FRAME_COUNT 16
+#endif
+
+#ifndef NANO_HW_ASYNC_MAX_TASKS
+#define NANO_HW_ASYNC_MAX_TASKS 8
+#endif
+
+namespace nano_hw::async {
+
+/// @brief コルーチンフレーム用の固定長ブロックプール
+/// @note Scheduler と同じくシングルスレッド前提
+class FramePool {
+ public:
+  static constexpr size_t kFrameSize = NANO_HW_ASYNC_FRAME_SIZE;
+  static constexpr size_t kFrameCount = NANO_HW_ASYNC_FRAME_COUNT;
+
+  /// @return 確保できなければ nullptr
+  static void* Allocate(size_t size) noexcept {
+    if (size > kFrameSize) {
+      return nullptr;
+    }
+    for (size_t i = 0; i < kFrameCount; i++) {
+      if (!used_[i]) {
+        used_[i] = true;
+        return &storage_[i * kFrameSize];
+      }
+    }
+    return nullptr;
+  }
+
+  static void Free(void* ptr) noexcept {
+    auto const offset = static_cast<uint8_t*>(ptr) - storage_.data();
+    used_[static_cast<size_t>(offset) / kFrameSize] = false;
+  }
+
+  /// @brief 使用中のブロック数
+  static size_t InUse() noexcept {
+    size_t count = 0;
+    for (auto used : used_) {
+      count += used ? 1 : 0;
+    }
+    return count;
+  }
+
+ private:
+  alignas(std::max_align_t) static inline std::array<
+      uint8_t, kFrameSize * kFrameCount> storage_{};
+  static inline std::array<bool, kFrameCount> used_{};
+};
+
+class Scheduler;
+
+namespace detail {
+
+struct PromiseBase {
+  Scheduler* scheduler = nullptr;
+  std::coroutine_handle<> continuation = nullptr;
+
+  static void* operator new(size_t size) noexcept {
+    return FramePool::Allocate(size);
+  }
+  static void operator delete(void* ptr) noexcept { FramePool::Free(ptr); }
+
+  std::suspend_always initial_suspend() noexcept { return {}; }
+
+  struct FinalAwaiter {
+    bool await_ready() noexcept { return false; }
+
+    template <typename P>
+    std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<P> handle) noexcept {
+      if (auto next = handle.promise().continuation) {
+        return next;
+      }
+      return std::noop_coroutine();
+    }
+
+    void await_resume() noexcept {}
+  };
+
+  FinalAwaiter final_suspend() noexcept { return {}; }
+
+  void unhandled_exception() noexcept { std::terminate(); }
+};
+
+template <typename T>
+struct Promise;
+
+}  // namespace detail
+
+/// @brief Scheduler 上で動くコルーチン
+/// @details
+///   - フレームは FramePool から確保する (ヒープを使わない)
+///   - 確保に失敗した場合は Valid() が false の Task になる
+///   - 他の Task から co_await すると子として実行される。確保に失敗した
+///     子を co_await すると NANO_HW_POOL_EXHAUSTED() で止まる
+///     (実行されなかった子の結果を T{} として返さない)
+template <typename T = void>
+class [[nodiscard]] Task {
+ public:
+  using promise_type = detail::Promise<T>;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  Task() = default;
+  explicit Task(Handle handle) : handle_(handle) {}
+
+  Task(Task const&) = delete;
+  Task& operator=(Task const&) = delete;
+
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  ~Task() { Reset(); }
+
+  /// @brief フレームを確保できたか
+  [[nodiscard]] bool Valid() const { return static_cast<bool>(handle_); }
+
+  [[nodiscard]] bool Done() const { return !handle_ || handle_.done(); }
+
+  /// @brief フレームの所有権を手放す (Scheduler 用)
+  Handle Release() { return std::exchange(handle_, {}); }
+
+  struct Awaiter {
+    Handle child;
+
+    bool await_ready() const noexcept {
+      if (!child) {
+        NANO_HW_POOL_EXHAUSTED();
+      }
+      return child.done();
+    }
+
+    template <typename P>
+    std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<P> parent) noexcept {
+      child.promise().continuation = parent;
+      child.promise().scheduler = parent.promise().scheduler;
+      return child;
+    }
+
+    T await_resume() {
+      if constexpr (!std::is_void_v<T>) {
+        if (!child.promise().value) {
+          return T{};
+        }
+        return std::move(*child.promise().value);
+      }
+    }
+  };
+
+  Awaiter operator co_await() const noexcept { return Awaiter{handle_}; }
+
+ private:
+  void Reset() {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = {};
+    }
+  }
+
+  Handle handle_ = nullptr;
+};
+
+namespace detail {
+
+template <typename T>
+struct Promise : PromiseBase {
+  std::optional<T> value;
+
+  Task<T> get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<Promise>::from_promise(*this));
+  }
+  static Task<T> get_return_object_on_allocation_failure() noexcept {
+    return Task<T>();
+  }
+
+  template <typename U>
+  void return_value(U&& result) {
+    value.emplace(static_cast<U&&>(result));
+  }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+  Task<void> get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<Promise>::from_promise(*this));
+  }
+  static Task<void> get_return_object_on_allocation_failure() noexcept {
+    return Task<void>();
+  }
+
+  void return_void() noexcept {}
+};
+
+}  // namespace detail
+
+/// @brief シングルスレッドのコルーチンスケジューラ
+/// @details
+///   - Spawn したルート Task を RunOnce / Run で進める
+///   - 待機中のコルーチンは {handle, 判定関数, ctx} として登録され、
+///     RunOnce の度に判定関数をポーリングする
+class Scheduler {
+ public:
+  using NowFunction = HighResClockDuration (*)();
+  using ReadyFunction = bool (*)(void* ctx);
+
+  static constexpr size_t kMaxTasks = NANO_HW_ASYNC_MAX_TASKS;
+
+  explicit Scheduler(NowFunction now = &HighResClock_Now) : now_(now) {}
+
+  Scheduler(Scheduler const&) = delete;
+  Scheduler& operator=(Scheduler const&) = delete;
+
+  ~Scheduler() {
+    for (auto& root : roots_) {
+      if (root) {
+        root.destroy();
+      }
+    }
+  }
+
+  /// @brief ルート Task を登録する
+  /// @return フレーム確保失敗 / 登録数超過なら false
+  bool Spawn(Task<void>&& task) {
+    if (!task.Valid()) {
+      return false;
+    }
+    for (auto& root : roots_) {
+      if (!root) {
+        root = task.Release();
+        root.promise().scheduler = this;
+        Wait(root, &AlwaysReady, nullptr);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @brief 準備の整ったコルーチンを 1 巡分進める
+  /// @return 実行したコルーチンの数
+  size_t RunOnce() {
+    size_t resumed = 0;
+    for (auto& waiter : waiters_) {
+      if (!waiter.handle || !waiter.ready(waiter.ctx)) {
+        continue;
+      }
+      auto handle = std::exchange(waiter.handle, {});
+      handle.resume();
+      resumed++;
+    }
+
+    for (auto& root : roots_) {
+      if (root && root.done()) {
+        root.destroy();
+        root = {};
+      }
+    }
+    return resumed;
+  }
+
+  /// @brief 全てのルート Task が完了するまで回す
+  void Run() {
+    while (Alive() != 0) {
+      RunOnce();
+    }
+  }
+
+  /// @brief 未完了のルート Task 数
+  [[nodiscard]] size_t Alive() const {
+    size_t count = 0;
+    for (auto const& root : roots_) {
+      count += root ? 1 : 0;
+    }
+    return count;
+  }
+
+  [[nodiscard]] HighResClockDuration Now() const { return now_(); }
+
+  /// @brief handle を ready(ctx) が true になるまで待たせる
+  /// @note 待機中のコルーチンはルート Task あたり高々 1 つなので溢れない
+  void Wait(std::coroutine_handle<> handle, ReadyFunction ready, void* ctx) {
+    for (auto& waiter : waiters_) {
+      if (!waiter.handle) {
+        waiter = Waiter{handle, ready, ctx};
+        return;
+      }
+    }
+    std::terminate();
+  }
+
+ private:
+  struct Waiter {
+    std::coroutine_handle<> handle = nullptr;
+    ReadyFunction ready = nullptr;
+    void* ctx = nullptr;
+  };
+
+  static bool AlwaysReady(void*) { return true; }
+
+  NowFunction now_;
+  std::array<std::coroutine_handle<detail::Promise<void>>, kMaxTasks> roots_{};
+  std::array<Waiter, kMaxTasks> waiters_{};
+};
+
+/// @brief Ready() が true になるまで待つ Awaiter の CRTP 基底
+/// @details Derived は bool Ready() と Result() を実装する
+template <typename Derived>
+class PollAwaiter {
+ public:
+  bool await_ready() { return self().Ready(); }
+
+  template <typename P>
+  void await_suspend(std::coroutine_handle<P> handle) {
+    handle.promise().scheduler->Wait(handle, &Thunk, this);
+  }
+
+  auto await_resume() { return self().Result(); }
+
+ private:
+  static bool Thunk(void* ctx) {
+    return static_cast<PollAwaiter*>(ctx)->self().Ready();
+  }
+
+  Derived& self() { return static_cast<Derived&>(*this); }
+};
+
+struct YieldAwaiter {
+  bool await_ready() const noexcept { return false; }
+
+  template <typename P>
+  void await_suspend(std::coroutine_handle<P> handle) {
+    handle.promise().scheduler->Wait(
+        handle, [](void*) { return true; }, nullptr);
+  }
+
+  void await_resume() const noexcept {}
+};
+
+struct SleepAwaiter {
+  HighResClockDuration duration;
+  Scheduler* scheduler = nullptr;
+  HighResClockDuration deadline{};
+
+  bool await_ready() const noexcept {
+    return duration <= HighResClockDuration::zero();
+  }
+
+  template <typename P>
+  void await_suspend(std::coroutine_handle<P> handle) {
+    scheduler = handle.promise().scheduler;
+    deadline = scheduler->Now() + duration;
+    scheduler->Wait(handle, &Expired, this);
+  }
+
+  void await_resume() const noexcept {}
+
+ private:
+  static bool Expired(void* ctx) {
+    auto* self = static_cast<SleepAwaiter*>(ctx);
+    return self->scheduler->Now() >= self->deadline;
+  }
+};
+
+struct WaitUntilAwaiter {
+  Scheduler::ReadyFunction ready;
+  void* ctx;
+
+  bool await_ready() const { return ready(ctx); }
+
+  template <typename P>
+  void await_suspend(std::coroutine_handle<P> handle) {
+    handle.promise().scheduler->Wait(handle, ready, ctx);
+  }
+
+  void await_resume() const noexcept {}
+};
+
+/// @brief 次の RunOnce まで実行を譲る
+inline YieldAwaiter Yield() {
+  return {};
+}
+
+/// @brief 指定時間だけ待つ
+/// @note 時刻は Scheduler に渡した NowFunction で測る
+inline SleepAwaiter SleepFor(HighResClockDuration duration) {
+  return SleepAwaiter{duration};
+}
+
+/// @brief ready(ctx) が true になるまで待つ
+inline WaitUntilAwaiter WaitUntil(Scheduler::ReadyFunction ready, void* ctx) {
+  return WaitUntilAwaiter{ready, ctx};
+}
+
+}  // namespace nano_hw::async
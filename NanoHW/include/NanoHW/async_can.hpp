@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Nano/queue.hpp>
+
+#include "async.hpp"
+#include "can.hpp"
+
+namespace nano_hw::async {
+
+/// @brief CAN ドライバを co_await で扱うラッパ
+/// @details
+///   受信コールバック (OnCANReceived) で内部 Queue に積み、
+///   Receive() の Awaiter がそれをポーリングする
+/// @tparam CanT CAN concept を満たすドライバ
+/// @tparam kRxDepth 受信 Queue の長さ
+template <template <can::CANConfig> typename CanT, size_t kRxDepth = 16>
+class AsyncCAN {
+  static void OnReceived(void* ctx, can::CANMessage msg) {
+    static_cast<AsyncCAN*>(ctx)->rx_.Push(msg);
+  }
+
+ public:
+  struct Config {
+    using OnCANReceived = nano_hw::Direct<&AsyncCAN::OnReceived>;
+    using OnCANTransmit = nano_hw::Ignore;
+    using OnCANBusError = nano_hw::Ignore;
+    using OnCANPassiveError = nano_hw::Ignore;
+  };
+  using Driver = CanT<Config>;
+
+  AsyncCAN(Pin transmit_pin, Pin receive_pin, int frequency)
+      : driver_(transmit_pin, receive_pin, frequency, this) {}
+
+  AsyncCAN(AsyncCAN const&) = delete;
+  AsyncCAN& operator=(AsyncCAN const&) = delete;
+
+  class ReceiveAwaiter : public PollAwaiter<ReceiveAwaiter> {
+   public:
+    explicit ReceiveAwaiter(AsyncCAN& can) : can_(can) {}
+
+    bool Ready() { return !can_.rx_.Empty(); }
+    can::CANMessage Result() { return can_.rx_.Pop(); }
+
+   private:
+    AsyncCAN& can_;
+  };
+
+  /// @brief 1 フレーム受信するまで待つ
+  ReceiveAwaiter Receive() { return ReceiveAwaiter(*this); }
+
+  bool Send(can::CANMessage msg) { return driver_.SendMessage(msg); }
+
+  Driver& GetDriver() { return driver_; }
+
+ private:
+  Nano::collection::Queue<can::CANMessage, kRxDepth> rx_;
+  Driver driver_;
+};
+
+}  // namespace nano_hw::async
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Nano/queue.hpp>
+#include <Nano/span.hpp>
+
+#include "async.hpp"
+#include "uart.hpp"
+
+namespace nano_hw::async {
+
+/// @brief UART ドライバを co_await で扱うラッパ
+/// @details
+///   受信コールバック (OnUARTRx) で内部 Queue に積み、
+///   Read() / ReadUntil() の Awaiter がそれをポーリングする
+/// @tparam UartT UART concept を満たし、context 付きで構築できるドライバ
+/// @tparam kRxDepth 受信 Queue の長さ
+/// @tparam kLineMax ReadUntil で返す行バッファの長さ
+template <template <uart::UARTConfig> typename UartT, size_t kRxDepth = 256,
+          size_t kLineMax = 128>
+class AsyncUART {
+  static void OnRx(void* ctx, const uint8_t* buffer, size_t size) {
+    static_cast<AsyncUART*>(ctx)->rx_.PushN(buffer, size);
+  }
+
+ public:
+  struct Config {
+    using OnUARTRx = nano_hw::Direct<&AsyncUART::OnRx>;
+    using OnUARTTx = nano_hw::Ignore;
+  };
+  using Driver = UartT<Config>;
+
+  AsyncUART(Pin transmit_pin, Pin receive_pin, int frequency)
+      : driver_(transmit_pin, receive_pin, frequency, this) {}
+
+  AsyncUART(AsyncUART const&) = delete;
+  AsyncUART& operator=(AsyncUART const&) = delete;
+
+  class ReadAwaiter : public PollAwaiter<ReadAwaiter> {
+   public:
+    explicit ReadAwaiter(AsyncUART& uart) : uart_(uart) {}
+
+    bool Ready() { return !uart_.rx_.Empty(); }
+    uint8_t Result() { return uart_.rx_.Pop(); }
+
+   private:
+    AsyncUART& uart_;
+  };
+
+  class ReadUntilAwaiter : public PollAwaiter<ReadUntilAwaiter> {
+   public:
+    ReadUntilAwaiter(AsyncUART& uart, uint8_t delimiter)
+        : uart_(uart), delimiter_(delimiter) {
+      uart_.line_size_ = 0;
+    }
+
+    /// 届いている分を行バッファに移し、区切り文字か満杯で完了
+    bool Ready() {
+      while (!uart_.rx_.Empty()) {
+        auto const byte = uart_.rx_.Pop();
+        if (byte == delimiter_) {
+          return true;
+        }
+        uart_.line_[uart_.line_size_++] = byte;
+        if (uart_.line_size_ == kLineMax) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    Nano::collection::Span<uint8_t> Result() {
+      return {uart_.line_.data(), uart_.line_size_};
+    }
+
+   private:
+    AsyncUART& uart_;
+    uint8_t delimiter_;
+  };
+
+  /// @brief 1 バイト受信するまで待つ
+  ReadAwaiter Read() { return ReadAwaiter(*this); }
+
+  /// @brief delimiter を受信するまで待ち、それまでのデータを返す
+  /// @note 返る Span は内部バッファを指し、次の ReadUntil まで有効。
+  ///       delimiter は含まない。kLineMax を超えた場合はそこで打ち切る
+  ReadUntilAwaiter ReadUntil(uint8_t delimiter) {
+    return ReadUntilAwaiter(*this, delimiter);
+  }
+
+  size_t Write(void* buffer, size_t size) {
+    return driver_.Send(buffer, size);
+  }
+
+  Driver& GetDriver() { return driver_; }
+
+ private:
+  Nano::collection::Queue<uint8_t, kRxDepth> rx_;
+  std::array<uint8_t, kLineMax> line_{};
+  size_t line_size_ = 0;
+  Driver driver_;
+};
+
+}  // namespace nano_hw::async
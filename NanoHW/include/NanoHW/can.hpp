@@ -3,38 +3,12 @@
 #include <concepts>
 #include <cstdint>
 
+#include "can_message.hpp"
+#include "can_stats.hpp"
 #include "pin.hpp"
 #include "policies.hpp"
 
 namespace nano_hw::can {
-enum class CANMessageFormat { kStandard, kExtended };
-
-struct CANMessage {
-  uint32_t id = 0;
-  uint8_t data[8] = {};  // NOLINT
-  uint8_t len = 0;
-  CANMessageFormat format;
-};
-
-enum class CANMode { kNormal, kLoopback };
-
-struct CANFilter {
-  enum class Type {
-    kMask,
-    kList,
-  } filter_type;
-
-  union {
-    struct {
-      uint32_t mask;
-      uint32_t id;
-    } mask_filter;
-    struct {
-      uint32_t id;
-    } list_filter;
-  } filter;
-};
-
 template <typename T>
 concept CANConfig = Policy<typename T::OnCANReceived, void*, CANMessage> &&
                     Policy<typename T::OnCANTransmit, void*, CANMessage> &&
@@ -78,6 +52,13 @@ concept CANWithPolling =
   {value.TryReceive(msg)}->std::same_as<bool>;
 };
 
+/// @brief データフェーズのビットレートを別に設定できる CAN (CAN FD)
+template <template <CANConfig> typename CanT>
+concept CANFD = CAN<CanT> && requires(CanT<DummyCANConfig> value,
+                                      int nominal, int data) {
+  {value.ChangeBaudrate(nominal, data)}->std::same_as<void>;
+};
+
 struct ICallbacks {
  public:
   virtual void OnCANReceived(void* context, CANMessage msg) = 0;
@@ -90,6 +71,9 @@ void* AllocInterface(Pin transmit_pin, Pin receive_pin, int frequency,
                      ICallbacks* callbacks, void* callback_context);
 void FreeInterface(void* interface);
 void ChangeBaudrateImpl(void* interface, int frequency);
+#if NANO_HW_CAN_FD
+void ChangeBaudrateImpl(void* interface, int nominal, int data);
+#endif
 void ChangeModeImpl(void* interface, CANMode mode);
 bool SendMessageImpl(void* interface, CANMessage msg);
 int TransmitErrorsImpl(void* interface);
@@ -98,6 +82,7 @@ void ResetPeripheralsImpl(void* interface);
 void SetFilterImpl(void* interface, int filter_num, CANFilter filter);
 void DeactivateFilterImpl(void* interface, int filter_num, CANFilter filter);
 bool TryReceiveImpl(void* interface, CANMessage& msg);
+bool StatsImpl(void* interface, CANStatsSnapshot& out);
 
 template <CANConfig Config>
 class DynCAN {
@@ -138,6 +123,11 @@ class DynCAN {
   void ChangeBaudrate(int frequency) {
     ChangeBaudrateImpl(interface_, frequency);
   }
+#if NANO_HW_CAN_FD
+  void ChangeBaudrate(int nominal, int data) {
+    ChangeBaudrateImpl(interface_, nominal, data);
+  }
+#endif
 
   void SetFilter(int filter_num, CANFilter filter) {
     SetFilterImpl(interface_, filter_num, filter);
@@ -148,6 +138,9 @@ class DynCAN {
 
   bool TryReceive(CANMessage& msg) { return TryReceiveImpl(interface_, msg); }
 
+  /// @brief 送受信統計を読み出す (統計なしの CANImpl では false)
+  bool Stats(CANStatsSnapshot& out) { return StatsImpl(interface_, out); }
+
  private:
   static inline Callbacks callbacks = {};
   void* interface_;
@@ -155,5 +148,8 @@ class DynCAN {
 
 static_assert(CAN<DynCAN>);
 static_assert(CANWithPolling<DynCAN>);
+#if NANO_HW_CAN_FD
+static_assert(CANFD<DynCAN>);
+#endif
 
 }  // namespace nano_hw::can
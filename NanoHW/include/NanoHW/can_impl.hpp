@@ -1,8 +1,10 @@
 #pragma once
 
+#include <type_traits>
 #include <utility>
 
 #include "can.hpp"
+#include "instance_pool.hpp"
 #include "policies.hpp"
 
 namespace nano_hw::can {
@@ -12,6 +14,9 @@ void* AllocCANInterfaceImpl(Pin transmit_pin, Pin receive_pin, int frequency,
                             ICallbacks* callbacks, void* callback_context);
 void FreeCANInterfaceImpl(void* inst);
 void ChangeBaudrateCANImpl(void* inst, int frequency);
+#if NANO_HW_CAN_FD
+void ChangeBaudrateFDCANImpl(void* inst, int nominal, int data);
+#endif
 void ChangeModeCANImpl(void* inst, CANMode mode);
 bool SendMessageCANImpl(void* inst, CANMessage msg);
 int TransmitErrorsCANImpl(void* inst);
@@ -20,17 +25,23 @@ void ResetPeripheralsCANImpl(void* inst);
 void SetFilterCANImpl(void* inst, int filter_num, CANFilter filter);
 void DeactivateFilterCANImpl(void* inst, int filter_num, CANFilter filter);
 bool TryReceiveCANImpl(void* inst, CANMessage& msg);
+bool StatsCANImpl(void* inst, CANStatsSnapshot& out);
 
 /// @brief CAN conceptを満たす型から動的ディスパッチ関数を生成
 /// @tparam CanT CAN conceptを満たすテンプレートクラス
-template <template <CANConfig> typename CanT>
+/// @tparam Stats 送受信統計 (CANStats<Clock> を渡すと記録する)
+/// @tparam kInstances 同時に持てるインスタンス数
+template <template <CANConfig> typename CanT, typename Stats = NoCANStats,
+          size_t kInstances = kMaxInstances>
 requires CAN<CanT> class CANImpl {
   // Context: コールバック情報を一つの型に統合
   struct Context {
     ICallbacks* callbacks = nullptr;
     void* callback_context = nullptr;
+    Stats stats;
 
     void OnCANReceived(CANMessage msg) {
+      stats.OnReceive(msg);
       if (callbacks != nullptr) {
         callbacks->OnCANReceived(callback_context, msg);
       }
@@ -43,12 +54,14 @@ requires CAN<CanT> class CANImpl {
     }
 
     void OnCANBusError() {
+      stats.OnBusError();
       if (callbacks != nullptr) {
         callbacks->OnCANBusError(callback_context);
       }
     }
 
     void OnCANPassiveError() {
+      stats.OnPassiveError();
       if (callbacks != nullptr) {
         callbacks->OnCANPassiveError(callback_context);
       }
@@ -77,81 +90,103 @@ requires CAN<CanT> class CANImpl {
 
   using ImplType = CanT<CallbackConfig>;
 
-  // Instance: ImplType と Context を統合
+  // Instance: ImplType と Context を 1 スロットにまとめてプールに置く
   struct Instance {
-    ImplType* impl = nullptr;
-    Context* context = nullptr;
+    Instance(ICallbacks* callbacks, void* callback_context, Pin transmit_pin,
+             Pin receive_pin, int frequency)
+        : context{callbacks, callback_context},
+          impl(transmit_pin, receive_pin, frequency, &context) {
+      context.stats.SetBitrate(frequency);
+    }
+
+    Context context;
+    ImplType impl;
   };
 
+  static inline InstancePool<Instance, kInstances> pool_;
+
   friend void* AllocCANInterfaceImpl(Pin transmit_pin, Pin receive_pin,
                                      int frequency, ICallbacks* callbacks,
                                      void* callback_context) {
-    auto* ctx = new Context{callbacks, callback_context};
-    auto* impl = new ImplType(transmit_pin, receive_pin, frequency, ctx);
-    auto* instance = new Instance{impl, ctx};
-    return instance;
+    return pool_.New(callbacks, callback_context, transmit_pin, receive_pin,
+                     frequency);
   }
 
   friend void FreeCANInterfaceImpl(void* inst) {
-    auto* instance = static_cast<Instance*>(inst);
-    delete instance->impl;
-    delete instance->context;
-    delete instance;
+    pool_.Delete(static_cast<Instance*>(inst));
   }
 
   friend void ChangeBaudrateCANImpl(void* inst, int frequency) {
     auto* instance = static_cast<Instance*>(inst);
-    instance->impl->ChangeBaudrate(frequency);
+    instance->impl.ChangeBaudrate(frequency);
+    instance->context.stats.SetBitrate(frequency);
+  }
+
+#if NANO_HW_CAN_FD
+  friend void ChangeBaudrateFDCANImpl(void* inst, int nominal, int data) {
+    auto* instance = static_cast<Instance*>(inst);
+    if constexpr (CANFD<CanT>) {
+      instance->impl.ChangeBaudrate(nominal, data);
+    } else {
+      // classic のみのバックエンドはデータフェーズを持たない
+      instance->impl.ChangeBaudrate(nominal);
+    }
+    instance->context.stats.SetBitrate(nominal, data);
   }
+#endif
 
   friend void ChangeModeCANImpl(void* inst, CANMode mode) {
     auto* instance = static_cast<Instance*>(inst);
-    instance->impl->ChangeMode(mode);
+    instance->impl.ChangeMode(mode);
   }
 
   friend bool SendMessageCANImpl(void* inst, CANMessage msg) {
     auto* instance = static_cast<Instance*>(inst);
-    bool result = instance->impl->SendMessage(msg);
+    auto const start = Stats::Now();
+    bool result = instance->impl.SendMessage(msg);
     // コールバックを呼び出す
     if (result) {
-      CallbackConfig::OnCANTransmit::execute(instance->context, msg);
+      instance->context.stats.OnTransmit(msg, start);
+      CallbackConfig::OnCANTransmit::execute(&instance->context, msg);
+    } else {
+      instance->context.stats.OnTransmitFailed();
     }
     return result;
   }
 
   friend int TransmitErrorsCANImpl(void* inst) {
     auto* instance = static_cast<Instance*>(inst);
-    return instance->impl->TransmitErrors();
+    return instance->impl.TransmitErrors();
   }
 
   friend int ReceiveErrorsCANImpl(void* inst) {
     auto* instance = static_cast<Instance*>(inst);
-    return instance->impl->ReceiveErrors();
+    return instance->impl.ReceiveErrors();
   }
 
   friend void ResetPeripheralsCANImpl(void* inst) {
     auto* instance = static_cast<Instance*>(inst);
-    instance->impl->ResetPeripherals();
+    instance->impl.ResetPeripherals();
   }
 
   friend void SetFilterCANImpl(void* inst, int filter_num, CANFilter filter) {
     auto* instance = static_cast<Instance*>(inst);
-    instance->impl->SetFilter(filter_num, filter);
+    instance->impl.SetFilter(filter_num, filter);
   }
 
   friend void DeactivateFilterCANImpl(void* inst, int filter_num,
                                       CANFilter filter) {
     auto* instance = static_cast<Instance*>(inst);
-    instance->impl->DeactivateFilter(filter_num, filter);
+    instance->impl.DeactivateFilter(filter_num, filter);
   }
 
   friend bool TryReceiveCANImpl(void* inst, CANMessage& msg) {
     auto* instance = static_cast<Instance*>(inst);
-    if constexpr (requires { instance->impl->TryReceive(msg); }) {
-      bool result = instance->impl->TryReceive(msg);
+    if constexpr (requires { instance->impl.TryReceive(msg); }) {
+      bool result = instance->impl.TryReceive(msg);
       if (result) {
         // 受信成功時にコールバックを呼び出す
-        CallbackConfig::OnCANReceived::execute(instance->context, msg);
+        CallbackConfig::OnCANReceived::execute(&instance->context, msg);
       }
       return result;
     } else {
@@ -159,6 +194,18 @@ requires CAN<CanT> class CANImpl {
       return false;
     }
   }
+
+  friend bool StatsCANImpl(void* inst, CANStatsSnapshot& out) {
+    if constexpr (std::is_same_v<Stats, NoCANStats>) {
+      return false;
+    }
+    auto* instance = static_cast<Instance*>(inst);
+    auto& stats = instance->context.stats;
+    // エラーカウンタは読み出しのたびにサンプリングする
+    stats.SampleErrors(instance->impl.TransmitErrors(),
+                       instance->impl.ReceiveErrors());
+    return stats.Snapshot(out);
+  }
 };
 
 // Friend-Injection で定義された関数はオブジェクトファイルに含まれないため、
@@ -174,6 +221,11 @@ void FreeInterface(void* inst) {
 void ChangeBaudrateImpl(void* inst, int frequency) {
   ChangeBaudrateCANImpl(inst, frequency);
 }
+#if NANO_HW_CAN_FD
+void ChangeBaudrateImpl(void* inst, int nominal, int data) {
+  ChangeBaudrateFDCANImpl(inst, nominal, data);
+}
+#endif
 void ChangeModeImpl(void* inst, CANMode mode) {
   ChangeModeCANImpl(inst, mode);
 }
@@ -198,5 +250,8 @@ void DeactivateFilterImpl(void* inst, int filter_num, CANFilter filter) {
 bool TryReceiveImpl(void* inst, CANMessage& msg) {
   return TryReceiveCANImpl(inst, msg);
 }
+bool StatsImpl(void* inst, CANStatsSnapshot& out) {
+  return StatsCANImpl(inst, out);
+}
 
 }  // namespace nano_hw::can
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "high_res_clock.hpp"
+
+// 1 にすると CAN FD (最大 64 バイトのペイロード) を扱う
+#ifndef NANO_HW_CAN_FD
+#define NANO_HW_CAN_FD 0
+#endif
+
+namespace nano_hw::can {
+enum class CANMessageFormat : uint8_t { kStandard, kExtended };
+enum class CANMode { kNormal, kLoopback };
+
+struct CANFilter {
+  enum class Type {
+    kMask,
+    kList,
+  } filter_type;
+
+  union {
+    struct {
+      uint32_t mask;
+      uint32_t id;
+    } mask_filter;
+    struct {
+      uint32_t id;
+    } list_filter;
+  } filter;
+};
+
+/// 1 フレームのペイロードの最大長
+inline constexpr size_t kCANMaxPayload = NANO_HW_CAN_FD ? 64 : 8;
+
+/// @brief DLC をバイト数に変換する
+/// @param fd FD フレームか (classic では 9 以上は 8 バイト)
+constexpr uint8_t DlcToLength(uint8_t dlc, bool fd) {
+  constexpr uint8_t kFDLengths[] = {12, 16, 20, 24, 32, 48, 64};
+  if (dlc <= 8) {
+    return dlc;
+  }
+  return fd ? kFDLengths[(dlc > 15 ? 15 : dlc) - 9] : 8;
+}
+
+/// @brief len バイトを収められる最小の DLC
+constexpr uint8_t LengthToDlc(size_t len) {
+  uint8_t dlc = 0;
+  while (dlc < 15 && DlcToLength(dlc, true) < len) {
+    dlc++;
+  }
+  return dlc;
+}
+
+/// @brief len を FD で送れる長さに切り上げる (送信時のパディング量)
+constexpr uint8_t PaddedLength(size_t len) {
+  return DlcToLength(LengthToDlc(len), true);
+}
+
+/// @brief CAN フレーム
+/// @details
+///   - ID と len / flags / timestamp で先頭 8 バイトに収める
+///     (ビットフィールドは読み書きのたびにマスクが入るので使わない)
+///   - フォーマットと RTR も flags に持つ (Format / IsRemote で読む)
+///   - 受信時刻は HighResClock の下位 16 ビット (約 65 秒で一周)。
+///     Timestamp(now) で now 以前の直近の時刻に戻す
+///   - ペイロードは 8 バイト境界に置き、words で語単位に扱える
+///   - classic では 16 バイト (キャッシュライン 1 本に 4 フレーム)、
+///     NANO_HW_CAN_FD では 72 バイト
+///   - 変換は CopyPayload でまとめてコピーする (len で回さない)
+struct CANMessage {
+  static constexpr size_t kPayloadSize = kCANMaxPayload;
+
+  /// FD フレーム (FDF)
+  static constexpr uint8_t kFlagFD = 1U << 0;
+  /// データフェーズをデータ用ビットレートで送る (BRS)
+  static constexpr uint8_t kFlagBRS = 1U << 1;
+  /// 送信ノードがエラーパッシブ (ESI、受信時のみ)
+  static constexpr uint8_t kFlagESI = 1U << 2;
+  /// リモートフレーム (RTR)
+  static constexpr uint8_t kFlagRTR = 1U << 3;
+  /// 拡張 ID (29 bit)
+  static constexpr uint8_t kFlagExtended = 1U << 4;
+  /// timestamp が有効
+  static constexpr uint8_t kFlagTimestamp = 1U << 5;
+
+  uint32_t id = 0;
+  uint8_t len = 0;
+  uint8_t flags = 0;
+  uint16_t timestamp = 0;
+
+  union alignas(8) {
+    uint8_t data[kPayloadSize] = {};  // NOLINT
+    uint64_t words[kPayloadSize / 8];
+  };
+
+  [[nodiscard]] CANMessageFormat Format() const {
+    return (flags & kFlagExtended) != 0 ? CANMessageFormat::kExtended
+                                        : CANMessageFormat::kStandard;
+  }
+  void SetFormat(CANMessageFormat format) {
+    SetFlag(kFlagExtended, format == CANMessageFormat::kExtended);
+  }
+
+  [[nodiscard]] bool IsRemote() const { return (flags & kFlagRTR) != 0; }
+  void SetRemote(bool remote) { SetFlag(kFlagRTR, remote); }
+
+  [[nodiscard]] bool IsFD() const { return (flags & kFlagFD) != 0; }
+  [[nodiscard]] bool BitrateSwitch() const { return (flags & kFlagBRS) != 0; }
+
+  [[nodiscard]] bool HasTimestamp() const {
+    return (flags & kFlagTimestamp) != 0;
+  }
+
+  /// @brief 受信時刻を記録する
+  void SetTimestamp(HighResClockDuration now) {
+    timestamp = static_cast<uint16_t>(now.count());
+    flags |= kFlagTimestamp;
+  }
+
+  /// @brief 受信時刻 (now から 65 秒以内に受信したものとして戻す)
+  [[nodiscard]] HighResClockDuration Timestamp(HighResClockDuration now) const {
+    auto const age = static_cast<uint16_t>(now.count() - timestamp);
+    return now - HighResClockDuration(age);
+  }
+
+  /// @brief len に対応する DLC
+  [[nodiscard]] uint8_t Dlc() const { return LengthToDlc(len); }
+
+  /// @brief src から size バイトをペイロードにコピーする
+  void CopyPayloadFrom(void const* src, size_t size = kPayloadSize) {
+    std::memcpy(data, src, size);
+  }
+
+  /// @brief ペイロードの先頭 size バイトを dst にコピーする
+  void CopyPayloadTo(void* dst, size_t size = kPayloadSize) const {
+    std::memcpy(dst, data, size);
+  }
+
+ private:
+  void SetFlag(uint8_t flag, bool on) {
+    flags = static_cast<uint8_t>(on ? flags | flag : flags & ~flag);
+  }
+};
+static_assert(sizeof(CANMessage) == 8 + CANMessage::kPayloadSize);
+static_assert(alignof(CANMessage) == 8);
+
+/// @brief 受信したフレームに受信時刻を付ける (受信割り込みの中で呼ぶ)
+/// @details
+///   - Config::Clock (HighResClockLike) があればそれを、無ければ
+///     バックエンドの Clock を使う
+///   - ハードウェアで付けた時刻 (HasTimestamp) は上書きしない
+template <typename Config, HighResClockLike Clock>
+void StampReceived(CANMessage& msg) {
+  if (msg.HasTimestamp()) {
+    return;
+  }
+  if constexpr (requires { typename Config::Clock; }) {
+    msg.SetTimestamp(Config::Clock::Now());
+  } else {
+    msg.SetTimestamp(Clock::Now());
+  }
+}
+
+}  // namespace nano_hw::can
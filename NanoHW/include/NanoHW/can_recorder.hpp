@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <Nano/mpmc_queue.hpp>
+
+#include "can_message.hpp"
+#include "high_res_clock.hpp"
+#include "policies.hpp"
+
+namespace nano_hw::can {
+
+/// @brief 記録されたフレーム 1 つ (ログファイルにもこのまま書く)
+/// @details classic では 20 バイト、NANO_HW_CAN_FD では 76 バイト
+struct CANRecord {
+  enum Direction : uint8_t { kRx = 0, kTx = 1 };
+
+  /// 記録時刻 (HighResClock の ms、約 49 日で一周)
+  uint32_t time_ms = 0;
+  uint32_t id = 0;
+  uint8_t bus = 0;
+  uint8_t direction = kRx;
+  /// CANMessage::flags (フォーマット / RTR / FD など)
+  uint8_t flags = 0;
+  uint8_t len = 0;
+  uint8_t data[kCANMaxPayload] = {};  // NOLINT
+
+  static CANRecord From(uint32_t time_ms, uint8_t bus, Direction direction,
+                        CANMessage const& msg) {
+    CANRecord record;
+    record.time_ms = time_ms;
+    record.id = msg.id;
+    record.bus = bus;
+    record.direction = direction;
+    record.flags = msg.flags;
+    record.len = msg.len;
+    msg.CopyPayloadTo(record.data);
+    return record;
+  }
+
+  /// @brief 記録したフレームを CANMessage に戻す (受信時刻は付けない)
+  [[nodiscard]] CANMessage ToMessage() const {
+    CANMessage msg;
+    msg.id = id;
+    msg.len = len;
+    msg.flags = static_cast<uint8_t>(flags & ~CANMessage::kFlagTimestamp);
+    msg.CopyPayloadFrom(data);
+    return msg;
+  }
+};
+static_assert(sizeof(CANRecord) == 12 + kCANMaxPayload);
+
+/// @brief 送受信フレームをロックフリーのリングに積むレコーダ
+/// @details
+///   - RecordRx / RecordTx は ISR から呼べる (TryPush のみ)
+///   - リングが満杯なら記録を捨てて dropped を数える
+///   - 書き出しはスレッドから Drain で行う (ファイルなどはシンク側の責任)
+///   - RxHook / TxHook は OnCANReceived / OnCANTransmit ポリシーとして
+///     そのまま使える (context には CANRecorder* を渡す)
+/// @tparam Clock 記録時刻に使う HighResClockLike なクロック
+/// @tparam kCapacity リングの容量 (2 のべき乗)
+template <HighResClockLike Clock, size_t kCapacity = 256>
+class CANRecorder {
+ public:
+  explicit CANRecorder(uint8_t bus = 0) : bus_(bus) {}
+
+  bool RecordRx(CANMessage const& msg) {
+    return Record(CANRecord::kRx, msg);
+  }
+  bool RecordTx(CANMessage const& msg) {
+    return Record(CANRecord::kTx, msg);
+  }
+
+  static void OnCANReceived(void* context, CANMessage msg) {
+    static_cast<CANRecorder*>(context)->RecordRx(msg);
+  }
+  static void OnCANTransmit(void* context, CANMessage msg) {
+    static_cast<CANRecorder*>(context)->RecordTx(msg);
+  }
+  using RxHook = nano_hw::Direct<&CANRecorder::OnCANReceived>;
+  using TxHook = nano_hw::Direct<&CANRecorder::OnCANTransmit>;
+
+  /// @brief 溜まっている記録を sink(CANRecord const&) に渡す
+  /// @return 渡した件数
+  template <typename Sink>
+  size_t Drain(Sink&& sink) {
+    size_t count = 0;
+    CANRecord record;
+    while (ring_.TryPop(record)) {
+      sink(record);
+      count++;
+    }
+    return count;
+  }
+
+  /// @brief リングが満杯で捨てた記録の数
+  [[nodiscard]] uint32_t Dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  bool Record(CANRecord::Direction direction, CANMessage const& msg) {
+    // 受信時刻が付いていればそれを使う (キューでの待ちを含めない)
+    auto const now = Clock::Now();
+    auto const time = msg.HasTimestamp() ? msg.Timestamp(now) : now;
+    auto const record = CANRecord::From(static_cast<uint32_t>(time.count()),
+                                        bus_, direction, msg);
+    if (!ring_.TryPush(record)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    return true;
+  }
+
+  uint8_t bus_;
+  std::atomic<uint32_t> dropped_{0};
+  Nano::collection::MpmcQueue<CANRecord, kCapacity, false> ring_;
+};
+
+}  // namespace nano_hw::can
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "can_message.hpp"
+#include "high_res_clock.hpp"
+
+namespace nano_hw::can {
+
+/// @brief フレームがバスを占有するビット数 (スタッフィングは最悪ケース)
+/// @details
+///   - classic: Davis らの式 (g + 8n + 13 + floor((g + 8n - 1) / 4))
+///   - FD: アービトレーション + ACK/EOF/IFS は nominal、
+///     ESI からの CRC までは data_bits に分けて返す
+struct FrameBits {
+  uint32_t nominal_bits;
+  uint32_t data_bits;
+};
+
+inline FrameBits EstimateFrameBits(CANMessage const& msg) {
+  bool const extended = msg.Format() == CANMessageFormat::kExtended;
+  uint32_t const payload = msg.IsRemote() ? 0 : 8U * msg.len;
+
+  if (!msg.IsFD()) {
+    uint32_t const g = extended ? 54 : 34;
+    return {g + payload + 13 + (g + payload - 1) / 4, 0};
+  }
+
+  // SOF から BRS まで + CRC デリミタ / ACK / EOF / IFS
+  uint32_t const arbitration = extended ? 36 : 17;
+  uint32_t const nominal = arbitration + (arbitration - 1) / 4 + 13;
+
+  // ESI + DLC + データ (動的スタッフ)、スタッフカウント + CRC (固定スタッフ)
+  uint32_t data = 5 + payload;
+  data += (data - 1) / 4;
+  uint32_t const crc = 4 + (msg.len <= 16 ? 17 : 21);
+  data += crc + (crc + 3) / 4;
+  return {nominal, data};
+}
+
+/// @brief CANStats の値を一度に読み出したもの
+/// @details 2 回の Snapshot の差からフレームレートとバス負荷を求める。
+///          カウンタは 32 bit で一周するので差分で使う
+struct CANStatsSnapshot {
+  static constexpr size_t kIdSlots = 32;
+  /// 0, 1, 2-3, 4-7, ..., 64 ms 以上。HighResClockDuration (ms) で測るので
+  /// 1 ms 未満の遅れはすべて先頭 (0 ms) に入る
+  static constexpr size_t kBuckets = 8;
+  static constexpr uint32_t kNoKey = 0xFFFFFFFF;
+
+  struct IdCount {
+    uint32_t key = kNoKey;  ///< id (拡張 ID は bit 31 を立てる)
+    uint32_t frames = 0;
+  };
+
+  HighResClockDuration time{};
+
+  uint32_t tx_frames = 0;
+  uint32_t rx_frames = 0;
+  uint32_t tx_failed = 0;
+  uint32_t bus_errors = 0;
+  uint32_t passive_errors = 0;
+  /// 送受信したフレームがバスを占有した時間 [us]
+  uint32_t busy_us = 0;
+
+  /// Snapshot 時にサンプリングした TEC / REC と、これまでの最大値
+  int transmit_errors = 0;
+  int receive_errors = 0;
+  int max_transmit_errors = 0;
+  int max_receive_errors = 0;
+
+  IdCount ids[kIdSlots] = {};  // NOLINT
+  /// テーブルに入りきらなかった ID のフレーム数
+  uint32_t other_frames = 0;
+
+  /// SendMessage の呼び出しからコントローラに渡るまで
+  /// (ms 単位。1 ms 以上待たされたフレームを見つけるためのもの)
+  uint32_t tx_wait[kBuckets] = {};  // NOLINT
+  /// 受信時刻 (CANMessage::Timestamp) からハンドラに渡るまで (同上)
+  uint32_t rx_latency[kBuckets] = {};  // NOLINT
+
+  static constexpr uint32_t Key(uint32_t id, CANMessageFormat format) {
+    return format == CANMessageFormat::kExtended ? id | 0x80000000U : id;
+  }
+
+  /// @brief prev からのバス負荷 (0.0 - 1.0)
+  [[nodiscard]] float BusLoad(CANStatsSnapshot const& prev) const {
+    auto const elapsed_us = static_cast<float>((time - prev.time).count()) *
+                            1000.0F;
+    if (elapsed_us <= 0.0F) {
+      return 0.0F;
+    }
+    return static_cast<float>(busy_us - prev.busy_us) / elapsed_us;
+  }
+
+  /// @brief prev からの id のフレームレート [frames/s]
+  [[nodiscard]] float FramesPerSecond(
+      CANStatsSnapshot const& prev, uint32_t id,
+      CANMessageFormat format = CANMessageFormat::kStandard) const {
+    auto const elapsed_ms = static_cast<float>((time - prev.time).count());
+    if (elapsed_ms <= 0.0F) {
+      return 0.0F;
+    }
+    auto const key = Key(id, format);
+    return static_cast<float>(FramesOf(key) - prev.FramesOf(key)) * 1000.0F /
+           elapsed_ms;
+  }
+
+  [[nodiscard]] uint32_t FramesOf(uint32_t key) const {
+    for (auto const& slot : ids) {
+      if (slot.key == key) {
+        return slot.frames;
+      }
+    }
+    return 0;
+  }
+};
+
+/// @brief 統計を取らない CANImpl の既定値 (すべて空の関数)
+struct NoCANStats {
+  static HighResClockDuration Now() { return {}; }
+
+  void SetBitrate(int /*nominal*/, int /*data*/ = 0) {}
+  void OnTransmit(CANMessage const& /*msg*/, HighResClockDuration /*start*/) {}
+  void OnTransmitFailed() {}
+  void OnReceive(CANMessage const& /*msg*/) {}
+  void OnBusError() {}
+  void OnPassiveError() {}
+  void SampleErrors(int /*transmit*/, int /*receive*/) {}
+
+  [[nodiscard]] bool Snapshot(CANStatsSnapshot& /*out*/) const {
+    return false;
+  }
+};
+
+/// @brief CAN インスタンスごとの送受信統計
+/// @details
+///   - 固定長のテーブルとヒストグラムのみ (動的確保なし)
+///   - 記録は relaxed なアトミック加算のみで、ISR からも呼べる
+///   - ID ごとのカウンタは最初に見た kIdSlots 個の ID に割り当てる
+///   - 時間の分解能は Clock (HighResClock) に従い 1 ms。tx_wait /
+///     rx_latency のヒストグラムは 1 ms 以上の遅れだけを区別し、通常の
+///     ISR からハンドラまでのような 1 ms 未満の遅れはすべて bucket 0 に
+///     入る (us 単位の分布は取れない)
+/// @tparam Clock HighResClockLike なクロック
+template <HighResClockLike Clock>
+class CANStats {
+  using Counter = std::atomic<uint32_t>;
+
+ public:
+  static HighResClockDuration Now() { return Clock::Now(); }
+
+  CANStats() {
+    for (auto& key : keys_) {
+      key.store(CANStatsSnapshot::kNoKey, std::memory_order_relaxed);
+    }
+  }
+
+  /// @brief ビットレートを設定する (data が 0 なら nominal と同じ)
+  void SetBitrate(int nominal, int data = 0) {
+    auto const ns = [](int bitrate) {
+      return bitrate > 0 ? static_cast<uint32_t>(1000000000 / bitrate) : 0U;
+    };
+    nominal_bit_ns_.store(ns(nominal), std::memory_order_relaxed);
+    data_bit_ns_.store(ns(data > 0 ? data : nominal),
+                       std::memory_order_relaxed);
+  }
+
+  /// @brief 送信できたフレームを記録する
+  /// @param start SendMessage を呼んだ時刻 (Now())
+  void OnTransmit(CANMessage const& msg, HighResClockDuration start) {
+    tx_frames_.fetch_add(1, std::memory_order_relaxed);
+    CountFrame(msg);
+    tx_wait_[Bucket(Now() - start)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void OnTransmitFailed() {
+    tx_failed_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// @brief ハンドラに渡すフレームを記録する
+  void OnReceive(CANMessage const& msg) {
+    rx_frames_.fetch_add(1, std::memory_order_relaxed);
+    CountFrame(msg);
+    if (msg.HasTimestamp()) {
+      auto const now = Now();
+      rx_latency_[Bucket(now - msg.Timestamp(now))].fetch_add(
+          1, std::memory_order_relaxed);
+    }
+  }
+
+  void OnBusError() { bus_errors_.fetch_add(1, std::memory_order_relaxed); }
+  void OnPassiveError() {
+    passive_errors_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// @brief エラーカウンタ (TEC / REC) をサンプリングする
+  void SampleErrors(int transmit, int receive) {
+    transmit_errors_.store(transmit, std::memory_order_relaxed);
+    receive_errors_.store(receive, std::memory_order_relaxed);
+    StoreMax(max_transmit_errors_, transmit);
+    StoreMax(max_receive_errors_, receive);
+  }
+
+  /// @brief 現在の値を out に読み出す
+  /// @note 各カウンタは個別に読むので、記録中の値とは厳密には揃わない
+  bool Snapshot(CANStatsSnapshot& out) const {
+    constexpr auto kRelaxed = std::memory_order_relaxed;
+
+    out.time = Now();
+    out.tx_frames = tx_frames_.load(kRelaxed);
+    out.rx_frames = rx_frames_.load(kRelaxed);
+    out.tx_failed = tx_failed_.load(kRelaxed);
+    out.bus_errors = bus_errors_.load(kRelaxed);
+    out.passive_errors = passive_errors_.load(kRelaxed);
+    out.busy_us = busy_us_.load(kRelaxed);
+    out.transmit_errors = transmit_errors_.load(kRelaxed);
+    out.receive_errors = receive_errors_.load(kRelaxed);
+    out.max_transmit_errors = max_transmit_errors_.load(kRelaxed);
+    out.max_receive_errors = max_receive_errors_.load(kRelaxed);
+    for (size_t i = 0; i < CANStatsSnapshot::kIdSlots; i++) {
+      out.ids[i] = {keys_[i].load(kRelaxed), frames_[i].load(kRelaxed)};
+    }
+    out.other_frames = other_frames_.load(kRelaxed);
+    for (size_t i = 0; i < CANStatsSnapshot::kBuckets; i++) {
+      out.tx_wait[i] = tx_wait_[i].load(kRelaxed);
+      out.rx_latency[i] = rx_latency_[i].load(kRelaxed);
+    }
+    return true;
+  }
+
+ private:
+  static size_t Bucket(HighResClockDuration duration) {
+    auto const ms = duration.count() > 0
+                        ? static_cast<uint32_t>(duration.count())
+                        : 0U;
+    auto const bucket = static_cast<size_t>(std::bit_width(ms));
+    return bucket < CANStatsSnapshot::kBuckets ? bucket
+                                               : CANStatsSnapshot::kBuckets - 1;
+  }
+
+  static void StoreMax(std::atomic<int>& max, int value) {
+    int current = max.load(std::memory_order_relaxed);
+    while (value > current &&
+           !max.compare_exchange_weak(current, value,
+                                      std::memory_order_relaxed)) {
+    }
+  }
+
+  void CountFrame(CANMessage const& msg) {
+    auto const bits = EstimateFrameBits(msg);
+    auto const ns =
+        bits.nominal_bits * nominal_bit_ns_.load(std::memory_order_relaxed) +
+        bits.data_bits * data_bit_ns_.load(std::memory_order_relaxed);
+    busy_us_.fetch_add((ns + 500) / 1000, std::memory_order_relaxed);
+
+    // ID ごとのカウンタ: ハッシュから線形探索し、空きスロットを CAS で取る
+    auto const key = CANStatsSnapshot::Key(msg.id, msg.Format());
+    auto index = static_cast<size_t>((key * 2654435761U) >> 27U);
+    for (size_t probe = 0; probe < CANStatsSnapshot::kIdSlots; probe++) {
+      auto& slot = keys_[index];
+      auto current = slot.load(std::memory_order_relaxed);
+      if (current == CANStatsSnapshot::kNoKey &&
+          slot.compare_exchange_strong(current, key,
+                                       std::memory_order_relaxed)) {
+        current = key;
+      }
+      if (current == key) {
+        frames_[index].fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      index = (index + 1) % CANStatsSnapshot::kIdSlots;
+    }
+    other_frames_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static_assert(CANStatsSnapshot::kIdSlots == 32,
+                "hash uses the top 5 bits");
+
+  std::atomic<uint32_t> nominal_bit_ns_{0};
+  std::atomic<uint32_t> data_bit_ns_{0};
+
+  Counter tx_frames_{0};
+  Counter rx_frames_{0};
+  Counter tx_failed_{0};
+  Counter bus_errors_{0};
+  Counter passive_errors_{0};
+  Counter busy_us_{0};
+
+  std::atomic<int> transmit_errors_{0};
+  std::atomic<int> receive_errors_{0};
+  std::atomic<int> max_transmit_errors_{0};
+  std::atomic<int> max_receive_errors_{0};
+
+  std::atomic<uint32_t> keys_[CANStatsSnapshot::kIdSlots];  // NOLINT
+  Counter frames_[CANStatsSnapshot::kIdSlots] = {};         // NOLINT
+  Counter other_frames_{0};
+
+  Counter tx_wait_[CANStatsSnapshot::kBuckets] = {};     // NOLINT
+  Counter rx_latency_[CANStatsSnapshot::kBuckets] = {};  // NOLINT
+};
+
+}  // namespace nano_hw::can
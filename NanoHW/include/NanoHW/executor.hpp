@@ -0,0 +1,301 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <Nano/mpmc_queue.hpp>
+
+#include "parallel.hpp"
+#include "thread.hpp"
+
+namespace nano_hw::executor {
+
+/// @brief Executor に投入するタスク (ヒープ確保なし)
+struct Task {
+  void (*fn)(void*) = nullptr;
+  void* ctx = nullptr;
+
+  void operator()() const { fn(ctx); }
+  explicit operator bool() const { return fn != nullptr; }
+};
+
+using Nano::collection::kCacheLineSize;
+
+/// @brief 固定長の Chase-Lev work-stealing deque
+/// @details
+///   - Push / Take は所有ワーカーのみ (LIFO)
+///   - Steal は任意のスレッドから (FIFO)
+/// @tparam N 容量 (2 のべき乗)
+template <size_t N>
+class WorkStealingDeque {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+ public:
+  /// @brief 末尾に積む (所有ワーカーのみ)
+  /// @return 満杯なら false
+  bool Push(Task task) {
+    auto const b = bottom_.load(std::memory_order_relaxed);
+    auto const t = top_.load(std::memory_order_acquire);
+    if (b - t >= static_cast<int64_t>(N)) {
+      return false;
+    }
+
+    auto& slot = slots_[b & kMask];
+    slot.fn.store(task.fn, std::memory_order_relaxed);
+    slot.ctx.store(task.ctx, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// @brief 末尾から取り出す (所有ワーカーのみ)
+  std::optional<Task> Take() {
+    auto const b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top_.load(std::memory_order_relaxed);
+
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+
+    auto const task = Load(b);
+    if (t == b) {
+      // 最後の 1 つは Steal と競合する
+      bool const won = top_.compare_exchange_strong(
+          t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      if (!won) {
+        return std::nullopt;
+      }
+    }
+    return task;
+  }
+
+  /// @brief 先頭から奪う (任意のスレッド)
+  /// @note 競合に負けた場合も std::nullopt
+  std::optional<Task> Steal() {
+    auto t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto const b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {
+      return std::nullopt;
+    }
+
+    auto const task = Load(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+    return task;
+  }
+
+  [[nodiscard]] size_t Size() const {
+    auto const b = bottom_.load(std::memory_order_relaxed);
+    auto const t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_t>(b - t) : 0;
+  }
+
+  [[nodiscard]] bool Empty() const { return Size() == 0; }
+
+  static constexpr size_t Capacity() { return N; }
+
+ private:
+  static constexpr int64_t kMask = static_cast<int64_t>(N) - 1;
+
+  struct Slot {
+    std::atomic<void (*)(void*)> fn{nullptr};
+    std::atomic<void*> ctx{nullptr};
+  };
+
+  Task Load(int64_t index) const {
+    auto const& slot = slots_[index & kMask];
+    return Task{slot.fn.load(std::memory_order_relaxed),
+                slot.ctx.load(std::memory_order_relaxed)};
+  }
+
+  alignas(kCacheLineSize) std::atomic<int64_t> top_{0};
+  alignas(kCacheLineSize) std::atomic<int64_t> bottom_{0};
+  std::array<Slot, N> slots_{};
+};
+
+/// @brief Thread concept 上の固定サイズ work-stealing executor
+/// @details
+///   - Submit されたタスクは MPMC キューに入り、ワーカーが自分の deque
+///     にまとめて取り込む
+///   - 手の空いたワーカーは他ワーカーの deque から Steal する
+///   - タスクは関数ポインタ + コンテキストで保持し、ヒープ確保を行わない
+/// @tparam ThreadT Thread concept を満たすスレッド実装
+/// @tparam kWorkers ワーカー数
+/// @tparam kDequeCapacity ワーカーごとの deque 容量 (2 のべき乗)
+/// @tparam kInjectorCapacity Submit 用キューの容量 (2 のべき乗)
+template <thread::Thread ThreadT, size_t kWorkers,
+          size_t kDequeCapacity = 64, size_t kInjectorCapacity = 256>
+class Executor {
+  static_assert(kWorkers > 0, "Executor needs at least one worker");
+
+ public:
+  explicit Executor(ThreadPriority priority = ThreadPriorityNormal,
+                    uint32_t stack_size = 4096,
+                    const char* name = "executor")
+      : priority_(priority), stack_size_(stack_size), name_(name) {}
+
+  Executor(Executor const&) = delete;
+  Executor& operator=(Executor const&) = delete;
+
+  ~Executor() { Stop(); }
+
+  /// @brief ワーカースレッドを起動する
+  void Start() {
+    if (running_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+
+    for (size_t i = 0; i < kWorkers; i++) {
+      auto& worker = workers_[i];
+      worker.thread.emplace(priority_, stack_size_, nullptr, name_);
+      worker.thread->Start([this, i]() { WorkerLoop(i); });
+    }
+  }
+
+  /// @brief 投入済みのタスクを全て実行してからワーカーを止める
+  void Stop() {
+    if (!running_.load(std::memory_order_acquire)) {
+      return;
+    }
+
+    WaitIdle();
+    running_.store(false, std::memory_order_release);
+    for (auto& worker : workers_) {
+      if (worker.thread) {
+        worker.thread->Join();
+        worker.thread.reset();
+      }
+    }
+  }
+
+  /// @brief タスクを投入する (任意のスレッド / タスク内から呼べる)
+  /// @return キューが満杯なら false
+  bool Submit(Task task) {
+    if (!task) {
+      return false;
+    }
+
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    if (!injector_.TryPush(task)) {
+      pending_.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+    return true;
+  }
+
+  bool Submit(void (*fn)(void*), void* ctx) { return Submit(Task{fn, ctx}); }
+
+  /// @brief 投入済みタスクが全て完了するまで待つ
+  void WaitIdle() const {
+    while (pending_.load(std::memory_order_acquire) != 0) {
+      parallel::SleepForMS(std::chrono::milliseconds(1));
+    }
+  }
+
+  /// @brief 未完了のタスク数
+  [[nodiscard]] size_t Pending() const {
+    return pending_.load(std::memory_order_relaxed);
+  }
+
+  /// @brief ワーカー index が実行したタスク数
+  [[nodiscard]] size_t Executed(size_t index) const {
+    return workers_[index].executed.load(std::memory_order_relaxed);
+  }
+
+  /// @brief ワーカー index が他ワーカーから奪ったタスク数
+  [[nodiscard]] size_t Stolen(size_t index) const {
+    return workers_[index].stolen.load(std::memory_order_relaxed);
+  }
+
+  static constexpr size_t Workers() { return kWorkers; }
+
+ private:
+  /// Injector から 1 回で取り込む最大数 (残りは他ワーカーに残す)
+  static constexpr size_t kBatchSize =
+      kDequeCapacity / 2 < 16 ? kDequeCapacity / 2 : 16;
+  /// Sleep に入るまでの空振り回数
+  static constexpr int kSpinsBeforeSleep = 64;
+
+  struct alignas(kCacheLineSize) Worker {
+    WorkStealingDeque<kDequeCapacity> deque;
+    std::optional<ThreadT> thread;
+    std::atomic<size_t> executed{0};
+    std::atomic<size_t> stolen{0};
+  };
+
+  std::optional<Task> FindTask(size_t index) {
+    auto& self = workers_[index];
+
+    if (auto task = self.deque.Take()) {
+      return task;
+    }
+
+    // Injector から 1 つ取り、残りを自分の deque に積んで他に分ける
+    if (Task task; injector_.TryPop(task)) {
+      Task extra;
+      for (size_t i = 1; i < kBatchSize && injector_.TryPop(extra); i++) {
+        if (!self.deque.Push(extra)) {
+          Run(index, extra);
+          break;
+        }
+      }
+      return task;
+    }
+
+    for (size_t i = 1; i < kWorkers; i++) {
+      auto& victim = workers_[(index + i) % kWorkers];
+      if (auto task = victim.deque.Steal()) {
+        self.stolen.fetch_add(1, std::memory_order_relaxed);
+        return task;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  void Run(size_t index, Task task) {
+    task();
+    workers_[index].executed.fetch_add(1, std::memory_order_relaxed);
+    pending_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  void WorkerLoop(size_t index) {
+    int idle = 0;
+    while (running_.load(std::memory_order_acquire)) {
+      if (auto task = FindTask(index)) {
+        Run(index, *task);
+        idle = 0;
+        continue;
+      }
+
+      if (++idle < kSpinsBeforeSleep) {
+        continue;
+      }
+      parallel::SleepForMS(std::chrono::milliseconds(1));
+    }
+  }
+
+  ThreadPriority priority_;
+  uint32_t stack_size_;
+  const char* name_;
+
+  std::array<Worker, kWorkers> workers_;
+  /// Submit 用の投入口 (任意のスレッドから Push、ワーカーが Pop)。
+  /// スロットごとにキャッシュラインを使うと RAM が数倍になるので詰めて置く
+  Nano::collection::MpmcQueue<Task, kInjectorCapacity, false> injector_;
+  alignas(kCacheLineSize) std::atomic<size_t> pending_{0};
+  std::atomic<bool> running_{false};
+};
+
+}  // namespace nano_hw::executor
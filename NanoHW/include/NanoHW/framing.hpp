@@ -0,0 +1,337 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#include <Nano/crc.hpp>
+#include <Nano/span.hpp>
+
+#include "policies.hpp"
+
+namespace nano_hw::uart::framing {
+
+using Nano::collection::Span;
+
+/// @brief CRC-16/CCITT-FALSE (多項式 0x1021、初期値 0xFFFF)
+/// @details 末尾に CRC をビッグエンディアンで付けた列の CRC は 0 になる
+constexpr uint16_t Crc16(Span<uint8_t const> data) {
+  return Nano::utils::Crc16Ccitt::Compute(data);
+}
+
+/// @brief 受信したフレームを受け取るポリシー
+template <typename T>
+concept FramingConfig = Policy<typename T::OnFrame, void*, Span<uint8_t const>>;
+
+/// @brief デコーダ 1 バイト分の結果
+enum class Step : uint8_t {
+  kNone,    ///< 出力なし (エスケープ、コードバイトなど)
+  kData,    ///< out に 1 バイト出力した
+  kEnd,     ///< フレームの区切り
+  kBadEnd,  ///< 区切りだがフレームが壊れている
+  kError,   ///< フレームの途中で不正なバイト (次の区切りまで捨てる)
+};
+
+/// @brief COBS (区切りは 0x00)
+struct Cobs {
+  /// n バイトを符号化したときの最大長 (区切りを含む)
+  static constexpr size_t MaxEncodedSize(size_t n) { return n + n / 254 + 2; }
+
+  /// @brief out に直接書き込むエンコーダ
+  class Writer {
+   public:
+    explicit constexpr Writer(Span<uint8_t> out) : out_(out) {}
+
+    constexpr void Put(uint8_t byte) {
+      if (byte == 0) {
+        CloseBlock();
+        return;
+      }
+      Write(pos_++, byte);
+      if (++code_ == 0xFF) {
+        CloseBlock();
+      }
+    }
+
+    /// @return 書いたバイト数 (out に収まらなければ 0)
+    constexpr size_t Finish() {
+      Write(code_pos_, code_);
+      Write(pos_++, 0);
+      return overflow_ ? 0 : pos_;
+    }
+
+   private:
+    constexpr void CloseBlock() {
+      Write(code_pos_, code_);
+      code_pos_ = pos_++;
+      code_ = 1;
+    }
+
+    constexpr void Write(size_t index, uint8_t byte) {
+      if (index < out_.size()) {
+        out_[index] = byte;
+      } else {
+        overflow_ = true;
+      }
+    }
+
+    Span<uint8_t> out_;
+    size_t code_pos_ = 0;
+    size_t pos_ = 1;
+    uint8_t code_ = 1;
+    bool overflow_ = false;
+  };
+
+  /// @brief 1 バイトずつ復号するデコーダ
+  /// @details 入力 1 バイトにつき出力は高々 1 バイトなので、
+  ///          受け取ったバイトをそのままフレームバッファに展開できる
+  class Reader {
+   public:
+    constexpr Step Put(uint8_t in, uint8_t& out) {
+      if (in == 0) {
+        bool const ok = remaining_ == 0;
+        *this = Reader{};
+        return ok ? Step::kEnd : Step::kBadEnd;
+      }
+      if (remaining_ == 0) {
+        // コードバイト: 直前のブロックが 0xFF でなければ 0 が省かれている
+        bool const zero = started_ && code_ != 0xFF;
+        started_ = true;
+        code_ = in;
+        remaining_ = static_cast<uint8_t>(in - 1);
+        if (zero) {
+          out = 0;
+          return Step::kData;
+        }
+        return Step::kNone;
+      }
+      remaining_--;
+      out = in;
+      return Step::kData;
+    }
+
+   private:
+    uint8_t code_ = 0;
+    uint8_t remaining_ = 0;
+    bool started_ = false;
+  };
+};
+
+/// @brief SLIP (RFC 1055、区切りは 0xC0)
+struct Slip {
+  static constexpr uint8_t kEnd = 0xC0;
+  static constexpr uint8_t kEsc = 0xDB;
+  static constexpr uint8_t kEscEnd = 0xDC;
+  static constexpr uint8_t kEscEsc = 0xDD;
+
+  /// n バイトを符号化したときの最大長 (前後の区切りを含む)
+  static constexpr size_t MaxEncodedSize(size_t n) { return 2 * n + 2; }
+
+  class Writer {
+   public:
+    /// 先頭にも区切りを置き、回線上のノイズを前のフレームとして切り捨てる
+    explicit constexpr Writer(Span<uint8_t> out) : out_(out) { Write(kEnd); }
+
+    constexpr void Put(uint8_t byte) {
+      if (byte == kEnd) {
+        Write(kEsc);
+        Write(kEscEnd);
+      } else if (byte == kEsc) {
+        Write(kEsc);
+        Write(kEscEsc);
+      } else {
+        Write(byte);
+      }
+    }
+
+    constexpr size_t Finish() {
+      Write(kEnd);
+      return overflow_ ? 0 : pos_;
+    }
+
+   private:
+    constexpr void Write(uint8_t byte) {
+      if (pos_ < out_.size()) {
+        out_[pos_++] = byte;
+      } else {
+        overflow_ = true;
+      }
+    }
+
+    Span<uint8_t> out_;
+    size_t pos_ = 0;
+    bool overflow_ = false;
+  };
+
+  class Reader {
+   public:
+    constexpr Step Put(uint8_t in, uint8_t& out) {
+      if (in == kEnd) {
+        bool const ok = !escaped_;
+        escaped_ = false;
+        return ok ? Step::kEnd : Step::kBadEnd;
+      }
+      if (escaped_) {
+        escaped_ = false;
+        if (in == kEscEnd) {
+          out = kEnd;
+        } else if (in == kEscEsc) {
+          out = kEsc;
+        } else {
+          return Step::kError;
+        }
+        return Step::kData;
+      }
+      if (in == kEsc) {
+        escaped_ = true;
+        return Step::kNone;
+      }
+      out = in;
+      return Step::kData;
+    }
+
+   private:
+    bool escaped_ = false;
+  };
+};
+
+template <typename T>
+concept Codec = requires(size_t size) {
+  typename T::Writer;
+  typename T::Reader;
+  {T::MaxEncodedSize(size)}->std::same_as<size_t>;
+};
+
+/// @brief payload + CRC を符号化したときの最大長
+template <Codec C>
+constexpr size_t MaxFrameSize(size_t payload) {
+  return C::MaxEncodedSize(payload + 2);
+}
+
+/// @brief payload に CRC を付けて out に符号化する
+/// @return 書いたバイト数 (out に収まらなければ 0)
+template <Codec C>
+constexpr size_t EncodeFrame(Span<uint8_t const> payload, Span<uint8_t> out) {
+  typename C::Writer writer(out);
+  for (auto byte : payload) {
+    writer.Put(byte);
+  }
+  auto const crc = Crc16(payload);
+  writer.Put(static_cast<uint8_t>(crc >> 8U));
+  writer.Put(static_cast<uint8_t>(crc));
+  return writer.Finish();
+}
+
+struct FrameStats {
+  uint32_t frames = 0;      ///< 正しく受け取ったフレーム
+  uint32_t bad_frames = 0;  ///< 符号化が壊れている / CRC より短い
+  uint32_t crc_errors = 0;  ///< CRC が合わない
+  uint32_t overflows = 0;   ///< kMaxPayload を超えた
+  uint32_t resyncs = 0;     ///< 次の区切りまで読み捨てた回数
+};
+
+/// @brief UART から届いたバイト列をフレームに切り出す
+/// @details
+///   - Feed で受け取ったバイトを復号しながらフレームバッファに書くので、
+///     コピーは UART のチャンクからの 1 回だけ
+///   - 末尾 2 バイトの CRC-16 を検査し、ペイロードだけを
+///     Config::OnFrame に Span で渡す (Span は OnFrame の中でのみ有効)
+///   - 壊れたフレームは捨て、次の区切りから読み直す
+///   - RxHook は OnUARTRx ポリシーとしてそのまま使える
+///     (context には FrameDecoder* を渡す)
+/// @tparam C Cobs または Slip
+/// @tparam Config OnFrame を持つ FramingConfig
+/// @tparam kMaxPayload 1 フレームのペイロードの最大長
+template <Codec C, FramingConfig Config, size_t kMaxPayload = 256>
+class FrameDecoder {
+ public:
+  explicit FrameDecoder(void* context = nullptr) : context_(context) {}
+
+  void Feed(uint8_t const* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      uint8_t out = 0;
+      switch (reader_.Put(data[i], out)) {
+        case Step::kNone:
+          break;
+        case Step::kData:
+          Append(out);
+          break;
+        case Step::kEnd:
+          Complete();
+          break;
+        case Step::kBadEnd:
+          if (!discarding_) {
+            stats_.bad_frames++;
+          }
+          Reset();
+          break;
+        case Step::kError:
+          if (!discarding_) {
+            stats_.bad_frames++;
+            Discard();
+          }
+          break;
+      }
+    }
+  }
+
+  static void OnUARTRx(void* context, uint8_t const* data, size_t size) {
+    static_cast<FrameDecoder*>(context)->Feed(data, size);
+  }
+  using RxHook = nano_hw::Direct<&FrameDecoder::OnUARTRx>;
+
+  [[nodiscard]] FrameStats const& Stats() const { return stats_; }
+
+ private:
+  static constexpr size_t kBufferSize = kMaxPayload + 2;
+
+  void Append(uint8_t byte) {
+    if (discarding_) {
+      return;
+    }
+    if (length_ == kBufferSize) {
+      stats_.overflows++;
+      Discard();
+      return;
+    }
+    buffer_[length_++] = byte;
+  }
+
+  void Complete() {
+    if (discarding_ || length_ == 0) {
+      // 読み捨ての終わり、または連続した区切り (アイドル)
+      Reset();
+      return;
+    }
+    if (length_ < 2) {
+      stats_.bad_frames++;
+    } else if (Crc16({buffer_.data(), length_}) != 0) {
+      stats_.crc_errors++;
+    } else {
+      stats_.frames++;
+      Config::OnFrame::execute(
+          context_, Span<uint8_t const>{buffer_.data(), length_ - 2});
+    }
+    Reset();
+  }
+
+  void Discard() {
+    stats_.resyncs++;
+    discarding_ = true;
+  }
+
+  void Reset() {
+    length_ = 0;
+    discarding_ = false;
+  }
+
+  void* context_;
+  typename C::Reader reader_;
+  size_t length_ = 0;
+  bool discarding_ = false;
+  FrameStats stats_;
+  std::array<uint8_t, kBufferSize> buffer_{};
+};
+
+}  // namespace nano_hw::uart::framing
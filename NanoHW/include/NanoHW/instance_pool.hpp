@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include <Nano/bitmap_pool.hpp>
+
+#ifndef NANO_HW_MAX_INSTANCES
+#define NANO_HW_MAX_INSTANCES 4
+#endif
+
+/// プールが尽きたときに呼ぶ処理 (戻ってはいけない)。
+/// 既定は trap で、ターゲット側でエラー表示などに差し替えられる
+#ifndef NANO_HW_POOL_EXHAUSTED
+#define NANO_HW_POOL_EXHAUSTED() __builtin_trap()
+#endif
+
+namespace nano_hw {
+
+/// 各 *Impl が同時に持てるインスタンス数の既定値
+/// (*Impl の kInstances でバックエンドごとに変えられる)
+inline constexpr size_t kMaxInstances = NANO_HW_MAX_INSTANCES;
+
+/// @brief dispatch 層 (*_impl.hpp) のインスタンスを置く静的プール
+/// @details
+///   - ヒープを使わず、空きスロットはビットマップの ctz で探す
+///   - 尽きたら nullptr を返さずに NANO_HW_POOL_EXHAUSTED() で止める
+///     (Dyn* は確保したインスタンスを確かめずに使うため)
+///   - ISR やスレッドから生成・破棄しても壊れないよう atomic 版を使う
+/// @tparam N スロット数 (N * sizeof(T) が .bss に置かれる)
+template <typename T, size_t N = kMaxInstances>
+class InstancePool {
+  static_assert(N > 0, "InstancePool needs at least one slot");
+
+ public:
+  template <typename... Args>
+  T* New(Args&&... args) {
+    auto* ptr = pool_.New(std::forward<Args>(args)...);
+    if (ptr == nullptr) {
+      NANO_HW_POOL_EXHAUSTED();
+    }
+    return ptr;
+  }
+
+  void Delete(T* ptr) { pool_.Delete(ptr); }
+
+  static constexpr size_t Capacity() { return N; }
+
+ private:
+  Nano::collection::AtomicBitmapPool<T, N> pool_;
+};
+
+}  // namespace nano_hw
@@ -0,0 +1,480 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <Nano/span.hpp>
+
+#include "can_message.hpp"
+#include "policies.hpp"
+
+namespace nano_hw::can::isotp {
+
+using Nano::collection::Span;
+using Microseconds = std::chrono::microseconds;
+
+/// @brief フレームを送れるドライバ (CAN concept を満たす型の実体など)
+template <typename T>
+concept FrameSender = requires(T& driver, CANMessage msg) {
+  {driver.SendMessage(msg)}->std::same_as<bool>;
+};
+
+/// @brief セッションのアドレス (normal addressing)
+struct Address {
+  uint32_t tx_id = 0;
+  uint32_t rx_id = 0;
+  CANMessageFormat format = CANMessageFormat::kStandard;
+};
+
+struct Options {
+  /// 受信側として FC で通知するブロックサイズ (0 なら無制限)
+  uint8_t block_size = 0;
+  /// 受信側として FC で通知する STmin (ISO 15765-2 の符号化のまま)
+  uint8_t st_min = 0;
+  /// 未使用バイトを埋める値
+  uint8_t padding = 0xCC;
+  /// FD フレームで送る (NANO_HW_CAN_FD のときのみ有効)
+  bool fd = false;
+  /// FC 待ち (N_Bs) / CF 待ち (N_Cr) のタイムアウト
+  Microseconds timeout = std::chrono::milliseconds(1000);
+};
+
+enum class Status : uint8_t {
+  kIdle,
+  kBusy,
+  kDone,
+  kTimeout,
+  kOverflow,
+  kError,
+};
+
+/// @brief STmin の符号化を時間に直す (予約値は 127 ms とみなす)
+constexpr Microseconds DecodeStMin(uint8_t st_min) {
+  if (st_min <= 0x7F) {
+    return std::chrono::milliseconds(st_min);
+  }
+  if (st_min >= 0xF1 && st_min <= 0xF9) {
+    return Microseconds((st_min - 0xF0) * 100);
+  }
+  return std::chrono::milliseconds(0x7F);
+}
+
+/// @brief ISO-TP (ISO 15765-2) のセグメント化 / 再構成
+/// @details
+///   - 送信は Span を指したまま CF ごとに切り出す (中間バッファなし)
+///   - 受信はセッションごとの固定長バッファに組み立てる
+///   - 受信フレームは OnReceived (または OnCANReceived フック) に渡し、
+///     CF の送信とタイムアウトは Poll で進める
+/// @note OnReceived と Poll は同じコンテキストから呼ぶこと
+///       (ISR で受ける場合は Queue などを挟む)
+/// @tparam Driver SendMessage(CANMessage) を持つ CAN ドライバ
+/// @tparam kSessions 同時に扱えるセッション数
+/// @tparam kBufferSize 1 セッションの受信バッファ長
+template <FrameSender Driver, size_t kSessions = 4, size_t kBufferSize = 256>
+class Transport {
+  static constexpr auto kUnset = Microseconds::max();
+
+  enum class Phase : uint8_t { kIdle, kWaitFC, kSendCF };
+
+  // PCI (先頭バイトの上位 4 ビット)
+  static constexpr uint8_t kSingle = 0x00;
+  static constexpr uint8_t kFirst = 0x10;
+  static constexpr uint8_t kConsecutive = 0x20;
+  static constexpr uint8_t kFlowControl = 0x30;
+
+  // FC の FlowStatus
+  static constexpr uint8_t kContinue = 0;
+  static constexpr uint8_t kWait = 1;
+  static constexpr uint8_t kOverflowStatus = 2;
+
+  struct Tx {
+    Span<const uint8_t> data;
+    size_t offset = 0;
+    uint8_t sn = 0;
+    uint8_t block_size = 0;
+    uint8_t block_left = 0;
+    Microseconds st_min{0};
+    Microseconds next{0};
+    Microseconds deadline = kUnset;
+    Phase phase = Phase::kIdle;
+    Status status = Status::kIdle;
+  };
+
+  struct Rx {
+    size_t size = 0;
+    size_t received = 0;
+    uint8_t sn = 0;
+    uint8_t block = 0;
+    bool activity = false;
+    Microseconds deadline = kUnset;
+    Status status = Status::kIdle;
+  };
+
+  struct Session {
+    Address address;
+    bool open = false;
+    Tx tx;
+    Rx rx;
+    std::array<uint8_t, kBufferSize> buffer;
+  };
+
+ public:
+  static constexpr size_t kNone = kSessions;
+
+  explicit Transport(Driver& driver, Options options = {})
+      : driver_(driver), options_(options) {}
+
+  Transport(Transport const&) = delete;
+  Transport& operator=(Transport const&) = delete;
+
+  /// @return セッション番号 (空きが無ければ kNone)
+  size_t Open(Address address) {
+    for (size_t i = 0; i < kSessions; i++) {
+      if (!sessions_[i].open) {
+        sessions_[i].address = address;
+        sessions_[i].open = true;
+        sessions_[i].tx = {};
+        sessions_[i].rx = {};
+        return i;
+      }
+    }
+    return kNone;
+  }
+
+  void Close(size_t session) { sessions_[session].open = false; }
+
+  /// @brief OnCANReceived ポリシー用のフック (context には Transport* を渡す)
+  static void OnCANReceived(void* context, CANMessage msg) {
+    static_cast<Transport*>(context)->OnReceived(msg);
+  }
+  using ReceiveHook = nano_hw::Direct<&Transport::OnCANReceived>;
+
+  /// @return いずれかのセッション宛てのフレームだったか
+  bool OnReceived(CANMessage const& msg) {
+    auto* session = Find(msg.id);
+    if (session == nullptr || msg.len == 0) {
+      return false;
+    }
+
+    switch (msg.data[0] & 0xF0) {
+      case kSingle:
+        ReceiveSingle(*session, msg);
+        break;
+      case kFirst:
+        ReceiveFirst(*session, msg);
+        break;
+      case kConsecutive:
+        ReceiveConsecutive(*session, msg);
+        break;
+      case kFlowControl:
+        ReceiveFlowControl(*session, msg);
+        break;
+      default:
+        break;
+    }
+    return true;
+  }
+
+  /// @brief data を送り始める (1 フレームに収まればその場で送り切る)
+  /// @note data は TxStatus が kBusy でなくなるまで保持すること
+  /// @return 送信中だった / 最初のフレームを送れなかった場合は false
+  bool Send(size_t session, Span<const uint8_t> data) {
+    auto& s = sessions_[session];
+    auto& tx = s.tx;
+    if (tx.status == Status::kBusy) {
+      return false;
+    }
+
+    auto const frame = FrameLength();
+    auto const size = data.size();
+    uint8_t head[6];
+    size_t head_len;
+
+    if (size <= 7 || (frame > 8 && size <= frame - 2)) {
+      if (size <= 7) {
+        head[0] = static_cast<uint8_t>(kSingle | size);
+        head_len = 1;
+      } else {
+        head[0] = kSingle;
+        head[1] = static_cast<uint8_t>(size);
+        head_len = 2;
+      }
+      auto const sent = SendFrame(s, head, head_len, data.data(), size);
+      tx.status = sent ? Status::kDone : Status::kIdle;
+      return sent;
+    }
+
+    if (size <= 0xFFF) {
+      head[0] = static_cast<uint8_t>(kFirst | (size >> 8));
+      head[1] = static_cast<uint8_t>(size);
+      head_len = 2;
+    } else {
+      head[0] = kFirst;
+      head[1] = 0;
+      for (size_t i = 0; i < 4; i++) {
+        head[2 + i] = static_cast<uint8_t>(size >> (8 * (3 - i)));
+      }
+      head_len = 6;
+    }
+
+    // FC が送信中に返ってきてもよいように、状態を先に作っておく
+    auto const first = frame - head_len;
+    tx = {};
+    tx.data = data;
+    tx.offset = first;
+    tx.sn = 1;
+    tx.phase = Phase::kWaitFC;
+    tx.status = Status::kBusy;
+    if (!SendFrame(s, head, head_len, data.data(), first)) {
+      tx = {};
+      return false;
+    }
+    return true;
+  }
+
+  [[nodiscard]] Status TxStatus(size_t session) const {
+    return sessions_[session].tx.status;
+  }
+
+  [[nodiscard]] Status RxStatus(size_t session) const {
+    return sessions_[session].rx.status;
+  }
+
+  /// @brief 受信し終えたメッセージ (Release するまで有効、未完了なら空)
+  [[nodiscard]] Span<const uint8_t> Received(size_t session) const {
+    auto const& s = sessions_[session];
+    if (s.rx.status != Status::kDone) {
+      return {};
+    }
+    return {s.buffer.data(), s.rx.size};
+  }
+
+  /// @brief 受信バッファを空けて次のメッセージを受けられるようにする
+  void Release(size_t session) { sessions_[session].rx = {}; }
+
+  /// @brief CF の送信とタイムアウトの判定を進める
+  void Poll(Microseconds now) {
+    for (auto& s : sessions_) {
+      if (!s.open) {
+        continue;
+      }
+      PollTx(s, now);
+      PollRx(s, now);
+    }
+  }
+
+ private:
+  [[nodiscard]] size_t FrameLength() const {
+    if constexpr (kCANMaxPayload > 8) {
+      return options_.fd ? kCANMaxPayload : 8;
+    } else {
+      return 8;
+    }
+  }
+
+  Session* Find(uint32_t rx_id) {
+    for (auto& s : sessions_) {
+      if (s.open && s.address.rx_id == rx_id) {
+        return &s;
+      }
+    }
+    return nullptr;
+  }
+
+  /// head と payload を並べ、DLC いっぱいまで padding で埋めて送る
+  bool SendFrame(Session const& s, uint8_t const* head, size_t head_len,
+                 uint8_t const* payload, size_t payload_len) {
+    CANMessage msg;
+    msg.id = s.address.tx_id;
+    msg.SetFormat(s.address.format);
+
+    auto const used = head_len + payload_len;
+    auto const len = used <= 8 ? 8 : PaddedLength(used);
+    std::memcpy(msg.data, head, head_len);
+    if (payload_len != 0) {
+      std::memcpy(msg.data + head_len, payload, payload_len);
+    }
+    std::memset(msg.data + used, options_.padding, len - used);
+    msg.len = static_cast<uint8_t>(len);
+    if (len > 8) {
+      msg.flags |= CANMessage::kFlagFD | CANMessage::kFlagBRS;
+    }
+    return driver_.SendMessage(msg);
+  }
+
+  void SendFlowControl(Session const& s, uint8_t status) {
+    uint8_t const head[] = {static_cast<uint8_t>(kFlowControl | status),
+                            options_.block_size, options_.st_min};
+    SendFrame(s, head, sizeof(head), nullptr, 0);
+  }
+
+  void ReceiveSingle(Session& s, CANMessage const& msg) {
+    size_t size = msg.data[0] & 0x0F;
+    size_t offset = 1;
+    if (size == 0 && msg.len > 8) {
+      size = msg.data[1];
+      offset = 2;
+    }
+    if (size == 0 || size > msg.len - offset || size > kBufferSize ||
+        s.rx.status == Status::kDone) {
+      return;
+    }
+
+    std::memcpy(s.buffer.data(), msg.data + offset, size);
+    s.rx = {};
+    s.rx.size = size;
+    s.rx.received = size;
+    s.rx.status = Status::kDone;
+  }
+
+  void ReceiveFirst(Session& s, CANMessage const& msg) {
+    if (msg.len < 8) {
+      return;
+    }
+    size_t size = (static_cast<size_t>(msg.data[0] & 0x0F) << 8) | msg.data[1];
+    size_t offset = 2;
+    if (size == 0) {
+      for (size_t i = 0; i < 4; i++) {
+        size = (size << 8) | msg.data[2 + i];
+      }
+      offset = 6;
+    }
+
+    // SF に収まる長さや、FF 自身の中身より短い FF_DL は不正なので無視する
+    auto const first = static_cast<size_t>(msg.len) - offset;
+    auto const single_max = msg.len > 8 ? msg.len - 2u : 7u;
+    if (size <= single_max || size < first) {
+      return;
+    }
+
+    if (size > kBufferSize || s.rx.status == Status::kDone) {
+      SendFlowControl(s, kOverflowStatus);
+      return;
+    }
+
+    std::memcpy(s.buffer.data(), msg.data + offset, first);
+    s.rx = {};
+    s.rx.size = size;
+    s.rx.received = first;
+    s.rx.sn = 1;
+    s.rx.activity = true;
+    s.rx.status = Status::kBusy;
+    SendFlowControl(s, kContinue);
+  }
+
+  void ReceiveConsecutive(Session& s, CANMessage const& msg) {
+    auto& rx = s.rx;
+    if (rx.status != Status::kBusy) {
+      return;
+    }
+    if ((msg.data[0] & 0x0F) != rx.sn) {
+      rx.status = Status::kError;
+      return;
+    }
+
+    // 念のためバッファ長でも抑える (rx.size は ReceiveFirst で確認済み)
+    auto const end = rx.size < kBufferSize ? rx.size : kBufferSize;
+    auto const remaining = rx.received < end ? end - rx.received : 0;
+    auto const room = static_cast<size_t>(msg.len - 1);
+    auto const chunk = room < remaining ? room : remaining;
+    std::memcpy(s.buffer.data() + rx.received, msg.data + 1, chunk);
+    rx.received += chunk;
+    rx.sn = (rx.sn + 1) & 0x0F;
+    rx.activity = true;
+
+    if (rx.received == rx.size) {
+      rx.status = Status::kDone;
+      return;
+    }
+    if (options_.block_size != 0 && ++rx.block == options_.block_size) {
+      rx.block = 0;
+      SendFlowControl(s, kContinue);
+    }
+  }
+
+  void ReceiveFlowControl(Session& s, CANMessage const& msg) {
+    auto& tx = s.tx;
+    if (tx.phase != Phase::kWaitFC || msg.len < 3) {
+      return;
+    }
+
+    switch (msg.data[0] & 0x0F) {
+      case kContinue:
+        tx.block_size = msg.data[1];
+        tx.block_left = msg.data[1];
+        tx.st_min = DecodeStMin(msg.data[2]);
+        tx.next = Microseconds{0};
+        tx.phase = Phase::kSendCF;
+        break;
+      case kWait:
+        tx.deadline = kUnset;
+        break;
+      case kOverflowStatus:
+        tx.phase = Phase::kIdle;
+        tx.status = Status::kOverflow;
+        break;
+      default:
+        tx.phase = Phase::kIdle;
+        tx.status = Status::kError;
+        break;
+    }
+  }
+
+  void PollTx(Session& s, Microseconds now) {
+    auto& tx = s.tx;
+    if (tx.phase == Phase::kWaitFC) {
+      if (tx.deadline == kUnset) {
+        tx.deadline = now + options_.timeout;
+      } else if (now >= tx.deadline) {
+        tx.phase = Phase::kIdle;
+        tx.status = Status::kTimeout;
+      }
+      return;
+    }
+
+    while (tx.phase == Phase::kSendCF && now >= tx.next) {
+      auto const remaining = tx.data.size() - tx.offset;
+      auto const room = FrameLength() - 1;
+      auto const chunk = remaining < room ? remaining : room;
+      uint8_t const head = kConsecutive | tx.sn;
+      if (!SendFrame(s, &head, 1, tx.data.data() + tx.offset, chunk)) {
+        break;  // 送信バッファが空くまで次の Poll で再送する
+      }
+      tx.offset += chunk;
+      tx.sn = (tx.sn + 1) & 0x0F;
+
+      if (tx.offset == tx.data.size()) {
+        tx.phase = Phase::kIdle;
+        tx.status = Status::kDone;
+      } else if (tx.block_size != 0 && --tx.block_left == 0) {
+        tx.phase = Phase::kWaitFC;
+        tx.deadline = now + options_.timeout;
+      } else if (tx.st_min.count() != 0) {
+        tx.next = now + tx.st_min;
+      }
+    }
+  }
+
+  void PollRx(Session& s, Microseconds now) {
+    auto& rx = s.rx;
+    if (rx.status != Status::kBusy) {
+      return;
+    }
+    if (rx.activity || rx.deadline == kUnset) {
+      rx.activity = false;
+      rx.deadline = now + options_.timeout;
+    } else if (now >= rx.deadline) {
+      rx.status = Status::kTimeout;
+    }
+  }
+
+  Driver& driver_;
+  Options options_;
+  std::array<Session, kSessions> sessions_{};
+};
+
+}  // namespace nano_hw::can::isotp
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "high_res_clock.hpp"
+#include "parallel.hpp"
+#include "thread.hpp"
+
+namespace nano_hw::reactor {
+
+/// @brief Reactor に登録したイベント源
+/// @details 周辺機器が持つのはこれ (1 バイト) と Reactor への参照だけ
+struct EventSource {
+  uint8_t index;
+};
+
+/// @brief Config::kReactorPriority があればそれを、無ければ fallback を返す
+template <typename Config>
+constexpr uint8_t ReactorPriorityOf(uint8_t fallback) {
+  if constexpr (requires { uint8_t{Config::kReactorPriority}; }) {
+    return Config::kReactorPriority;
+  } else {
+    return fallback;
+  }
+}
+
+/// @brief Reactor のスレッドを眠らせ、Signal で起こす仕組み
+/// @details Notify は割り込みからも呼ばれる。WaitFor に入る前の Notify も
+///          取りこぼさないこと (イベントフラグのように覚えておく)
+template <typename T>
+concept Waker = requires(T value, HighResClockDuration timeout) {
+  {value.Notify()}->std::same_as<void>;
+  {value.WaitFor(timeout)}->std::same_as<void>;
+};
+
+/// @brief 1ms ごとに起きて確認するだけの Waker (OS の同期機構が無いとき用)
+struct PollingWaker {
+  void Notify() {}
+  void WaitFor(HighResClockDuration timeout) {
+    auto const step = HighResClockDuration(1);
+    parallel::SleepForMS(timeout < step ? timeout : step);
+  }
+};
+static_assert(Waker<PollingWaker>);
+
+/// @brief 全周辺機器のイベントを 1 本のスレッドで捌く reactor
+/// @details
+///   - Register したイベント源は Signal (割り込みから呼べる) で実行待ちに
+///     なり、Reactor のスレッドが fn(ctx) を呼ぶ
+///   - 実行待ちが複数あれば priority の大きい順 (同じなら登録の早い順)。
+///     1 つ呼ぶたびに選び直すので、優先度の高い源が続くと低い源は待たされる
+///   - fn を呼ぶ前に実行待ちを解くので、呼ばれるまでの Signal は 1 回に
+///     まとまり、fn の最中の Signal はもう 1 回の呼び出しになる
+///   - RegisterPeriodic した源は period ごとに自動で実行待ちになる
+///     (遅れた分はまとめず、次の周期から数え直す)
+///   - Register / Unregister は任意のスレッドから呼べる。ただし Unregister
+///     は fn の中 (Reactor のスレッド) から呼んではいけない
+/// @tparam ThreadT Thread concept を満たすスレッド実装
+/// @tparam Clock 周期の計時に使う時計
+/// @tparam WakerT 待ち受けの仕組み
+/// @tparam kMaxSources 登録できるイベント源の数 (32 以下)
+template <thread::Thread ThreadT, HighResClockLike Clock,
+          Waker WakerT = PollingWaker, size_t kMaxSources = 32>
+class Reactor {
+  static_assert(kMaxSources > 0 && kMaxSources <= 32,
+                "kMaxSources must be in 1..32");
+
+  using Mask = uint32_t;
+  static constexpr Mask kAllSources =
+      kMaxSources == 32 ? ~Mask{0} : (Mask{1} << kMaxSources) - 1;
+
+ public:
+  using Duration = HighResClockDuration;
+
+  explicit Reactor(ThreadPriority priority = ThreadPriorityAboveNormal,
+                   uint32_t stack_size = 2048, const char* name = "reactor")
+      : priority_(priority), stack_size_(stack_size), name_(name) {}
+
+  Reactor(Reactor const&) = delete;
+  Reactor& operator=(Reactor const&) = delete;
+
+  ~Reactor() { Stop(); }
+
+  /// @brief ディスパッチスレッドを起動する
+  void Start() {
+    if (running_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    thread_.emplace(priority_, stack_size_, nullptr, name_);
+    thread_->Start([this]() { Loop(); });
+  }
+
+  /// @brief ディスパッチスレッドを止める (実行待ちは残る)
+  void Stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+      return;
+    }
+    waker_.Notify();
+    thread_->Join();
+    thread_.reset();
+  }
+
+  /// @brief Signal されたら fn(ctx) を呼ぶイベント源を登録する
+  /// @return 空きが無ければ std::nullopt
+  std::optional<EventSource> Register(void (*fn)(void*), void* ctx,
+                                      uint8_t priority = 0) {
+    return Add(fn, ctx, priority, Duration::zero());
+  }
+
+  /// @brief period ごとに fn(ctx) を呼ぶイベント源を登録する
+  /// @note 周期の途中でも Signal すれば呼ばれる
+  std::optional<EventSource> RegisterPeriodic(void (*fn)(void*), void* ctx,
+                                              Duration period,
+                                              uint8_t priority = 0) {
+    if (period <= Duration::zero()) {
+      return std::nullopt;
+    }
+    return Add(fn, ctx, priority, period);
+  }
+
+  /// @brief 登録を解く
+  /// @details 戻ったあとは fn が呼ばれない (呼び出し中なら終わるまで待つ)
+  void Unregister(EventSource source) {
+    auto const bit = Bit(source);
+    active_.fetch_and(~bit, std::memory_order_seq_cst);
+    pending_.fetch_and(~bit, std::memory_order_relaxed);
+
+    // 解く前の active_ を見ている周回が終わるまで slot を再利用しない
+    auto const iteration = iteration_.load(std::memory_order_seq_cst);
+    if (iteration % 2 != 0) {
+      while (iteration_.load(std::memory_order_acquire) == iteration) {
+        parallel::SleepForMS(Duration(1));
+      }
+    }
+    used_.fetch_and(~bit, std::memory_order_release);
+  }
+
+  /// @brief source を実行待ちにする (割り込みから呼べる)
+  void Signal(EventSource source) {
+    pending_.fetch_or(Bit(source), std::memory_order_release);
+    waker_.Notify();
+  }
+
+  /// @brief 登録中のイベント源の数
+  [[nodiscard]] size_t Sources() const {
+    return std::popcount(used_.load(std::memory_order_relaxed));
+  }
+
+  /// @brief fn を呼んだ回数
+  [[nodiscard]] size_t Dispatched() const {
+    return dispatched_.load(std::memory_order_relaxed);
+  }
+
+  static constexpr size_t Capacity() { return kMaxSources; }
+
+ private:
+  /// 何も起きないときに running_ を見直す間隔
+  static constexpr Duration kMaxWait = Duration(100);
+
+  struct Slot {
+    void (*fn)(void*) = nullptr;
+    void* ctx = nullptr;
+    Duration period{0};
+    Duration next{0};  ///< 次に実行待ちにする時刻 (Reactor のスレッドが更新)
+    uint8_t priority = 0;
+  };
+
+  static Mask Bit(EventSource source) { return Mask{1} << source.index; }
+
+  std::optional<EventSource> Add(void (*fn)(void*), void* ctx,
+                                 uint8_t priority, Duration period) {
+    if (fn == nullptr) {
+      return std::nullopt;
+    }
+
+    auto used = used_.load(std::memory_order_relaxed);
+    Mask bit;
+    do {
+      auto const free = ~used & kAllSources;
+      if (free == 0) {
+        return std::nullopt;
+      }
+      bit = free & (~free + 1);
+    } while (!used_.compare_exchange_weak(used, used | bit,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_relaxed));
+
+    auto const index = static_cast<uint8_t>(std::countr_zero(bit));
+    slots_[index] = Slot{fn, ctx, period, Clock::Now() + period, priority};
+    pending_.fetch_and(~bit, std::memory_order_relaxed);
+    // slot を書き終えてから Reactor のスレッドに見せる
+    active_.fetch_or(bit, std::memory_order_seq_cst);
+    waker_.Notify();
+    return EventSource{index};
+  }
+
+  // 周期が来た源を実行待ちにし、次の周期までの時間を wait に縮める
+  void Expire(Mask active, Duration now, Duration& wait) {
+    for (; active != 0; active &= active - 1) {
+      auto& slot = slots_[std::countr_zero(active)];
+      if (slot.period == Duration::zero()) {
+        continue;
+      }
+      if (slot.next <= now) {
+        pending_.fetch_or(active & (~active + 1), std::memory_order_relaxed);
+        slot.next += slot.period;
+        if (slot.next <= now) {
+          slot.next = now + slot.period;
+        }
+      }
+      if (slot.next - now < wait) {
+        wait = slot.next - now;
+      }
+    }
+  }
+
+  // 実行待ちのうち priority の最も大きい源
+  size_t Pick(Mask ready) const {
+    auto best = static_cast<size_t>(std::countr_zero(ready));
+    for (ready &= ready - 1; ready != 0; ready &= ready - 1) {
+      auto const index = static_cast<size_t>(std::countr_zero(ready));
+      if (slots_[index].priority > slots_[best].priority) {
+        best = index;
+      }
+    }
+    return best;
+  }
+
+  void Loop() {
+    while (running_.load(std::memory_order_acquire)) {
+      // 奇数の間は slots_ を読んでいる (Unregister が待つ)
+      iteration_.fetch_add(1, std::memory_order_seq_cst);
+      auto const active = active_.load(std::memory_order_seq_cst);
+
+      auto wait = kMaxWait;
+      Expire(active, Clock::Now(), wait);
+
+      auto const ready = pending_.load(std::memory_order_acquire) & active;
+      if (ready != 0) {
+        auto const index = Pick(ready);
+        pending_.fetch_and(~(Mask{1} << index), std::memory_order_acq_rel);
+        slots_[index].fn(slots_[index].ctx);
+        dispatched_.fetch_add(1, std::memory_order_relaxed);
+      }
+      iteration_.fetch_add(1, std::memory_order_seq_cst);
+
+      if (ready == 0) {
+        waker_.WaitFor(wait);
+      }
+    }
+  }
+
+  ThreadPriority priority_;
+  uint32_t stack_size_;
+  const char* name_;
+
+  std::array<Slot, kMaxSources> slots_{};
+  std::atomic<Mask> used_{0};     ///< 確保済みの slot
+  std::atomic<Mask> active_{0};   ///< Reactor のスレッドが見てよい slot
+  std::atomic<Mask> pending_{0};  ///< 実行待ち
+  std::atomic<uint32_t> iteration_{0};
+  std::atomic<size_t> dispatched_{0};
+  std::atomic<bool> running_{false};
+
+  WakerT waker_;
+  std::optional<ThreadT> thread_;
+};
+
+}  // namespace nano_hw::reactor
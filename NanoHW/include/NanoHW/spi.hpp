@@ -1,15 +1,27 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
-#include <vector>
 
+#include <Nano/static_vector.hpp>
 #include <NanoHW/pin.hpp>
 #include <NanoHW/policies.hpp>
 #include "pin.hpp"
 
+#ifndef NANO_HW_SPI_MAX_TRANSFER
+#define NANO_HW_SPI_MAX_TRANSFER 64
+#endif
+
 namespace nano_hw::spi {
 
+/// 1 回の Transfer で扱える最大バイト数
+inline constexpr size_t kSPIMaxTransfer = NANO_HW_SPI_MAX_TRANSFER;
+
+/// @brief Transfer の送受信バッファ (ヒープを使わない)
+/// @note kSPIMaxTransfer を超える転送は呼び出し側で分割する
+using SPIBuffer = Nano::collection::StaticVector<uint8_t, kSPIMaxTransfer>;
+
 enum class SPIFormat : uint8_t {
   Mode0,
   Mode1,
@@ -19,8 +31,7 @@ enum class SPIFormat : uint8_t {
 
 template <typename T>
 concept SPIConfig =
-    Policy<typename T::OnTransfer, void*, std::vector<uint8_t> const&,
-           std::vector<uint8_t> const&>;
+    Policy<typename T::OnTransfer, void*, SPIBuffer const&, SPIBuffer const&>;
 
 struct DummySPIConfig {
   using OnTransfer = nano_hw::Ignore;
@@ -29,8 +40,7 @@ static_assert(SPIConfig<DummySPIConfig>);
 
 template <template <SPIConfig> typename SPIT>
 concept SPI = requires(SPIT<DummySPIConfig> spi, Pin miso, Pin mosi, Pin sclk,
-                       int frequency, std::vector<uint8_t> const& tx,
-                       std::vector<uint8_t>& rx) {
+                       int frequency, SPIBuffer const& tx, SPIBuffer& rx) {
   {SPIT<DummySPIConfig>(miso, mosi, sclk, frequency)}
       ->std::same_as<SPIT<DummySPIConfig>>;
   {spi.SetMode(SPIFormat::Mode0)}->std::same_as<void>;
@@ -41,8 +51,8 @@ concept SPI = requires(SPIT<DummySPIConfig> spi, Pin miso, Pin mosi, Pin sclk,
 struct ICallbacks {
  public:
   virtual ~ICallbacks() = default;
-  virtual void OnTransfer(void* context, std::vector<uint8_t> const& tx,
-                          std::vector<uint8_t> const& rx) = 0;
+  virtual void OnTransfer(void* context, SPIBuffer const& tx,
+                          SPIBuffer const& rx) = 0;
 };
 
 void* AllocInterface(Pin miso, Pin mosi, Pin sclk, int frequency,
@@ -50,16 +60,16 @@ void* AllocInterface(Pin miso, Pin mosi, Pin sclk, int frequency,
 void FreeInterface(void* interface);
 void SetModeImpl(void* interface, SPIFormat format);
 void SetFrequencyImpl(void* interface, int frequency);
-int TransferImpl(void* interface, std::vector<uint8_t> const& tx_buffer,
-                 std::vector<uint8_t>& rx_buffer);
+int TransferImpl(void* interface, SPIBuffer const& tx_buffer,
+                 SPIBuffer& rx_buffer);
 
 template <SPIConfig Config>
 class DynSPI {
   struct Callbacks : public ICallbacks {
    public:
     ~Callbacks() override = default;
-    void OnTransfer(void* context, std::vector<uint8_t> const& tx,
-                    std::vector<uint8_t> const& rx) final {
+    void OnTransfer(void* context, SPIBuffer const& tx,
+                    SPIBuffer const& rx) final {
       Config::OnTransfer::execute(context, tx, rx);
     }
   };
@@ -78,8 +88,7 @@ class DynSPI {
 
   void SetMode(SPIFormat format) { SetModeImpl(interface_, format); }
   void SetFrequency(int frequency) { SetFrequencyImpl(interface_, frequency); }
-  int Transfer(std::vector<uint8_t> const& tx_buffer,
-               std::vector<uint8_t>& rx_buffer) {
+  int Transfer(SPIBuffer const& tx_buffer, SPIBuffer& rx_buffer) {
     return TransferImpl(interface_, tx_buffer, rx_buffer);
   }
 
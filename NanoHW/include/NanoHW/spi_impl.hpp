@@ -1,5 +1,8 @@
 #pragma once
 
+#include <utility>
+
+#include "instance_pool.hpp"
 #include "spi.hpp"
 
 namespace nano_hw::spi {
@@ -10,18 +13,20 @@ void* AllocSPIInterfaceImpl(Pin miso, Pin mosi, Pin sclk, int frequency,
 void FreeSPIInterfaceImpl(void* inst);
 void SetModeSPIImpl(void* inst, SPIFormat format);
 void SetFrequencySPIImpl(void* inst, int frequency);
-int TransferSPIImpl(void* inst, std::vector<uint8_t> const& tx_buffer,
-                    std::vector<uint8_t>& rx_buffer);
+int TransferSPIImpl(void* inst, SPIBuffer const& tx_buffer,
+                    SPIBuffer& rx_buffer);
 
 /// @brief SPI conceptを満たす型から動的ディスパッチ関数を生成
 /// @tparam SPIT SPI conceptを満たすテンプレートクラス
-template <template <SPIConfig> typename SPIT>
+/// @tparam kInstances 同時に持てるインスタンス数
+template <template <SPIConfig> typename SPIT,
+          size_t kInstances = kMaxInstances>
 requires SPI<SPIT> class SPIImpl {
   // Config内のOnTransferからコールバックを呼び出すためのConfig
   struct CallbackConfig {
     struct OnTransfer {
-      static void execute(void* context, std::vector<uint8_t> const& tx,
-                          std::vector<uint8_t> const& rx) {
+      static void execute(void* context, SPIBuffer const& tx,
+                          SPIBuffer const& rx) {
         auto* ctx = static_cast<std::pair<ICallbacks*, void*>*>(context);
         if (ctx->first != nullptr) {
           ctx->first->OnTransfer(ctx->second, tx, rx);
@@ -32,46 +37,46 @@ requires SPI<SPIT> class SPIImpl {
 
   using ImplType = SPIT<CallbackConfig>;
 
+  // ImplType とコールバック情報を 1 スロットにまとめてプールに置く
+  struct Instance {
+    template <typename... Args>
+    explicit Instance(ICallbacks* callbacks, void* callback_context,
+                      Args... args)
+        : context(callbacks, callback_context), impl(args...) {}
+
+    std::pair<ICallbacks*, void*> context;
+    ImplType impl;
+  };
+
+  static inline InstancePool<Instance, kInstances> pool_;
+
   friend void* AllocSPIInterfaceImpl(Pin miso, Pin mosi, Pin sclk,
                                      int frequency, ICallbacks* callbacks,
                                      void* callback_context) {
-    auto* impl = new ImplType(miso, mosi, sclk, frequency);
-    auto* ctx = new std::pair<ICallbacks*, void*>(callbacks, callback_context);
-    // implとコンテキストをペアで保存
-    return new std::pair<ImplType*, std::pair<ICallbacks*, void*>*>(impl, ctx);
+    return pool_.New(callbacks, callback_context, miso, mosi, sclk, frequency);
   }
 
   friend void FreeSPIInterfaceImpl(void* inst) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    delete pair->first;
-    delete pair->second;
-    delete pair;
+    pool_.Delete(static_cast<Instance*>(inst));
   }
 
   friend void SetModeSPIImpl(void* inst, SPIFormat format) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    pair->first->SetMode(format);
+    auto* instance = static_cast<Instance*>(inst);
+    instance->impl.SetMode(format);
   }
 
   friend void SetFrequencySPIImpl(void* inst, int frequency) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    pair->first->SetFrequency(frequency);
+    auto* instance = static_cast<Instance*>(inst);
+    instance->impl.SetFrequency(frequency);
   }
 
-  friend int TransferSPIImpl(void* inst, std::vector<uint8_t> const& tx_buffer,
-                             std::vector<uint8_t>& rx_buffer) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    int result = pair->first->Transfer(tx_buffer, rx_buffer);
+  friend int TransferSPIImpl(void* inst, SPIBuffer const& tx_buffer,
+                             SPIBuffer& rx_buffer) {
+    auto* instance = static_cast<Instance*>(inst);
+    int result = instance->impl.Transfer(tx_buffer, rx_buffer);
     // コールバックを呼び出す
-    CallbackConfig::OnTransfer::execute(pair->second, tx_buffer, rx_buffer);
+    CallbackConfig::OnTransfer::execute(&instance->context, tx_buffer,
+                                        rx_buffer);
     return result;
   }
 };
@@ -92,8 +97,7 @@ void SetModeImpl(void* inst, SPIFormat format) {
 void SetFrequencyImpl(void* inst, int frequency) {
   SetFrequencySPIImpl(inst, frequency);
 }
-int TransferImpl(void* inst, std::vector<uint8_t> const& tx_buffer,
-                 std::vector<uint8_t>& rx_buffer) {
+int TransferImpl(void* inst, SPIBuffer const& tx_buffer, SPIBuffer& rx_buffer) {
   return TransferSPIImpl(inst, tx_buffer, rx_buffer);
 }
 
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <Nano/inplace_function.hpp>
+
 #include <concepts>
 #include <cstdint>
-#include <functional>
 #include <string>
+#include <utility>
 
 enum ThreadPriority {
   ThreadPriorityIdle = -3,         ///< Priority: idle (lowest)
@@ -17,10 +19,14 @@ enum ThreadPriority {
 
 namespace nano_hw::thread {
 
+/// @brief スレッドに渡すタスク (ヒープを使わない)
+using ThreadTask =
+    Nano::utils::InplaceFunction<void(), 4 * sizeof(void*)>;
+
 template <typename T>
 concept Thread = requires(T value, ThreadPriority priority, uint32_t stack_size,
                           unsigned char* stack_mem, const char* name,
-                          std::function<void()> task) {
+                          ThreadTask task) {
   {T(priority, stack_size, stack_mem, name)}->std::same_as<T>;
   {value.Start(task)}->std::same_as<void>;
   {value.Join()}->std::same_as<void>;
@@ -32,7 +38,7 @@ concept Thread = requires(T value, ThreadPriority priority, uint32_t stack_size,
 void* AllocInterface(ThreadPriority priority, uint32_t stack_size,
                      unsigned char* stack_mem, const char* name);
 void FreeInterface(void* interface);
-void StartImpl(void* interface, std::function<void()> task);
+void StartImpl(void* interface, ThreadTask task);
 void JoinImpl(void* interface);
 void TerminateImpl(void* interface);
 void SetPriorityImpl(void* interface, ThreadPriority priority);
@@ -48,7 +54,7 @@ class DynThread {
 
   ~DynThread() { FreeInterface(interface_); }
 
-  void Start(std::function<void()> task) { StartImpl(interface_, task); }
+  void Start(ThreadTask task) { StartImpl(interface_, std::move(task)); }
   void Join() { JoinImpl(interface_); }
   void Terminate() { TerminateImpl(interface_); }
   void SetPriority(ThreadPriority priority) {
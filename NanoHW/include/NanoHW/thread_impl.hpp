@@ -8,7 +8,7 @@ namespace nano_hw::thread {
 void* AllocThreadInterfaceImpl(ThreadPriority priority, uint32_t stack_size,
                                unsigned char* stack_mem, const char* name);
 void FreeThreadInterfaceImpl(void* inst);
-void StartThreadImpl(void* inst, std::function<void()> task);
+void StartThreadImpl(void* inst, ThreadTask task);
 void JoinThreadImpl(void* inst);
 void TerminateThreadImpl(void* inst);
 void SetPriorityThreadImpl(void* inst, ThreadPriority priority);
@@ -29,8 +29,8 @@ class ThreadImpl {
     delete static_cast<Impl*>(inst);
   }
 
-  friend void StartThreadImpl(void* inst, std::function<void()> task) {
-    static_cast<Impl*>(inst)->Start(task);
+  friend void StartThreadImpl(void* inst, ThreadTask task) {
+    static_cast<Impl*>(inst)->Start(std::move(task));
   }
 
   friend void JoinThreadImpl(void* inst) { static_cast<Impl*>(inst)->Join(); }
@@ -57,8 +57,8 @@ void* AllocInterface(ThreadPriority priority, uint32_t stack_size,
 void FreeInterface(void* inst) {
   FreeThreadInterfaceImpl(inst);
 }
-void StartImpl(void* inst, std::function<void()> task) {
-  StartThreadImpl(inst, task);
+void StartImpl(void* inst, ThreadTask task) {
+  StartThreadImpl(inst, std::move(task));
 }
 void JoinImpl(void* inst) {
   JoinThreadImpl(inst);
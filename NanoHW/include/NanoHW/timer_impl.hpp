@@ -1,5 +1,8 @@
 #pragma once
 
+#include <utility>
+
+#include "instance_pool.hpp"
 #include "timer.hpp"
 
 namespace nano_hw::timer {
@@ -15,7 +18,9 @@ bool EnableTickTimerImpl(void* inst, std::chrono::milliseconds interval);
 
 /// @brief Timer conceptを満たす型から動的ディスパッチ関数を生成
 /// @tparam TimerT Timer conceptを満たすテンプレートクラス
-template <template <TimerConfig> typename TimerT>
+/// @tparam kInstances 同時に持てるインスタンス数
+template <template <TimerConfig> typename TimerT,
+          size_t kInstances = kMaxInstances>
 requires Timer<TimerT> class TimerImpl {
   // Config内のコールバックを呼び出すためのConfig
   struct CallbackConfig {
@@ -31,56 +36,52 @@ requires Timer<TimerT> class TimerImpl {
 
   using ImplType = TimerT<CallbackConfig>;
 
+  // ImplType とコールバック情報を 1 スロットにまとめてプールに置く
+  struct Instance {
+    template <typename... Args>
+    explicit Instance(ICallbacks* callbacks, void* callback_context,
+                      Args... args)
+        : context(callbacks, callback_context), impl(args...) {}
+
+    std::pair<ICallbacks*, void*> context;
+    ImplType impl;
+  };
+
+  static inline InstancePool<Instance, kInstances> pool_;
+
   friend void* AllocTimerInterfaceImpl(ICallbacks* callbacks,
                                        void* callback_context) {
-    auto* impl = new ImplType();
-    auto* ctx = new std::pair<ICallbacks*, void*>(callbacks, callback_context);
-    return new std::pair<ImplType*, std::pair<ICallbacks*, void*>*>(impl, ctx);
+    return pool_.New(callbacks, callback_context);
   }
 
   friend void FreeTimerInterfaceImpl(void* inst) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    delete pair->first;
-    delete pair->second;
-    delete pair;
+    pool_.Delete(static_cast<Instance*>(inst));
   }
 
   friend void ResetTimerImpl(void* inst) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    pair->first->Reset();
+    auto* instance = static_cast<Instance*>(inst);
+    instance->impl.Reset();
   }
 
   friend void StartTimerImpl(void* inst) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    pair->first->Start();
+    auto* instance = static_cast<Instance*>(inst);
+    instance->impl.Start();
   }
 
   friend void StopTimerImpl(void* inst) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    pair->first->Stop();
+    auto* instance = static_cast<Instance*>(inst);
+    instance->impl.Stop();
   }
 
   friend std::chrono::milliseconds ReadTimerImpl(void* inst) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    return pair->first->Read();
+    auto* instance = static_cast<Instance*>(inst);
+    return instance->impl.Read();
   }
 
   friend bool EnableTickTimerImpl(void* inst,
                                   std::chrono::milliseconds interval) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    return pair->first->EnableTick(interval);
+    auto* instance = static_cast<Instance*>(inst);
+    return instance->impl.EnableTick(interval);
   }
 };
 
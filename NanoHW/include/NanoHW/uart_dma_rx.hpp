@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#include <Nano/queue.hpp>
+#include <Nano/span.hpp>
+
+#include "policies.hpp"
+
+namespace nano_hw::uart {
+
+/// @brief 循環 DMA 受信で起きる割り込み
+enum class DmaRxEvent : uint8_t {
+  kHalfTransfer,      ///< バッファの前半を書き終えた
+  kTransferComplete,  ///< バッファの末尾まで書き終えた (先頭に戻る)
+  kIdle,              ///< 受信が 1 フレーム分途切れた (idle-line)
+};
+
+struct DmaRxStats {
+  uint32_t half_transfers = 0;
+  uint32_t transfer_completes = 0;
+  uint32_t idles = 0;
+  uint32_t bytes = 0;
+};
+
+/// @brief Config::kRxDmaSize があればそれを、無ければ 0 (DMA を使わない)
+template <typename Config>
+constexpr size_t RxDmaSizeOf() {
+  if constexpr (requires { size_t{Config::kRxDmaSize}; }) {
+    return Config::kRxDmaSize;
+  } else {
+    return 0;
+  }
+}
+
+template <typename T>
+concept DmaRxConfig =
+    Policy<typename T::OnUARTRx, void*, const uint8_t*, size_t>;
+
+/// @brief 循環 DMA の受信バッファ
+/// @details
+///   - Buffer() を循環モードの DMA の転送先にする。領域は Queue の
+///     内部配列そのもので、DMA が書いた分を Queue::CommitN で見せる
+///   - 半分・末尾・idle-line の割り込みから OnEvent を呼ぶと、前回から
+///     増えた分をまとめて Config::OnUARTRx に渡す (割り込みの中で呼ぶ。
+///     バッファの端をまたいだ分は 2 回に分ける)
+///   - 渡したデータは DMA が一周して戻ってくるまで有効
+///   - 割り込みが半周分以上遅れると、上書きされた分は検出できずに失われる
+/// @tparam kSize DMA バッファのバイト数 (偶数)
+template <size_t kSize, DmaRxConfig Config>
+class DmaRxRing {
+  static_assert(kSize >= 4 && kSize % 2 == 0, "kSize must be even");
+
+ public:
+  explicit DmaRxRing(void* context = nullptr) : context_(context) {}
+
+  DmaRxRing(DmaRxRing const&) = delete;
+  DmaRxRing& operator=(DmaRxRing const&) = delete;
+
+  /// @brief DMA の転送先 (kSize バイト)
+  Nano::collection::Span<uint8_t> Buffer() { return ring_.Storage(); }
+
+  /// @param remaining DMA の残り転送数 (STM32 の NDTR)
+  /// @note どの割り込みでも remaining から書き込み位置を求めるので、
+  ///       割り込みが遅れて重なっても二重には渡さない
+  void OnEvent(DmaRxEvent event, size_t remaining) {
+    switch (event) {
+      case DmaRxEvent::kHalfTransfer:
+        stats_.half_transfers++;
+        break;
+      case DmaRxEvent::kTransferComplete:
+        stats_.transfer_completes++;
+        break;
+      case DmaRxEvent::kIdle:
+        stats_.idles++;
+        break;
+    }
+
+    auto const position = (kSize - remaining) % kSize;
+    auto const received = (position + kSize - last_) % kSize;
+    last_ = position;
+    ring_.CommitN(received);
+    Publish();
+  }
+
+  [[nodiscard]] DmaRxStats const& Stats() const { return stats_; }
+
+ private:
+  void Publish() {
+    auto const segments = ring_.Segments();
+    for (auto segment : {segments.first, segments.second}) {
+      if (!segment.empty()) {
+        Config::OnUARTRx::execute(context_, segment.data(), segment.size());
+      }
+    }
+    stats_.bytes += static_cast<uint32_t>(segments.size());
+    ring_.ConsumeN(segments.size());
+  }
+
+  void* context_;
+  Nano::collection::Queue<uint8_t, kSize> ring_;
+  size_t last_ = 0;
+  DmaRxStats stats_;
+};
+
+}  // namespace nano_hw::uart
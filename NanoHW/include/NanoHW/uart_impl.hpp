@@ -1,5 +1,8 @@
 #pragma once
 
+#include <utility>
+
+#include "instance_pool.hpp"
 #include "uart.hpp"
 
 namespace nano_hw::uart {
@@ -15,7 +18,9 @@ void FormatUARTImpl(void* inst, int data_bits, Parity parity, int stop_bits);
 
 /// @brief UART conceptを満たす型から動的ディスパッチ関数を生成
 /// @tparam UartT UART conceptを満たすテンプレートクラス
-template <template <UARTConfig> typename UartT>
+/// @tparam kInstances 同時に持てるインスタンス数
+template <template <UARTConfig> typename UartT,
+          size_t kInstances = kMaxInstances>
 requires UART<UartT> class UARTImpl {
   // Config内のコールバックを呼び出すためのConfig
   struct CallbackConfig {
@@ -39,58 +44,57 @@ requires UART<UartT> class UARTImpl {
 
   using ImplType = UartT<CallbackConfig>;
 
+  // ImplType とコールバック情報を 1 スロットにまとめてプールに置く
+  struct Instance {
+    template <typename... Args>
+    explicit Instance(ICallbacks* callbacks, void* callback_context,
+                      Args... args)
+        : context(callbacks, callback_context), impl(args...) {}
+
+    std::pair<ICallbacks*, void*> context;
+    ImplType impl;
+  };
+
+  static inline InstancePool<Instance, kInstances> pool_;
+
   friend void* AllocUARTInterfaceImpl(Pin transmit_pin, Pin receive_pin,
                                       int frequency, ICallbacks* callbacks,
                                       void* callback_context) {
-    auto* impl = new ImplType(transmit_pin, receive_pin, frequency);
-    auto* ctx = new std::pair<ICallbacks*, void*>(callbacks, callback_context);
-    return new std::pair<ImplType*, std::pair<ICallbacks*, void*>*>(impl, ctx);
+    return pool_.New(callbacks, callback_context, transmit_pin, receive_pin,
+                     frequency);
   }
 
   friend void FreeUARTInterfaceImpl(void* inst) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    delete pair->first;
-    delete pair->second;
-    delete pair;
+    pool_.Delete(static_cast<Instance*>(inst));
   }
 
   friend void RebaudUARTImpl(void* inst, int frequency) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    pair->first->Rebaud(frequency);
+    auto* instance = static_cast<Instance*>(inst);
+    instance->impl.Rebaud(frequency);
   }
 
   friend size_t SendUARTImpl(void* inst, void* buffer, size_t size) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    size_t result = pair->first->Send(buffer, size);
+    auto* instance = static_cast<Instance*>(inst);
+    size_t result = instance->impl.Send(buffer, size);
     // コールバックを呼び出す
     CallbackConfig::OnUARTTx::execute(
-        pair->second, static_cast<const uint8_t*>(buffer), size);
+        &instance->context, static_cast<const uint8_t*>(buffer), size);
     return result;
   }
 
   friend size_t ReceiveUARTImpl(void* inst, void* buffer, size_t size) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    size_t result = pair->first->Receive(buffer, size);
+    auto* instance = static_cast<Instance*>(inst);
+    size_t result = instance->impl.Receive(buffer, size);
     // コールバックを呼び出す
     CallbackConfig::OnUARTRx::execute(
-        pair->second, static_cast<const uint8_t*>(buffer), size);
+        &instance->context, static_cast<const uint8_t*>(buffer), size);
     return result;
   }
 
   friend void FormatUARTImpl(void* inst, int data_bits, Parity parity,
                              int stop_bits) {
-    auto* pair =
-        static_cast<std::pair<ImplType*, std::pair<ICallbacks*, void*>*>*>(
-            inst);
-    pair->first->Format(data_bits, parity, stop_bits);
+    auto* instance = static_cast<Instance*>(inst);
+    instance->impl.Format(data_bits, parity, stop_bits);
   }
 };
 
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace nano_hw::uart {
+
+/// @brief 送信リングが満杯のときの Send の振る舞い
+enum class TxFullPolicy : uint8_t {
+  kBlock,     ///< 全部積めるまで待つ
+  kTruncate,  ///< 入る分だけ積む
+  kFail,      ///< 全部入らなければ何も積まない
+};
+
+/// @brief Config::kTxFullPolicy があればそれを、無ければ kBlock を返す
+template <typename Config>
+constexpr TxFullPolicy TxFullPolicyOf() {
+  if constexpr (requires { TxFullPolicy{Config::kTxFullPolicy}; }) {
+    return Config::kTxFullPolicy;
+  } else {
+    return TxFullPolicy::kBlock;
+  }
+}
+
+/// @brief 送信割り込みで吐き出す UART の送信リング
+/// @details
+///   - Write はスレッドから、Drain は送信レジスタ空き割り込みから呼ぶ
+///     (single-producer single-consumer)。位置は読み書きだけの atomic で、
+///     積んだ側が release で進め、取る側が acquire で読む
+///   - 一度に積んだ分を 1 チャンクとして覚え、最後のバイトを送信レジスタに
+///     渡したときに on_chunk(data, size) を呼ぶ。リングの端で折り返した
+///     チャンクは 2 回に分けて渡す。kBlock で空きを待ちながら積んだ Write
+///     は複数のチャンクになるので、on_chunk も複数回になる
+///   - チャンクの数も kMaxChunks までで、超えたらリングが満杯とみなす
+/// @tparam kCapacity リングに積めるバイト数 (2 のべき乗)
+/// @tparam kMaxChunks 積んでおける Write の数 (2 のべき乗)
+template <size_t kCapacity = 256, size_t kMaxChunks = 16>
+class TxQueue {
+  static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0,
+                "kCapacity must be a power of two");
+  static_assert(kMaxChunks > 0 && (kMaxChunks & (kMaxChunks - 1)) == 0,
+                "kMaxChunks must be a power of two");
+
+ public:
+  /// @brief data を積む
+  /// @param wait kBlock で空きを待つ間に呼ぶ (送信割り込みを有効にして眠る)
+  /// @return 積んだバイト数
+  template <typename Wait>
+  size_t Write(uint8_t const* data, size_t size, TxFullPolicy policy,
+               Wait&& wait) {
+    switch (policy) {
+      case TxFullPolicy::kFail:
+        if (size > Free() || ChunksFull()) {
+          dropped_.fetch_add(size, std::memory_order_relaxed);
+          return 0;
+        }
+        Push(data, size);
+        return size;
+
+      case TxFullPolicy::kTruncate: {
+        auto const n = ChunksFull() ? 0 : Min(size, Free());
+        Push(data, n);
+        dropped_.fetch_add(size - n, std::memory_order_relaxed);
+        return n;
+      }
+
+      case TxFullPolicy::kBlock:
+        for (size_t written = 0; written < size;) {
+          auto const n = ChunksFull() ? 0 : Min(size - written, Free());
+          if (n == 0) {
+            wait();
+            continue;
+          }
+          Push(data + written, n);
+          written += n;
+        }
+        return size;
+    }
+    return 0;
+  }
+
+  /// @brief writable() の間 put(byte) で送信レジスタに書く
+  /// @return まだ送るものが残っていれば true
+  template <typename Writable, typename Put, typename OnChunk>
+  bool Drain(Writable&& writable, Put&& put, OnChunk&& on_chunk) {
+    while (remaining_ > 0 || !Empty()) {
+      if (remaining_ == 0) {
+        auto const tail = chunk_tail_.load(std::memory_order_relaxed);
+        chunk_ = chunks_[tail & (kMaxChunks - 1)];
+        remaining_ = chunk_;
+      }
+      if (!writable()) {
+        return true;
+      }
+      auto const tail = byte_tail_.load(std::memory_order_relaxed);
+      put(bytes_[(tail + chunk_ - remaining_) & (kCapacity - 1)]);
+      if (--remaining_ == 0) {
+        Complete(on_chunk);
+      }
+    }
+    return false;
+  }
+
+  /// @note 送り途中のチャンクは送り終えるまで残るので、remaining_ は見ない
+  [[nodiscard]] bool Empty() const {
+    return chunk_head_.load(std::memory_order_acquire) ==
+           chunk_tail_.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] size_t Free() const {
+    return kCapacity - (byte_head_.load(std::memory_order_relaxed) -
+                        byte_tail_.load(std::memory_order_acquire));
+  }
+
+  /// kFail / kTruncate で捨てたバイト数
+  [[nodiscard]] size_t Dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static size_t Min(size_t a, size_t b) { return a < b ? a : b; }
+
+  // Write 側
+  [[nodiscard]] bool ChunksFull() const {
+    return chunk_head_.load(std::memory_order_relaxed) -
+               chunk_tail_.load(std::memory_order_acquire) ==
+           kMaxChunks;
+  }
+
+  // Write 側
+  void Push(uint8_t const* data, size_t size) {
+    if (size == 0) {
+      return;
+    }
+    auto const head = byte_head_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < size; i++) {
+      bytes_[(head + i) & (kCapacity - 1)] = data[i];
+    }
+    byte_head_.store(head + size, std::memory_order_relaxed);
+
+    // チャンクはバイトを積んでから見せる (release で順序を保証する)
+    auto const chunk = chunk_head_.load(std::memory_order_relaxed);
+    chunks_[chunk & (kMaxChunks - 1)] = size;
+    chunk_head_.store(chunk + 1, std::memory_order_release);
+  }
+
+  // Drain 側。空いた領域は release で Write 側に返す
+  template <typename OnChunk>
+  void Complete(OnChunk& on_chunk) {
+    auto const tail = byte_tail_.load(std::memory_order_relaxed);
+    auto const start = tail & (kCapacity - 1);
+    auto const first = Min(chunk_, kCapacity - start);
+    on_chunk(&bytes_[start], first);
+    if (first < chunk_) {
+      on_chunk(&bytes_[0], chunk_ - first);
+    }
+    byte_tail_.store(tail + chunk_, std::memory_order_release);
+    chunk_tail_.store(chunk_tail_.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_release);
+  }
+
+  std::array<uint8_t, kCapacity> bytes_{};
+  std::array<size_t, kMaxChunks> chunks_{};
+  // 通算の位置 (添字は 2 のべき乗で割った余り)。head は Write 側、
+  // tail は Drain 側だけが書く
+  std::atomic<size_t> byte_head_{0};
+  std::atomic<size_t> byte_tail_{0};
+  std::atomic<size_t> chunk_head_{0};
+  std::atomic<size_t> chunk_tail_{0};
+  // Write 側が書き、どこからでも読む
+  std::atomic<size_t> dropped_{0};
+  // ここから下は Drain 側だけが触る
+  size_t chunk_ = 0;
+  size_t remaining_ = 0;
+};
+
+}  // namespace nano_hw::uart
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+#include <NanoHW/async.hpp>
+
+using nano_hw::HighResClockDuration;
+using nano_hw::async::FramePool;
+using nano_hw::async::Scheduler;
+using nano_hw::async::SleepFor;
+using nano_hw::async::Task;
+using nano_hw::async::WaitUntil;
+using nano_hw::async::Yield;
+using namespace std::chrono_literals;
+
+namespace {
+HighResClockDuration fake_now{0};
+HighResClockDuration FakeNow() {
+  return fake_now;
+}
+
+Task<int> Add(int a, int b) {
+  co_await Yield();
+  co_return a + b;
+}
+
+Task<> Sum(int* out) {
+  int const x = co_await Add(1, 2);
+  int const y = co_await Add(x, 10);
+  *out = y;
+}
+
+Task<> Sleeper(std::vector<int>* log, int id, HighResClockDuration wait) {
+  co_await SleepFor(wait);
+  log->push_back(id);
+}
+
+/// プールを使い切ってから、確保できなかった子を co_await する
+Task<> AwaitUnallocatedChild(int* out) {
+  std::vector<Task<int>> held;
+  while (true) {
+    auto child = Add(1, 1);
+    if (!child.Valid()) {
+      *out = co_await child;
+      co_return;
+    }
+    held.push_back(std::move(child));
+  }
+}
+
+Task<> Waiter(bool* flag, int* out) {
+  co_await WaitUntil([](void* ctx) { return *static_cast<bool*>(ctx); },
+                     flag);
+  *out = 1;
+}
+}  // namespace
+
+// 子 Task の co_await で値を受け取れること
+TEST(AsyncTest, AwaitChildTask) {
+  Scheduler scheduler(&FakeNow);
+  int result = 0;
+
+  EXPECT_TRUE(scheduler.Spawn(Sum(&result)));
+  scheduler.Run();
+
+  EXPECT_EQ(result, 13);
+  EXPECT_EQ(FramePool::InUse(), 0);
+}
+
+// SleepFor が時刻順に再開されること
+TEST(AsyncTest, SleepForOrdersByDeadline) {
+  Scheduler scheduler(&FakeNow);
+  std::vector<int> log;
+  fake_now = 0ms;
+
+  scheduler.Spawn(Sleeper(&log, 1, 30ms));
+  scheduler.Spawn(Sleeper(&log, 2, 10ms));
+  scheduler.Spawn(Sleeper(&log, 3, 20ms));
+
+  scheduler.RunOnce();
+  EXPECT_TRUE(log.empty());
+
+  for (int t = 0; t <= 30; t += 5) {
+    fake_now = HighResClockDuration(t);
+    scheduler.RunOnce();
+  }
+
+  EXPECT_EQ(log, (std::vector<int>{2, 3, 1}));
+  EXPECT_EQ(scheduler.Alive(), 0);
+}
+
+// WaitUntil は条件が成立するまで再開されないこと
+TEST(AsyncTest, WaitUntilPolls) {
+  Scheduler scheduler(&FakeNow);
+  bool flag = false;
+  int result = 0;
+
+  scheduler.Spawn(Waiter(&flag, &result));
+  scheduler.RunOnce();
+  scheduler.RunOnce();
+  EXPECT_EQ(result, 0);
+
+  flag = true;
+  scheduler.RunOnce();
+  EXPECT_EQ(result, 1);
+}
+
+// フレームプールが尽きると Spawn が失敗し、ヒープに落ちないこと
+TEST(AsyncTest, FramePoolExhaustion) {
+  Scheduler scheduler(&FakeNow);
+  std::vector<Task<int>> tasks;
+
+  for (size_t i = 0; i < FramePool::kFrameCount; i++) {
+    tasks.push_back(Add(1, 1));
+    EXPECT_TRUE(tasks.back().Valid());
+  }
+  EXPECT_FALSE(Add(1, 1).Valid());
+
+  bool flag = false;
+  int result = 0;
+  EXPECT_FALSE(scheduler.Spawn(Waiter(&flag, &result)));
+
+  tasks.clear();
+  EXPECT_EQ(FramePool::InUse(), 0);
+}
+
+// 確保できなかった子を co_await すると黙って T{} を返さずに止まること
+TEST(AsyncDeathTest, AwaitUnallocatedChildTraps) {
+  EXPECT_DEATH(
+      {
+        Scheduler scheduler(&FakeNow);
+        int result = -1;
+        scheduler.Spawn(AwaitUnallocatedChild(&result));
+        scheduler.Run();
+      },
+      "");
+}
+
+// 完了前に Scheduler を破棄してもフレームが解放されること
+TEST(AsyncTest, SchedulerDestroysPendingTasks) {
+  {
+    Scheduler scheduler(&FakeNow);
+    bool flag = false;
+    int result = 0;
+    scheduler.Spawn(Waiter(&flag, &result));
+    scheduler.RunOnce();
+    EXPECT_EQ(FramePool::InUse(), 1);
+  }
+  EXPECT_EQ(FramePool::InUse(), 0);
+}
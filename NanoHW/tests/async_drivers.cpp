@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include <NanoHW/async_can.hpp>
+#include <NanoHW/async_uart.hpp>
+#include "can.hpp"
+#include "uart.hpp"
+
+using nano_hw::HighResClockDuration;
+using nano_hw::Pin;
+using nano_hw::async::AsyncCAN;
+using nano_hw::async::AsyncUART;
+using nano_hw::async::Scheduler;
+using nano_hw::async::Task;
+using nano_hw::can::CANMessage;
+
+namespace {
+HighResClockDuration FakeNow() {
+  return HighResClockDuration(0);
+}
+
+using CAN = AsyncCAN<nano_stub::MockCAN>;
+using UART = AsyncUART<nano_stub::MockUART>;
+
+Task<> EchoOnce(CAN* can) {
+  auto msg = co_await can->Receive();
+  msg.id += 1;
+  can->Send(msg);
+}
+
+Task<> ReceiveN(CAN* can, int n, uint32_t* ids) {
+  for (int i = 0; i < n; i++) {
+    auto const msg = co_await can->Receive();
+    ids[i] = msg.id;
+  }
+}
+
+Task<> ReadLines(UART* uart, std::string* lines, int n) {
+  for (int i = 0; i < n; i++) {
+    auto line = co_await uart->ReadUntil('\n');
+    lines[i].assign(line.data(), line.data() + line.size());
+  }
+}
+}  // namespace
+
+// 受信コールバック経由で Receive が再開されること
+TEST(AsyncCANTest, ReceiveResumesOnCallback) {
+  Scheduler scheduler(&FakeNow);
+  CAN can(Pin{1}, Pin{2}, 1000000);
+  uint32_t ids[3] = {};
+
+  scheduler.Spawn(ReceiveN(&can, 3, ids));
+  scheduler.RunOnce();
+  EXPECT_EQ(scheduler.Alive(), 1);
+
+  CANMessage msg{};
+  for (uint32_t id : {0x100u, 0x200u, 0x300u}) {
+    msg.id = id;
+    can.GetDriver().SimulateReceive(msg);
+    scheduler.RunOnce();
+  }
+
+  EXPECT_EQ(scheduler.Alive(), 0);
+  EXPECT_EQ(ids[0], 0x100u);
+  EXPECT_EQ(ids[1], 0x200u);
+  EXPECT_EQ(ids[2], 0x300u);
+}
+
+// 受信済みなら suspend せずに値が返ること
+TEST(AsyncCANTest, ReceiveAlreadyQueued) {
+  Scheduler scheduler(&FakeNow);
+  CAN can(Pin{1}, Pin{2}, 1000000);
+
+  CANMessage msg{};
+  msg.id = 0x10;
+  can.GetDriver().SimulateReceive(msg);
+
+  scheduler.Spawn(EchoOnce(&can));
+  scheduler.RunOnce();
+  EXPECT_EQ(scheduler.Alive(), 0);
+}
+
+// 分割して届いた行を ReadUntil で受け取れること
+TEST(AsyncUARTTest, ReadUntilDelimiter) {
+  Scheduler scheduler(&FakeNow);
+  UART uart(Pin{1}, Pin{2}, 115200);
+  std::string lines[2];
+
+  scheduler.Spawn(ReadLines(&uart, lines, 2));
+  scheduler.RunOnce();
+
+  std::string const part1 = "hel";
+  std::string const part2 = "lo\nwor";
+  std::string const part3 = "ld\n";
+  for (auto const* part : {&part1, &part2, &part3}) {
+    uart.GetDriver().SimulateReceive(
+        reinterpret_cast<const uint8_t*>(part->data()), part->size());
+    scheduler.RunOnce();
+  }
+
+  EXPECT_EQ(scheduler.Alive(), 0);
+  EXPECT_EQ(lines[0], "hello");
+  EXPECT_EQ(lines[1], "world");
+}
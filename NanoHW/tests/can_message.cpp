@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+
+#include <NanoHW/can_message.hpp>
+
+using nano_hw::can::CANMessage;
+using nano_hw::can::CANMessageFormat;
+using nano_hw::HighResClockDuration;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// 呼ばれた回数を数える固定時刻のクロック
+struct FixedClock {
+  static inline HighResClockDuration now{0};
+  static inline int calls = 0;
+
+  static HighResClockDuration Now() {
+    calls++;
+    return now;
+  }
+};
+
+struct DefaultConfig {};
+struct ClockConfig {
+  using Clock = FixedClock;
+};
+
+/// Config::Clock が無いときに使われるクロック (常に 1 ms)
+struct BackendClock {
+  static HighResClockDuration Now() { return 1ms; }
+};
+
+}  // namespace
+
+// classic ではキャッシュライン 1 本に 4 フレーム入ること
+TEST(CANMessageTest, Layout) {
+#if NANO_HW_CAN_FD
+  static_assert(sizeof(CANMessage) == 72);
+#else
+  static_assert(sizeof(CANMessage) * 4 == 64);
+#endif
+  EXPECT_EQ(alignof(CANMessage), 8u);
+
+  CANMessage msgs[4];
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(msgs[0].data) % 8, 0u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(msgs[1].data) % 8, 0u);
+}
+
+// 既定値が標準フォーマットのデータフレームになること
+TEST(CANMessageTest, Defaults) {
+  CANMessage msg{};
+  EXPECT_EQ(msg.id, 0u);
+  EXPECT_EQ(msg.len, 0);
+  EXPECT_EQ(msg.Format(), CANMessageFormat::kStandard);
+  EXPECT_FALSE(msg.IsRemote());
+  EXPECT_FALSE(msg.HasTimestamp());
+  EXPECT_FALSE(msg.IsFD());
+  EXPECT_EQ(msg.data[7], 0);
+}
+
+// フォーマットと RTR が flags に入り、他のフラグを壊さないこと
+TEST(CANMessageTest, FormatAndRemoteFlags) {
+  CANMessage msg{};
+  msg.flags = CANMessage::kFlagBRS;
+  msg.SetFormat(CANMessageFormat::kExtended);
+  msg.SetRemote(true);
+  EXPECT_EQ(msg.Format(), CANMessageFormat::kExtended);
+  EXPECT_TRUE(msg.IsRemote());
+  EXPECT_TRUE(msg.BitrateSwitch());
+
+  msg.SetFormat(CANMessageFormat::kStandard);
+  msg.SetRemote(false);
+  EXPECT_EQ(msg.Format(), CANMessageFormat::kStandard);
+  EXPECT_FALSE(msg.IsRemote());
+  EXPECT_EQ(msg.flags, CANMessage::kFlagBRS);
+}
+
+// 16 ビットの受信時刻が一周をまたいでも元の時刻に戻ること
+TEST(CANMessageTest, TimestampWraparound) {
+  CANMessage msg{};
+  msg.SetTimestamp(65530ms);
+  EXPECT_TRUE(msg.HasTimestamp());
+  EXPECT_EQ(msg.Timestamp(65535ms), 65530ms);
+  EXPECT_EQ(msg.Timestamp(65540ms), 65530ms);
+
+  msg.SetTimestamp(200000ms);
+  EXPECT_EQ(msg.Timestamp(200010ms), 200000ms);
+}
+
+// Config::Clock が優先され、既に付いている時刻は上書きされないこと
+TEST(CANMessageTest, StampReceived) {
+  CANMessage msg{};
+  nano_hw::can::StampReceived<DefaultConfig, BackendClock>(msg);
+  EXPECT_EQ(msg.Timestamp(2ms), 1ms);
+
+  FixedClock::now = 500ms;
+  FixedClock::calls = 0;
+  CANMessage fresh{};
+  nano_hw::can::StampReceived<ClockConfig, BackendClock>(fresh);
+  EXPECT_EQ(fresh.Timestamp(600ms), 500ms);
+  EXPECT_EQ(FixedClock::calls, 1);
+
+  // ハードウェアで付けた時刻を優先する
+  nano_hw::can::StampReceived<ClockConfig, BackendClock>(msg);
+  EXPECT_EQ(msg.Timestamp(2ms), 1ms);
+  EXPECT_EQ(FixedClock::calls, 1);
+}
+
+// ペイロードが 8 バイトまとめてコピーされること
+TEST(CANMessageTest, CopyPayload) {
+  uint8_t src[CANMessage::kPayloadSize] = {};
+  for (size_t i = 0; i < sizeof(src); i++) {
+    src[i] = static_cast<uint8_t>(i + 1);
+  }
+  CANMessage msg{};
+  msg.len = 3;
+  msg.CopyPayloadFrom(src);
+  EXPECT_EQ(msg.data[7], 8);
+
+  uint8_t dst[CANMessage::kPayloadSize] = {};
+  msg.CopyPayloadTo(dst);
+  for (size_t i = 0; i < sizeof(dst); i++) {
+    EXPECT_EQ(dst[i], src[i]);
+  }
+}
+
+// DLC とバイト数の相互変換
+TEST(CANMessageTest, Dlc) {
+  EXPECT_EQ(nano_hw::can::DlcToLength(8, false), 8);
+  EXPECT_EQ(nano_hw::can::DlcToLength(9, false), 8);
+  EXPECT_EQ(nano_hw::can::DlcToLength(9, true), 12);
+  EXPECT_EQ(nano_hw::can::DlcToLength(15, true), 64);
+
+  EXPECT_EQ(nano_hw::can::LengthToDlc(5), 5);
+  EXPECT_EQ(nano_hw::can::LengthToDlc(13), 10);
+  EXPECT_EQ(nano_hw::can::LengthToDlc(64), 15);
+  EXPECT_EQ(nano_hw::can::PaddedLength(33), 48);
+}
+
+#if NANO_HW_CAN_FD
+// FD では 64 バイトのペイロードと FDF / BRS を持てること
+TEST(CANMessageTest, FDFrame) {
+  static_assert(nano_hw::can::kCANMaxPayload == 64);
+
+  CANMessage msg{};
+  msg.flags = CANMessage::kFlagFD | CANMessage::kFlagBRS;
+  msg.len = 64;
+  msg.data[63] = 0xAB;
+
+  EXPECT_TRUE(msg.IsFD());
+  EXPECT_TRUE(msg.BitrateSwitch());
+  EXPECT_EQ(msg.Dlc(), 15);
+  EXPECT_EQ(msg.data[63], 0xAB);
+}
+#endif
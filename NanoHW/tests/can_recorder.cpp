@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <NanoHW/can_recorder.hpp>
+#include <can_log.hpp>
+
+using nano_hw::HighResClockDuration;
+using nano_hw::can::CANMessage;
+using nano_hw::can::CANMessageFormat;
+using nano_hw::can::CANRecord;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// テストから進める時計
+struct FakeClock {
+  static inline HighResClockDuration now{0};
+  static HighResClockDuration Now() { return now; }
+};
+
+/// SimulateReceive に渡されたフレームを溜める (MockCAN の代わり)
+struct FakeTarget {
+  std::vector<CANMessage> frames;
+  std::vector<std::chrono::steady_clock::time_point> times;
+
+  void SimulateReceive(CANMessage msg) {
+    frames.push_back(msg);
+    times.push_back(std::chrono::steady_clock::now());
+  }
+};
+
+CANMessage MakeFrame(uint32_t id, uint8_t len) {
+  CANMessage msg{};
+  msg.id = id;
+  msg.len = len;
+  for (uint8_t i = 0; i < len; i++) {
+    msg.data[i] = static_cast<uint8_t>(id + i);
+  }
+  return msg;
+}
+
+std::string LogPath(const char* name) {
+  return testing::TempDir() + name;
+}
+
+}  // namespace
+
+// 受信時刻があればそれを、なければ記録時の時刻を使うこと
+TEST(CANRecorderTest, RecordAndDrain) {
+  nano_hw::can::CANRecorder<FakeClock, 8> recorder(2);
+
+  FakeClock::now = 1000ms;
+  auto rx = MakeFrame(0x100, 8);
+  rx.SetFormat(CANMessageFormat::kExtended);
+  rx.SetTimestamp(990ms);
+  decltype(recorder)::RxHook::execute(static_cast<void*>(&recorder), rx);
+
+  FakeClock::now = 1005ms;
+  decltype(recorder)::TxHook::execute(static_cast<void*>(&recorder),
+                                      MakeFrame(0x200, 3));
+
+  std::vector<CANRecord> records;
+  EXPECT_EQ(recorder.Drain([&](CANRecord const& r) { records.push_back(r); }),
+            2u);
+  ASSERT_EQ(records.size(), 2u);
+
+  EXPECT_EQ(records[0].time_ms, 990u);
+  EXPECT_EQ(records[0].bus, 2);
+  EXPECT_EQ(records[0].direction, CANRecord::kRx);
+  EXPECT_EQ(records[0].ToMessage().Format(), CANMessageFormat::kExtended);
+  EXPECT_FALSE(records[0].ToMessage().HasTimestamp());
+
+  EXPECT_EQ(records[1].time_ms, 1005u);
+  EXPECT_EQ(records[1].direction, CANRecord::kTx);
+  EXPECT_EQ(records[1].len, 3);
+  EXPECT_EQ(records[1].data[2], 0x202 & 0xFF);
+}
+
+// リングが満杯なら捨てて数えること
+TEST(CANRecorderTest, DropsWhenFull) {
+  nano_hw::can::CANRecorder<FakeClock, 4> recorder;
+  for (uint32_t i = 0; i < 6; i++) {
+    recorder.RecordRx(MakeFrame(i, 1));
+  }
+  EXPECT_EQ(recorder.Dropped(), 2u);
+  EXPECT_EQ(recorder.Drain([](CANRecord const&) {}), 4u);
+}
+
+// mmap したファイルに書いたものをそのまま読み戻せること
+TEST(CANLogTest, WriteAndRead) {
+  auto const path = LogPath("can_log_roundtrip.ncan");
+  nano_hw::can::CANRecorder<FakeClock, 64> recorder;
+  for (uint32_t i = 0; i < 50; i++) {
+    FakeClock::now = HighResClockDuration(i * 10);
+    recorder.RecordRx(MakeFrame(0x300 + i, 8));
+  }
+
+  {
+    nano_stub::CANLogWriter writer;
+    ASSERT_TRUE(writer.Open(path.c_str(), 40));
+    recorder.Drain(writer);
+    EXPECT_EQ(writer.Size(), 40u);
+    writer.Flush();
+  }
+
+  nano_stub::CANLogReader reader;
+  ASSERT_TRUE(reader.Open(path.c_str()));
+  ASSERT_EQ(reader.Size(), 40u);
+  EXPECT_EQ(reader[39].id, 0x300u + 39);
+  EXPECT_EQ(reader[39].time_ms, 390u);
+  EXPECT_EQ(reader[39].data[7], static_cast<uint8_t>(0x300 + 39 + 7));
+}
+
+// 形式の違うファイルは開かないこと
+TEST(CANLogTest, RejectsForeignFile) {
+  auto const path = LogPath("can_log_foreign.ncan");
+  {
+    nano_stub::CANLogWriter writer;
+    ASSERT_TRUE(writer.Open(path.c_str(), 4));
+  }
+  nano_stub::CANLogReader reader;
+  EXPECT_TRUE(reader.Open(path.c_str()));
+  EXPECT_EQ(reader.Size(), 0u);
+
+  EXPECT_FALSE(reader.Open(LogPath("can_log_missing.ncan").c_str()));
+}
+
+// 記録時の間隔 (倍速指定あり) で受信フレームだけを流すこと
+TEST(CANLogTest, Replay) {
+  auto const path = LogPath("can_log_replay.ncan");
+  {
+    nano_hw::can::CANRecorder<FakeClock, 8> recorder;
+    FakeClock::now = 5000ms;
+    recorder.RecordRx(MakeFrame(0x10, 1));
+    FakeClock::now = 5040ms;
+    recorder.RecordTx(MakeFrame(0x20, 1));
+    FakeClock::now = 5080ms;
+    recorder.RecordRx(MakeFrame(0x30, 1));
+
+    nano_stub::CANLogWriter writer;
+    ASSERT_TRUE(writer.Open(path.c_str(), 8));
+    recorder.Drain(writer);
+  }
+
+  nano_stub::CANLogReader reader;
+  ASSERT_TRUE(reader.Open(path.c_str()));
+
+  FakeTarget fast;
+  EXPECT_EQ(nano_stub::Replay(reader, fast, {.speed = 0.0F}), 2u);
+  ASSERT_EQ(fast.frames.size(), 2u);
+  EXPECT_EQ(fast.frames[1].id, 0x30u);
+
+  // 80 ms の記録を 4 倍速で流すと 20 ms 以上かかる
+  FakeTarget timed;
+  EXPECT_EQ(
+      nano_stub::Replay(reader, timed, {.speed = 4.0F, .include_tx = true}),
+      3u);
+  ASSERT_EQ(timed.frames.size(), 3u);
+  EXPECT_EQ(timed.frames[1].id, 0x20u);
+  EXPECT_GE(timed.times[2] - timed.times[0], 20ms);
+}
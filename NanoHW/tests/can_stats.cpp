@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+
+#include <NanoHW/can_stats.hpp>
+
+using nano_hw::HighResClockDuration;
+using nano_hw::can::CANMessage;
+using nano_hw::can::CANMessageFormat;
+using nano_hw::can::CANStatsSnapshot;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// テストから進める時計
+struct FakeClock {
+  static inline HighResClockDuration now{0};
+  static HighResClockDuration Now() { return now; }
+};
+
+using Stats = nano_hw::can::CANStats<FakeClock>;
+
+CANMessage MakeFrame(uint32_t id, uint8_t len,
+                     CANMessageFormat format = CANMessageFormat::kStandard) {
+  CANMessage msg{};
+  msg.id = id;
+  msg.len = len;
+  msg.SetFormat(format);
+  return msg;
+}
+
+}  // namespace
+
+// 最悪ケースのビット数が既知の値 (標準 135 / 拡張 160) になること
+TEST(CANStatsTest, FrameBits) {
+  auto const standard = nano_hw::can::EstimateFrameBits(MakeFrame(0x123, 8));
+  EXPECT_EQ(standard.nominal_bits, 135u);
+  EXPECT_EQ(standard.data_bits, 0u);
+
+  auto const extended = nano_hw::can::EstimateFrameBits(
+      MakeFrame(0x123, 8, CANMessageFormat::kExtended));
+  EXPECT_EQ(extended.nominal_bits, 160u);
+
+  auto remote = MakeFrame(0x123, 8);
+  remote.SetRemote(true);
+  EXPECT_EQ(nano_hw::can::EstimateFrameBits(remote).nominal_bits, 55u);
+}
+
+// 2 回の Snapshot の差からバス負荷と ID ごとのレートが出ること
+TEST(CANStatsTest, BusLoadAndRate) {
+  FakeClock::now = 1000ms;
+  Stats stats;
+  stats.SetBitrate(500000);
+
+  CANStatsSnapshot before;
+  ASSERT_TRUE(stats.Snapshot(before));
+
+  // 500 kbps で 135 bit = 270 us のフレームを 100 ms に 100 個
+  for (int i = 0; i < 100; i++) {
+    auto const msg = MakeFrame(i % 2 == 0 ? 0x100 : 0x200, 8);
+    if (i % 4 == 0) {
+      stats.OnReceive(msg);
+    } else {
+      stats.OnTransmit(msg, FakeClock::Now());
+    }
+  }
+  FakeClock::now += 100ms;
+
+  CANStatsSnapshot after;
+  stats.Snapshot(after);
+  EXPECT_EQ(after.tx_frames - before.tx_frames, 75u);
+  EXPECT_EQ(after.rx_frames - before.rx_frames, 25u);
+  EXPECT_NEAR(after.BusLoad(before), 0.27F, 1e-4F);
+  EXPECT_NEAR(after.FramesPerSecond(before, 0x100), 500.0F, 1e-3F);
+  EXPECT_NEAR(after.FramesPerSecond(before, 0x200), 500.0F, 1e-3F);
+  EXPECT_EQ(after.FramesPerSecond(before, 0x100, CANMessageFormat::kExtended),
+            0.0F);
+}
+
+// ID テーブルからあふれた分は other_frames に数えること
+TEST(CANStatsTest, IdTableOverflow) {
+  Stats stats;
+  for (uint32_t id = 0; id < CANStatsSnapshot::kIdSlots + 8; id++) {
+    stats.OnReceive(MakeFrame(id, 1));
+  }
+
+  CANStatsSnapshot snapshot;
+  stats.Snapshot(snapshot);
+  EXPECT_EQ(snapshot.other_frames, 8u);
+  for (uint32_t id = 0; id < CANStatsSnapshot::kIdSlots; id++) {
+    EXPECT_EQ(snapshot.FramesOf(id), 1u);
+  }
+}
+
+// 受信時刻からの遅延と送信待ちが 2 のべき乗のバケットに入ること
+TEST(CANStatsTest, LatencyHistogram) {
+  FakeClock::now = 10ms;
+  Stats stats;
+
+  auto msg = MakeFrame(0x10, 8);
+  msg.SetTimestamp(FakeClock::Now());
+  FakeClock::now = 13ms;
+  stats.OnReceive(msg);
+
+  FakeClock::now = 200ms;
+  stats.OnReceive(msg);
+
+  // 時刻の付いていないフレームは数えない
+  stats.OnReceive(MakeFrame(0x10, 8));
+
+  stats.OnTransmit(msg, FakeClock::Now());
+
+  CANStatsSnapshot snapshot;
+  stats.Snapshot(snapshot);
+  EXPECT_EQ(snapshot.rx_latency[2], 1u);
+  EXPECT_EQ(snapshot.rx_latency[CANStatsSnapshot::kBuckets - 1], 1u);
+  EXPECT_EQ(snapshot.tx_wait[0], 1u);
+  EXPECT_EQ(snapshot.rx_frames, 3u);
+}
+
+// エラーカウンタの最新値と最大値を保持すること
+TEST(CANStatsTest, ErrorSampling) {
+  Stats stats;
+  stats.SampleErrors(10, 3);
+  stats.SampleErrors(4, 96);
+  stats.OnBusError();
+  stats.OnPassiveError();
+  stats.OnTransmitFailed();
+
+  CANStatsSnapshot snapshot;
+  stats.Snapshot(snapshot);
+  EXPECT_EQ(snapshot.transmit_errors, 4);
+  EXPECT_EQ(snapshot.receive_errors, 96);
+  EXPECT_EQ(snapshot.max_transmit_errors, 10);
+  EXPECT_EQ(snapshot.max_receive_errors, 96);
+  EXPECT_EQ(snapshot.bus_errors, 1u);
+  EXPECT_EQ(snapshot.passive_errors, 1u);
+  EXPECT_EQ(snapshot.tx_failed, 1u);
+}
+
+// 統計なしでは Snapshot が false を返すこと
+TEST(CANStatsTest, Disabled) {
+  nano_hw::can::NoCANStats stats;
+  CANStatsSnapshot snapshot;
+  EXPECT_FALSE(stats.Snapshot(snapshot));
+}
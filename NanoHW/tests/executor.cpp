@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+
+#include <NanoHW/executor.hpp>
+#include "rtos.hpp"
+#include "thread.hpp"
+
+using nano_hw::executor::Executor;
+using nano_hw::executor::Task;
+using nano_hw::executor::WorkStealingDeque;
+
+namespace {
+void Increment(void* ctx) {
+  static_cast<std::atomic<int>*>(ctx)->fetch_add(1);
+}
+
+int values[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+Task MakeTask(int i) {
+  return Task{[](void*) {}, &values[i]};
+}
+}  // namespace
+
+// 所有者側は LIFO, Steal 側は FIFO で取り出せること
+TEST(WorkStealingDequeTest, TakeAndSteal) {
+  WorkStealingDeque<4> deque;
+
+  EXPECT_TRUE(deque.Push(MakeTask(0)));
+  EXPECT_TRUE(deque.Push(MakeTask(1)));
+  EXPECT_TRUE(deque.Push(MakeTask(2)));
+  EXPECT_EQ(deque.Size(), 3);
+
+  EXPECT_EQ(deque.Take()->ctx, &values[2]);
+  EXPECT_EQ(deque.Steal()->ctx, &values[0]);
+  EXPECT_EQ(deque.Take()->ctx, &values[1]);
+
+  EXPECT_FALSE(deque.Take().has_value());
+  EXPECT_FALSE(deque.Steal().has_value());
+  EXPECT_TRUE(deque.Empty());
+}
+
+// 容量を超えた Push は失敗し、ラップアラウンド後も使えること
+TEST(WorkStealingDequeTest, CapacityAndWrapAround) {
+  WorkStealingDeque<4> deque;
+
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 4; i++) {
+      EXPECT_TRUE(deque.Push(MakeTask(i)));
+    }
+    EXPECT_FALSE(deque.Push(MakeTask(4)));
+
+    for (int i = 0; i < 4; i++) {
+      EXPECT_EQ(deque.Steal()->ctx, &values[i]);
+    }
+    EXPECT_TRUE(deque.Empty());
+  }
+}
+
+// 投入した全タスクがちょうど 1 回ずつ実行されること
+TEST(ExecutorTest, RunsAllTasks) {
+  Executor<nano_stub::PosixThread, 4> executor;
+  std::atomic<int> counter{0};
+  constexpr int kTasks = 10000;
+
+  executor.Start();
+  for (int i = 0; i < kTasks; i++) {
+    while (!executor.Submit(Increment, &counter)) {
+      std::this_thread::yield();
+    }
+  }
+  executor.WaitIdle();
+
+  EXPECT_EQ(counter.load(), kTasks);
+  EXPECT_EQ(executor.Pending(), 0);
+
+  size_t executed = 0;
+  for (size_t i = 0; i < executor.Workers(); i++) {
+    executed += executor.Executed(i);
+  }
+  EXPECT_EQ(executed, static_cast<size_t>(kTasks));
+}
+
+// 1 つのワーカーが塞がっていても、残りのタスクは他ワーカーが
+// (取り込まれていれば奪って) 全て実行すること
+TEST(ExecutorTest, StealsFromBlockedWorker) {
+  Executor<nano_stub::PosixThread, 2> executor;
+  constexpr int kQuickTasks = 7;
+  std::atomic<int> quick{0};
+
+  // 最初に取り出されるタスク。そのワーカーの deque はまだ空なので、
+  // 他のタスクを全部別のワーカーが片付けるまで、このワーカーは塞がる
+  executor.Submit(
+      [](void* ctx) {
+        auto* done = static_cast<std::atomic<int>*>(ctx);
+        while (done->load() < kQuickTasks) {
+          nano_hw::parallel::SleepForMS(std::chrono::milliseconds(1));
+        }
+      },
+      &quick);
+  for (int i = 0; i < kQuickTasks; i++) {
+    executor.Submit(Increment, &quick);
+  }
+  executor.Start();
+  executor.WaitIdle();
+
+  EXPECT_EQ(quick.load(), kQuickTasks);
+  auto const blocked = executor.Executed(0) == 1 ? 0 : 1;
+  EXPECT_EQ(executor.Executed(blocked), 1u);
+  EXPECT_EQ(executor.Executed(1 - blocked),
+            static_cast<size_t>(kQuickTasks));
+  EXPECT_EQ(executor.Stolen(blocked), 0u);
+}
+
+// タスク内から Submit できること
+TEST(ExecutorTest, SubmitFromTask) {
+  Executor<nano_stub::PosixThread, 2> executor;
+
+  struct Context {
+    Executor<nano_stub::PosixThread, 2>* executor;
+    std::atomic<int> counter{0};
+  } ctx{&executor};
+
+  executor.Start();
+  executor.Submit(
+      [](void* p) {
+        auto* ctx = static_cast<Context*>(p);
+        for (int i = 0; i < 16; i++) {
+          ctx->executor->Submit(Increment, &ctx->counter);
+        }
+      },
+      &ctx);
+  executor.WaitIdle();
+
+  EXPECT_EQ(ctx.counter.load(), 16);
+}
+
+// Stop は未完了タスクを実行し終えてから戻ること
+TEST(ExecutorTest, StopDrainsPendingTasks) {
+  std::atomic<int> counter{0};
+  {
+    Executor<nano_stub::PosixThread, 2> executor;
+    for (int i = 0; i < 100; i++) {
+      executor.Submit(Increment, &counter);
+    }
+    executor.Start();
+  }
+
+  EXPECT_EQ(counter.load(), 100);
+}
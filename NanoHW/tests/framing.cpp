@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <NanoHW/framing.hpp>
+
+using nano_hw::uart::framing::Cobs;
+using nano_hw::uart::framing::Slip;
+using nano_hw::uart::framing::Span;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+/// OnFrame で受け取ったペイロードを溜める
+struct Collector {
+  std::vector<Bytes> frames;
+
+  static void OnFrame(void* context, Span<uint8_t const> frame) {
+    static_cast<Collector*>(context)->frames.emplace_back(frame.begin(),
+                                                          frame.end());
+  }
+};
+
+struct CollectorConfig {
+  using OnFrame = nano_hw::Direct<&Collector::OnFrame>;
+};
+
+template <typename C>
+using Decoder =
+    nano_hw::uart::framing::FrameDecoder<C, CollectorConfig, 300>;
+
+template <typename C>
+Bytes Encode(Bytes const& payload) {
+  Bytes out(nano_hw::uart::framing::MaxFrameSize<C>(payload.size()));
+  auto const size = nano_hw::uart::framing::EncodeFrame<C>(
+      {payload.data(), payload.size()}, {out.data(), out.size()});
+  out.resize(size);
+  return out;
+}
+
+template <typename C>
+Bytes Raw(Bytes const& payload) {
+  Bytes out(C::MaxEncodedSize(payload.size()));
+  typename C::Writer writer({out.data(), out.size()});
+  for (auto byte : payload) {
+    writer.Put(byte);
+  }
+  out.resize(writer.Finish());
+  return out;
+}
+
+/// 区切りや 0 を多く含むペイロード
+Bytes MakePayload(std::mt19937& rng, size_t size) {
+  std::uniform_int_distribution<int> pick(0, 7);
+  std::uniform_int_distribution<int> any(0, 255);
+  Bytes data(size);
+  for (auto& byte : data) {
+    switch (pick(rng)) {
+      case 0:
+        byte = 0x00;
+        break;
+      case 1:
+        byte = Slip::kEnd;
+        break;
+      case 2:
+        byte = Slip::kEsc;
+        break;
+      default:
+        byte = static_cast<uint8_t>(any(rng));
+        break;
+    }
+  }
+  return data;
+}
+
+}  // namespace
+
+// CRC-16/CCITT-FALSE の検査値と、CRC を付けた列の残差が 0 になること
+TEST(FramingTest, Crc16) {
+  uint8_t const check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  EXPECT_EQ(nano_hw::uart::framing::Crc16(check), 0x29B1);
+
+  uint8_t const with_crc[] = {'1', '2', '3', '4', '5', '6',
+                              '7', '8', '9', 0x29, 0xB1};
+  EXPECT_EQ(nano_hw::uart::framing::Crc16(with_crc), 0);
+}
+
+// COBS の既知の符号化 (254 バイトのブロック境界を含む)
+TEST(FramingTest, CobsVectors) {
+  EXPECT_EQ(Raw<Cobs>({0x00}), (Bytes{0x01, 0x01, 0x00}));
+  EXPECT_EQ(Raw<Cobs>({0x11, 0x22, 0x00, 0x33}),
+            (Bytes{0x03, 0x11, 0x22, 0x02, 0x33, 0x00}));
+
+  Bytes run(254);
+  for (size_t i = 0; i < run.size(); i++) {
+    run[i] = static_cast<uint8_t>(i + 1);
+  }
+  auto const encoded = Raw<Cobs>(run);
+  ASSERT_EQ(encoded.size(), 257u);
+  EXPECT_EQ(encoded[0], 0xFF);
+  EXPECT_EQ(encoded[255], 0x01);
+  EXPECT_EQ(encoded[256], 0x00);
+}
+
+// SLIP の既知の符号化
+TEST(FramingTest, SlipVectors) {
+  EXPECT_EQ(Raw<Slip>({0x01, Slip::kEnd, Slip::kEsc}),
+            (Bytes{Slip::kEnd, 0x01, Slip::kEsc, Slip::kEscEnd, Slip::kEsc,
+                   Slip::kEscEsc, Slip::kEnd}));
+}
+
+// 任意の長さ・任意の分割で届いても元のペイロードに戻ること
+template <typename C>
+void RoundTrip() {
+  std::mt19937 rng(42);
+  Collector collector;
+  Decoder<C> decoder(&collector);
+
+  std::vector<Bytes> sent;
+  Bytes stream;
+  for (size_t size : {1, 2, 7, 253, 254, 255, 300}) {
+    sent.push_back(MakePayload(rng, size));
+    auto const encoded = Encode<C>(sent.back());
+    ASSERT_LE(encoded.size(), nano_hw::uart::framing::MaxFrameSize<C>(size));
+    stream.insert(stream.end(), encoded.begin(), encoded.end());
+  }
+
+  std::uniform_int_distribution<size_t> chunk(1, 7);
+  for (size_t pos = 0; pos < stream.size();) {
+    auto const n = std::min(chunk(rng), stream.size() - pos);
+    decltype(decoder)::RxHook::execute(static_cast<void*>(&decoder),
+                                       stream.data() + pos, n);
+    pos += n;
+  }
+
+  EXPECT_EQ(collector.frames, sent);
+  EXPECT_EQ(decoder.Stats().frames, sent.size());
+  EXPECT_EQ(decoder.Stats().bad_frames, 0u);
+  EXPECT_EQ(decoder.Stats().crc_errors, 0u);
+}
+
+TEST(FramingTest, CobsRoundTrip) { RoundTrip<Cobs>(); }
+TEST(FramingTest, SlipRoundTrip) { RoundTrip<Slip>(); }
+
+// 壊れたフレームは数えて捨て、次のフレームから受け直すこと
+TEST(FramingTest, CorruptionAndResync) {
+  Collector collector;
+  Decoder<Slip> decoder(&collector);
+
+  Bytes const good = {1, 2, 3};
+  auto flipped = Encode<Slip>(good);
+  flipped[2] ^= 0x40;
+  Bytes const bad_escape = {Slip::kEsc, 0x42, 0x55, Slip::kEnd};
+  Bytes const too_short = {0x01, Slip::kEnd};
+
+  for (auto const& bytes : {flipped, bad_escape, too_short}) {
+    decoder.Feed(bytes.data(), bytes.size());
+  }
+  auto const ok = Encode<Slip>(good);
+  decoder.Feed(ok.data(), ok.size());
+
+  ASSERT_EQ(collector.frames.size(), 1u);
+  EXPECT_EQ(collector.frames[0], good);
+  EXPECT_EQ(decoder.Stats().crc_errors, 1u);
+  EXPECT_EQ(decoder.Stats().bad_frames, 2u);
+  EXPECT_EQ(decoder.Stats().resyncs, 1u);
+}
+
+// 長すぎるフレームと途中で切れた COBS フレームを捨てること
+TEST(FramingTest, OverflowAndTruncated) {
+  Collector collector;
+  Decoder<Cobs> decoder(&collector);
+
+  std::mt19937 rng(7);
+  auto const huge = Encode<Cobs>(MakePayload(rng, 400));
+  decoder.Feed(huge.data(), huge.size());
+
+  Bytes const truncated = {0x05, 0x11, 0x22, 0x00};
+  decoder.Feed(truncated.data(), truncated.size());
+
+  Bytes const good = {0x00, 0xAA};
+  auto const ok = Encode<Cobs>(good);
+  decoder.Feed(ok.data(), ok.size());
+
+  ASSERT_EQ(collector.frames.size(), 1u);
+  EXPECT_EQ(collector.frames[0], good);
+  EXPECT_EQ(decoder.Stats().overflows, 1u);
+  EXPECT_EQ(decoder.Stats().resyncs, 1u);
+  EXPECT_EQ(decoder.Stats().bad_frames, 1u);
+}
+
+// 出力バッファに収まらなければ 0 を返すこと
+TEST(FramingTest, EncodeIntoSmallBuffer) {
+  Bytes const payload = {1, 2, 3, 4};
+  uint8_t out[5];
+  EXPECT_EQ(nano_hw::uart::framing::EncodeFrame<Cobs>(
+                {payload.data(), payload.size()}, out),
+            0u);
+  EXPECT_EQ(nano_hw::uart::framing::EncodeFrame<Slip>(
+                {payload.data(), payload.size()}, out),
+            0u);
+}
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <NanoHW/instance_pool.hpp>
+
+using nano_hw::InstancePool;
+
+namespace {
+
+struct Widget {
+  explicit Widget(int v) : value(v) {}
+  int value;
+};
+
+}  // namespace
+
+// 容量までは確保でき、解放したスロットを再利用できること
+TEST(InstancePoolTest, AllocateUpToCapacity) {
+  InstancePool<Widget, 2> pool;
+  static_assert(InstancePool<Widget, 2>::Capacity() == 2);
+  static_assert(InstancePool<Widget>::Capacity() == nano_hw::kMaxInstances);
+
+  auto* a = pool.New(1);
+  auto* b = pool.New(2);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(b->value, 2);
+
+  pool.Delete(a);
+  auto* c = pool.New(3);
+  EXPECT_EQ(c, a);
+  EXPECT_EQ(c->value, 3);
+}
+
+// 尽きたら nullptr を返さずに止まること
+TEST(InstancePoolDeathTest, TrapsWhenExhausted) {
+  InstancePool<Widget, 1> pool;
+  pool.New(1);
+  EXPECT_DEATH(pool.New(2), "");
+}
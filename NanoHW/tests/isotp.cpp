@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <vector>
+
+#include <NanoHW/isotp.hpp>
+
+using nano_hw::can::CANMessage;
+using nano_hw::can::isotp::Address;
+using nano_hw::can::isotp::Microseconds;
+using nano_hw::can::isotp::Options;
+using nano_hw::can::isotp::Status;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// 送ったフレームを溜めておき、Pump で全ノードに配るバス
+struct LoopbackBus;
+
+struct LoopbackDriver {
+  LoopbackBus* bus;
+  bool SendMessage(CANMessage msg);
+};
+
+using Transport = nano_hw::can::isotp::Transport<LoopbackDriver, 2, 512>;
+
+struct LoopbackBus {
+  std::deque<CANMessage> frames;
+  std::vector<CANMessage> log;
+  std::vector<Transport*> nodes;
+
+  void Pump() {
+    while (!frames.empty()) {
+      auto const msg = frames.front();
+      frames.pop_front();
+      for (auto* node : nodes) {
+        node->OnReceived(msg);
+      }
+    }
+  }
+};
+
+bool LoopbackDriver::SendMessage(CANMessage msg) {
+  bus->frames.push_back(msg);
+  bus->log.push_back(msg);
+  return true;
+}
+
+std::vector<uint8_t> MakePayload(size_t size) {
+  std::vector<uint8_t> data(size);
+  std::iota(data.begin(), data.end(), 0);
+  return data;
+}
+
+/// 送信が終わるまで時間を進めながら Poll する
+void RunUntilDone(LoopbackBus& bus, Transport& sender, size_t session,
+                  Microseconds& now) {
+  for (int i = 0; i < 1000 && sender.TxStatus(session) == Status::kBusy;
+       i++) {
+    bus.Pump();
+    for (auto* node : bus.nodes) {
+      node->Poll(now);
+    }
+    bus.Pump();
+    now += 1ms;
+  }
+}
+
+}  // namespace
+
+// 1 フレームに収まるメッセージは SF で届くこと
+TEST(IsoTpTest, SingleFrame) {
+  LoopbackBus bus;
+  LoopbackDriver driver_a{&bus};
+  LoopbackDriver driver_b{&bus};
+  Transport a(driver_a);
+  Transport b(driver_b);
+  bus.nodes = {&a, &b};
+
+  auto const sa = a.Open({0x700, 0x708});
+  auto const sb = b.Open({0x708, 0x700});
+  auto const data = MakePayload(5);
+
+  ASSERT_TRUE(a.Send(sa, {data.data(), data.size()}));
+  EXPECT_EQ(a.TxStatus(sa), Status::kDone);
+  bus.Pump();
+
+  auto const received = b.Received(sb);
+  ASSERT_EQ(received.size(), 5u);
+  EXPECT_EQ(std::vector<uint8_t>(received.begin(), received.end()), data);
+  EXPECT_EQ(bus.log.size(), 1u);
+  EXPECT_EQ(bus.log[0].len, 8);
+}
+
+// FF / FC / CF に分割され、BS ごとに FC が返ること
+TEST(IsoTpTest, MultiFrameWithBlockSize) {
+  LoopbackBus bus;
+  LoopbackDriver driver_a{&bus};
+  LoopbackDriver driver_b{&bus};
+  Transport a(driver_a);
+  Transport b(driver_b, Options{.block_size = 4, .st_min = 2});
+  bus.nodes = {&a, &b};
+
+  auto const sa = a.Open({0x700, 0x708});
+  auto const sb = b.Open({0x708, 0x700});
+  auto const data = MakePayload(300);
+
+  Microseconds now{0};
+  ASSERT_TRUE(a.Send(sa, {data.data(), data.size()}));
+  RunUntilDone(bus, a, sa, now);
+
+  EXPECT_EQ(a.TxStatus(sa), Status::kDone);
+  ASSERT_EQ(b.RxStatus(sb), Status::kDone);
+  auto const received = b.Received(sb);
+  EXPECT_EQ(std::vector<uint8_t>(received.begin(), received.end()), data);
+
+  // FF (6 バイト) + CF 7 バイトずつ = 1 + 42 フレーム、FC は 1 + 10 回
+  size_t fc = 0;
+  size_t cf = 0;
+  for (auto const& msg : bus.log) {
+    fc += (msg.data[0] & 0xF0) == 0x30;
+    cf += (msg.data[0] & 0xF0) == 0x20;
+  }
+  EXPECT_EQ(cf, 42u);
+  EXPECT_EQ(fc, 11u);
+
+  b.Release(sb);
+  EXPECT_EQ(b.Received(sb).size(), 0u);
+}
+
+// STmin の間隔より速く CF を送らないこと
+TEST(IsoTpTest, SeparationTime) {
+  LoopbackBus bus;
+  LoopbackDriver driver_a{&bus};
+  LoopbackDriver driver_b{&bus};
+  Transport a(driver_a);
+  Transport b(driver_b, Options{.st_min = 5});
+  bus.nodes = {&a, &b};
+
+  auto const sa = a.Open({0x700, 0x708});
+  b.Open({0x708, 0x700});
+  auto const data = MakePayload(20);
+
+  ASSERT_TRUE(a.Send(sa, {data.data(), data.size()}));
+  bus.Pump();
+
+  a.Poll(Microseconds{0});
+  a.Poll(Microseconds{4000});
+  EXPECT_EQ(a.TxStatus(sa), Status::kBusy);
+  a.Poll(Microseconds{5000});
+  bus.Pump();
+  EXPECT_EQ(a.TxStatus(sa), Status::kDone);
+}
+
+// 受信バッファに収まらない場合は FC(Overflow) で中断されること
+TEST(IsoTpTest, Overflow) {
+  LoopbackBus bus;
+  LoopbackDriver driver_a{&bus};
+  LoopbackDriver driver_b{&bus};
+  Transport a(driver_a);
+  Transport b(driver_b);
+  bus.nodes = {&a, &b};
+
+  auto const sa = a.Open({0x700, 0x708});
+  auto const sb = b.Open({0x708, 0x700});
+  auto const data = MakePayload(600);
+
+  ASSERT_TRUE(a.Send(sa, {data.data(), data.size()}));
+  bus.Pump();
+  EXPECT_EQ(a.TxStatus(sa), Status::kOverflow);
+  EXPECT_EQ(b.RxStatus(sb), Status::kIdle);
+}
+
+// FC が返ってこなければタイムアウトすること
+TEST(IsoTpTest, FlowControlTimeout) {
+  LoopbackBus bus;
+  LoopbackDriver driver{&bus};
+  Transport a(driver, Options{.timeout = 10ms});
+  bus.nodes = {&a};
+
+  auto const sa = a.Open({0x700, 0x708});
+  auto const data = MakePayload(100);
+  ASSERT_TRUE(a.Send(sa, {data.data(), data.size()}));
+
+  a.Poll(Microseconds{0});
+  a.Poll(Microseconds{9000});
+  EXPECT_EQ(a.TxStatus(sa), Status::kBusy);
+  a.Poll(Microseconds{10000});
+  EXPECT_EQ(a.TxStatus(sa), Status::kTimeout);
+}
+
+// 複数の送信元からのメッセージをセッションごとに組み立てられること
+TEST(IsoTpTest, ConcurrentSessions) {
+  LoopbackBus bus;
+  LoopbackDriver driver_a{&bus};
+  LoopbackDriver driver_b{&bus};
+  LoopbackDriver driver_c{&bus};
+  Transport a(driver_a);
+  Transport b(driver_b);
+  Transport c(driver_c);
+  bus.nodes = {&a, &b, &c};
+
+  auto const sa = a.Open({0x701, 0x709});
+  auto const sb = b.Open({0x702, 0x70A});
+  auto const from_a = c.Open({0x709, 0x701});
+  auto const from_b = c.Open({0x70A, 0x702});
+  EXPECT_EQ(c.Open({0x70B, 0x703}), Transport::kNone);
+
+  auto const data_a = MakePayload(100);
+  auto data_b = MakePayload(200);
+  std::reverse(data_b.begin(), data_b.end());
+
+  ASSERT_TRUE(a.Send(sa, {data_a.data(), data_a.size()}));
+  ASSERT_TRUE(b.Send(sb, {data_b.data(), data_b.size()}));
+
+  Microseconds now{0};
+  RunUntilDone(bus, a, sa, now);
+  RunUntilDone(bus, b, sb, now);
+
+  auto const got_a = c.Received(from_a);
+  auto const got_b = c.Received(from_b);
+  EXPECT_EQ(std::vector<uint8_t>(got_a.begin(), got_a.end()), data_a);
+  EXPECT_EQ(std::vector<uint8_t>(got_b.begin(), got_b.end()), data_b);
+}
+
+// OnCANReceived ポリシーとして渡せること
+TEST(IsoTpTest, ReceiveHook) {
+  LoopbackBus bus;
+  LoopbackDriver driver{&bus};
+  Transport t(driver);
+  auto const session = t.Open({0x708, 0x700});
+
+  CANMessage msg;
+  msg.id = 0x700;
+  msg.len = 8;
+  msg.data[0] = 0x02;
+  msg.data[1] = 0xAB;
+  msg.data[2] = 0xCD;
+  Transport::ReceiveHook::execute(static_cast<void*>(&t), msg);
+
+  ASSERT_EQ(t.Received(session).size(), 2u);
+  EXPECT_EQ(t.Received(session)[1], 0xCD);
+}
+
+// 不正な FF_DL の FF は無視し、後続の CF でもバッファを越えて書かないこと
+TEST(IsoTpTest, MalformedFirstFrame) {
+  LoopbackBus bus;
+  LoopbackDriver driver{&bus};
+  nano_hw::can::isotp::Transport<LoopbackDriver, 1, 16> t(driver);
+  auto const session = t.Open({0x708, 0x700});
+
+  CANMessage msg;
+  msg.id = 0x700;
+  msg.len = 8;
+  std::fill(std::begin(msg.data), std::end(msg.data), 0xEE);
+
+  // FF_DL = 1 (中身は 6 バイト) と FF_DL = 7 (SF に収まる)
+  for (uint8_t declared : {1, 7}) {
+    msg.data[0] = 0x10;
+    msg.data[1] = declared;
+    t.OnReceived(msg);
+    EXPECT_EQ(t.RxStatus(session), Status::kIdle);
+  }
+
+  for (uint8_t sn = 1; sn <= 8; sn++) {
+    msg.data[0] = static_cast<uint8_t>(0x20 | sn);
+    t.OnReceived(msg);
+  }
+  EXPECT_EQ(t.RxStatus(session), Status::kIdle);
+  EXPECT_TRUE(t.Received(session).empty());
+  // 無視した FF には FC も返さない
+  EXPECT_TRUE(bus.log.empty());
+
+  // バッファより長い FF_DL は FC(Overflow)
+  msg.data[0] = 0x10;
+  msg.data[1] = 17;
+  t.OnReceived(msg);
+  ASSERT_EQ(bus.log.size(), 1u);
+  EXPECT_EQ(bus.log[0].data[0], 0x32);
+}
+
+#if NANO_HW_CAN_FD
+// FD の拡張 ID セッションでも FF / CF が FD かつ拡張 ID のまま送られること
+TEST(IsoTpTest, FDExtendedRoundTrip) {
+  LoopbackBus bus;
+  LoopbackDriver driver_a{&bus};
+  LoopbackDriver driver_b{&bus};
+  Transport a(driver_a, Options{.fd = true});
+  Transport b(driver_b, Options{.fd = true});
+  bus.nodes = {&a, &b};
+
+  auto constexpr kExtended = nano_hw::can::CANMessageFormat::kExtended;
+  auto const sa = a.Open({0x18DA10F1, 0x18DAF110, kExtended});
+  auto const sb = b.Open({0x18DAF110, 0x18DA10F1, kExtended});
+  auto const data = MakePayload(200);
+
+  Microseconds now{0};
+  ASSERT_TRUE(a.Send(sa, {data.data(), data.size()}));
+  RunUntilDone(bus, a, sa, now);
+
+  EXPECT_EQ(a.TxStatus(sa), Status::kDone);
+  ASSERT_EQ(b.RxStatus(sb), Status::kDone);
+  auto const received = b.Received(sb);
+  EXPECT_EQ(std::vector<uint8_t>(received.begin(), received.end()), data);
+
+  // FF (62 バイト) + CF 63 バイトずつ = 1 + 3 フレームがすべて FD
+  size_t fd = 0;
+  for (auto const& msg : bus.log) {
+    EXPECT_EQ(msg.Format(), kExtended);
+    if ((msg.data[0] & 0xF0) != 0x30) {
+      EXPECT_TRUE(msg.IsFD());
+      fd++;
+    }
+  }
+  EXPECT_EQ(fd, 4u);
+}
+#endif
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <NanoHW/reactor.hpp>
+#include "reactor.hpp"
+#include "rtos.hpp"
+
+using nano_hw::reactor::EventSource;
+using nano_hw::reactor::Reactor;
+using nano_stub::StubReactor;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// 呼ばれた源の番号を順に記録する
+struct Log {
+  std::mutex mutex;
+  std::vector<int> order;
+
+  struct Entry {
+    Log* log;
+    int id;
+  };
+
+  static void Record(void* ctx) {
+    auto* entry = static_cast<Entry*>(ctx);
+    std::lock_guard lock(entry->log->mutex);
+    entry->log->order.push_back(entry->id);
+  }
+
+  size_t Size() {
+    std::lock_guard lock(mutex);
+    return order.size();
+  }
+};
+
+void Increment(void* ctx) {
+  static_cast<std::atomic<int>*>(ctx)->fetch_add(1);
+}
+
+template <typename Pred>
+bool WaitUntil(Pred pred, std::chrono::milliseconds timeout = 2000ms) {
+  auto const deadline = std::chrono::steady_clock::now() + timeout;
+  while (!pred()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+  return true;
+}
+
+}  // namespace
+
+// 実行待ちが重なったら priority の大きい順、同じなら登録順に呼ぶこと
+TEST(ReactorTest, ServesByPriority) {
+  StubReactor reactor;
+  Log log;
+  Log::Entry low{&log, 0}, high{&log, 1}, mid_a{&log, 2}, mid_b{&log, 3};
+
+  auto const s_low = reactor.Register(Log::Record, &low, 1);
+  auto const s_high = reactor.Register(Log::Record, &high, 9);
+  auto const s_mid_a = reactor.Register(Log::Record, &mid_a, 5);
+  auto const s_mid_b = reactor.Register(Log::Record, &mid_b, 5);
+  ASSERT_TRUE(s_low && s_high && s_mid_a && s_mid_b);
+
+  // 起動前に全部 Signal しておく
+  reactor.Signal(*s_low);
+  reactor.Signal(*s_mid_b);
+  reactor.Signal(*s_mid_a);
+  reactor.Signal(*s_high);
+  reactor.Start();
+
+  ASSERT_TRUE(WaitUntil([&] { return log.Size() == 4; }));
+  EXPECT_EQ(log.order, (std::vector<int>{1, 2, 3, 0}));
+}
+
+// 呼ばれるまでの Signal は 1 回にまとまること
+TEST(ReactorTest, CoalescesSignals) {
+  StubReactor reactor;
+  std::atomic<int> counter{0};
+
+  auto const source = reactor.Register(Increment, &counter);
+  ASSERT_TRUE(source);
+  for (int i = 0; i < 5; i++) {
+    reactor.Signal(*source);
+  }
+  reactor.Start();
+
+  ASSERT_TRUE(WaitUntil([&] { return counter.load() == 1; }));
+  std::this_thread::sleep_for(20ms);
+  EXPECT_EQ(counter.load(), 1);
+  EXPECT_EQ(reactor.Dispatched(), 1u);
+}
+
+// 別スレッドからの Signal を取りこぼさないこと
+TEST(ReactorTest, NoLostWakeups) {
+  StubReactor reactor;
+
+  struct Channel {
+    std::atomic<int> produced{0};
+    std::atomic<int> seen{0};
+
+    static void OnReady(void* ctx) {
+      auto* self = static_cast<Channel*>(ctx);
+      self->seen.store(self->produced.load());
+    }
+  } channel;
+
+  auto const source = reactor.Register(Channel::OnReady, &channel);
+  ASSERT_TRUE(source);
+  reactor.Start();
+
+  constexpr int kEvents = 20000;
+  std::thread producer([&] {
+    for (int i = 0; i < kEvents; i++) {
+      channel.produced.fetch_add(1);
+      reactor.Signal(*source);
+    }
+  });
+  producer.join();
+
+  // 最後の Signal の後に必ず 1 回は呼ばれる
+  EXPECT_TRUE(WaitUntil([&] { return channel.seen.load() == kEvents; }));
+  EXPECT_LT(reactor.Dispatched(), static_cast<size_t>(kEvents) + 1);
+}
+
+// 周期イベントはスレッドを増やさずに period ごとに呼ばれること
+TEST(ReactorTest, PeriodicSources) {
+  StubReactor reactor;
+  std::atomic<int> fast{0};
+  std::atomic<int> slow{0};
+
+  reactor.Start();
+  auto const s_fast = reactor.RegisterPeriodic(Increment, &fast, 5ms);
+  auto const s_slow = reactor.RegisterPeriodic(Increment, &slow, 25ms);
+  ASSERT_TRUE(s_fast && s_slow);
+  EXPECT_FALSE(reactor.RegisterPeriodic(Increment, &fast, 0ms));
+
+  std::this_thread::sleep_for(200ms);
+  reactor.Unregister(*s_fast);
+  reactor.Unregister(*s_slow);
+
+  // 計時の揺らぎを見込んで緩く確認する
+  EXPECT_GE(fast.load(), 20);
+  EXPECT_LE(fast.load(), 41);
+  EXPECT_GE(slow.load(), 4);
+  EXPECT_LE(slow.load(), 9);
+  EXPECT_GT(fast.load(), slow.load() * 2);
+}
+
+// Unregister の後は呼ばれず、空いた枠を再利用できること
+TEST(ReactorTest, UnregisterAndCapacity) {
+  Reactor<nano_stub::PosixThread, nano_stub::StubHighResClock,
+          nano_stub::CondVarWaker, 2>
+      reactor;
+  std::atomic<int> a{0};
+  std::atomic<int> b{0};
+
+  auto const s_a = reactor.Register(Increment, &a);
+  auto const s_b = reactor.RegisterPeriodic(Increment, &b, 1ms);
+  ASSERT_TRUE(s_a && s_b);
+  EXPECT_FALSE(reactor.Register(Increment, &a));
+  EXPECT_EQ(reactor.Sources(), 2u);
+
+  reactor.Start();
+  ASSERT_TRUE(WaitUntil([&] { return b.load() > 3; }));
+  reactor.Unregister(*s_b);
+  auto const stopped = b.load();
+  std::this_thread::sleep_for(20ms);
+  EXPECT_EQ(b.load(), stopped);
+
+  auto const s_c = reactor.Register(Increment, &b);
+  ASSERT_TRUE(s_c);
+  EXPECT_EQ(s_c->index, s_b->index);
+  reactor.Signal(*s_c);
+  EXPECT_TRUE(WaitUntil([&] { return b.load() == stopped + 1; }));
+  EXPECT_EQ(a.load(), 0);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <NanoHW/uart_dma_rx.hpp>
+#include <uart_dma.hpp>
+
+using nano_hw::uart::DmaRxEvent;
+using nano_stub::MockUARTDma;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+/// OnUARTRx で受け取ったデータを溜める
+struct Receiver {
+  Bytes data;
+  size_t calls = 0;
+
+  static void OnUARTRx(void* context, const uint8_t* data, size_t size) {
+    auto* self = static_cast<Receiver*>(context);
+    self->data.insert(self->data.end(), data, data + size);
+    self->calls++;
+  }
+};
+
+struct ReceiverConfig {
+  using OnUARTRx = nano_hw::Direct<&Receiver::OnUARTRx>;
+};
+
+template <size_t kSize>
+using Ring = nano_hw::uart::DmaRxRing<kSize, ReceiverConfig>;
+
+Bytes Random(size_t size, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> byte(0, 255);
+  Bytes data(size);
+  for (auto& value : data) {
+    value = static_cast<uint8_t>(byte(rng));
+  }
+  return data;
+}
+
+}  // namespace
+
+// 半分・末尾・idle の割り込みでまとめて渡されること
+TEST(UARTDmaRxTest, HalfFullAndIdle) {
+  Receiver receiver;
+  Ring<64> ring(&receiver);
+  MockUARTDma dma(ring);
+
+  auto const data = Random(40, 1);
+  dma.Receive(data.data(), data.size());
+  // 前半 32 バイトで半分の割り込み
+  EXPECT_EQ(receiver.data.size(), 32u);
+  dma.Idle();
+  EXPECT_EQ(receiver.data, data);
+  EXPECT_EQ(receiver.calls, 2u);
+
+  // 末尾を越えて先頭に戻る
+  auto const more = Random(30, 2);
+  dma.Receive(more.data(), more.size());
+  dma.Idle();
+  EXPECT_EQ(receiver.data.size(), 70u);
+  EXPECT_TRUE(std::equal(more.begin(), more.end(), receiver.data.begin() + 40));
+
+  auto const& stats = ring.Stats();
+  EXPECT_EQ(stats.half_transfers, 1u);
+  EXPECT_EQ(stats.transfer_completes, 1u);
+  EXPECT_EQ(stats.idles, 2u);
+  EXPECT_EQ(stats.bytes, 70u);
+}
+
+// 長いストリームを任意の長さのバーストで流しても、欠けも重複もしないこと
+TEST(UARTDmaRxTest, Stream) {
+  Receiver receiver;
+  Ring<128> ring(&receiver);
+  MockUARTDma dma(ring);
+
+  auto const data = Random(10000, 3);
+  std::mt19937 rng(4);
+  std::uniform_int_distribution<size_t> burst(1, 200);
+  for (size_t pos = 0; pos < data.size();) {
+    auto const n = std::min(burst(rng), data.size() - pos);
+    dma.Receive(data.data() + pos, n);
+    dma.Idle();
+    pos += n;
+  }
+
+  EXPECT_EQ(receiver.data, data);
+  // 1 バイトごとではなくまとめて届く
+  EXPECT_LT(receiver.calls, data.size() / 8);
+}
+
+// 割り込みが遅れて重なっても、同じデータを二重に渡さないこと
+TEST(UARTDmaRxTest, DelayedInterrupts) {
+  Receiver receiver;
+  Ring<64> ring(&receiver);
+  MockUARTDma dma(ring);
+
+  auto const data = Random(50, 5);
+  dma.SetIrqEnabled(false);
+  dma.Receive(data.data(), 20);
+  dma.Receive(data.data() + 20, 30);
+  dma.Idle();
+  EXPECT_TRUE(receiver.data.empty());
+
+  // 保留していた HT と IDLE が続けて入る
+  dma.SetIrqEnabled(true);
+  EXPECT_EQ(receiver.data, data);
+  EXPECT_EQ(ring.Stats().half_transfers, 1u);
+  EXPECT_EQ(ring.Stats().idles, 1u);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <NanoHW/uart_tx_queue.hpp>
+
+using nano_hw::uart::TxFullPolicy;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+using Queue = nano_hw::uart::TxQueue<16, 4>;
+
+/// 送信レジスタと OnUARTTx の代わり
+struct Wire {
+  explicit Wire(size_t budget = 0) : budget(budget) {}
+
+  size_t budget;  ///< 割り込み 1 回で書けるバイト数
+  Bytes sent;
+  std::vector<Bytes> chunks;
+
+  bool Writable() {
+    if (budget == 0) {
+      return false;
+    }
+    budget--;
+    return true;
+  }
+
+  bool Drain(Queue& queue) {
+    return queue.Drain([this] { return Writable(); },
+                       [this](uint8_t byte) { sent.push_back(byte); },
+                       [this](uint8_t const* data, size_t size) {
+                         chunks.emplace_back(data, data + size);
+                       });
+  }
+};
+
+Bytes Sequence(size_t size, uint8_t start = 0) {
+  Bytes data(size);
+  std::iota(data.begin(), data.end(), start);
+  return data;
+}
+
+auto const kNoWait = [] { FAIL() << "must not wait"; };
+
+struct PlainConfig {};
+struct LossyConfig {
+  static constexpr TxFullPolicy kTxFullPolicy = TxFullPolicy::kTruncate;
+};
+
+}  // namespace
+
+// 積んだ順に送り、Write 1 回分を送り終えたときに通知すること
+TEST(UARTTxQueueTest, ChunksInOrder) {
+  Queue queue;
+  Wire wire;
+
+  auto const a = Sequence(3);
+  auto const b = Sequence(5, 10);
+  EXPECT_EQ(queue.Write(a.data(), a.size(), TxFullPolicy::kFail, kNoWait), 3u);
+  EXPECT_EQ(queue.Write(b.data(), b.size(), TxFullPolicy::kFail, kNoWait), 5u);
+  EXPECT_EQ(queue.Free(), 8u);
+
+  // 送信レジスタが塞がったらチャンクの途中で止まる
+  wire.budget = 4;
+  EXPECT_TRUE(wire.Drain(queue));
+  ASSERT_EQ(wire.chunks.size(), 1u);
+  EXPECT_EQ(wire.chunks[0], a);
+
+  wire.budget = 100;
+  EXPECT_FALSE(wire.Drain(queue));
+  ASSERT_EQ(wire.chunks.size(), 2u);
+  EXPECT_EQ(wire.chunks[1], b);
+  EXPECT_EQ(wire.sent.size(), 8u);
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Free(), 16u);
+}
+
+// リングの端をまたいだチャンクは 2 回に分けて通知すること
+TEST(UARTTxQueueTest, WrappedChunk) {
+  Queue queue;
+  Wire wire{100};
+
+  auto const head = Sequence(12);
+  queue.Write(head.data(), head.size(), TxFullPolicy::kFail, kNoWait);
+  wire.Drain(queue);
+
+  auto const wrapped = Sequence(8, 100);
+  queue.Write(wrapped.data(), wrapped.size(), TxFullPolicy::kFail, kNoWait);
+  wire.Drain(queue);
+
+  ASSERT_EQ(wire.chunks.size(), 3u);
+  Bytes joined = wire.chunks[1];
+  joined.insert(joined.end(), wire.chunks[2].begin(), wire.chunks[2].end());
+  EXPECT_EQ(joined, wrapped);
+}
+
+// 満杯のときの kFail / kTruncate
+TEST(UARTTxQueueTest, FailAndTruncate) {
+  Queue queue;
+  auto const data = Sequence(10);
+
+  EXPECT_EQ(queue.Write(data.data(), 10, TxFullPolicy::kFail, kNoWait), 10u);
+  EXPECT_EQ(queue.Write(data.data(), 10, TxFullPolicy::kFail, kNoWait), 0u);
+  EXPECT_EQ(queue.Dropped(), 10u);
+
+  EXPECT_EQ(queue.Write(data.data(), 10, TxFullPolicy::kTruncate, kNoWait),
+            6u);
+  EXPECT_EQ(queue.Dropped(), 14u);
+  EXPECT_EQ(queue.Free(), 0u);
+
+  // チャンク数の上限でも満杯になる
+  Queue chunks;
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(chunks.Write(data.data(), 1, TxFullPolicy::kFail, kNoWait), 1u);
+  }
+  EXPECT_EQ(chunks.Write(data.data(), 1, TxFullPolicy::kTruncate, kNoWait),
+            0u);
+}
+
+// kBlock は送信が進むのを待って全部積むこと
+TEST(UARTTxQueueTest, BlockUntilDrained) {
+  Queue queue;
+  Wire wire;
+  int waits = 0;
+
+  auto const data = Sequence(40);
+  auto const written =
+      queue.Write(data.data(), data.size(), TxFullPolicy::kBlock, [&] {
+        // 送信割り込みが 1 回入ったことにする
+        waits++;
+        wire.budget = 8;
+        wire.Drain(queue);
+      });
+  wire.budget = 100;
+  wire.Drain(queue);
+
+  EXPECT_EQ(written, data.size());
+  EXPECT_GT(waits, 0);
+  EXPECT_EQ(wire.sent, data);
+  EXPECT_EQ(queue.Dropped(), 0u);
+
+  // 分けて積んだ分だけ通知も分かれ、合計は Write したバイト数
+  size_t notified = 0;
+  for (auto const& chunk : wire.chunks) {
+    notified += chunk.size();
+  }
+  EXPECT_GT(wire.chunks.size(), 1u);
+  EXPECT_EQ(notified, data.size());
+}
+
+// Config::kTxFullPolicy が無ければ kBlock
+TEST(UARTTxQueueTest, PolicyFromConfig) {
+  EXPECT_EQ(nano_hw::uart::TxFullPolicyOf<PlainConfig>(),
+            TxFullPolicy::kBlock);
+  EXPECT_EQ(nano_hw::uart::TxFullPolicyOf<LossyConfig>(),
+            TxFullPolicy::kTruncate);
+}
+
+// スレッド (Write) と割り込み役 (Drain) が並行しても順序通りに届くこと
+TEST(UARTTxQueueTest, ConcurrentProducerConsumer) {
+  nano_hw::uart::TxQueue<64, 8> queue;
+  constexpr size_t kChunks = 20000;
+  std::atomic<bool> done{false};
+  Bytes sent;
+  size_t completed = 0;  ///< on_chunk で通知されたバイト数
+
+  std::thread isr([&] {
+    auto const drain = [&] {
+      return queue.Drain(
+          [] { return true; }, [&](uint8_t byte) { sent.push_back(byte); },
+          [&](uint8_t const*, size_t size) { completed += size; });
+    };
+    while (!done.load()) {
+      drain();
+      std::this_thread::yield();
+    }
+    drain();
+  });
+
+  Bytes expected;
+  for (size_t i = 0; i < kChunks; i++) {
+    auto const data = Sequence(1 + i % 13, static_cast<uint8_t>(i));
+    queue.Write(data.data(), data.size(), TxFullPolicy::kBlock,
+                [] { std::this_thread::yield(); });
+    expected.insert(expected.end(), data.begin(), data.end());
+  }
+  done = true;
+  isr.join();
+
+  EXPECT_EQ(sent, expected);
+  EXPECT_EQ(completed, expected.size());
+  EXPECT_TRUE(queue.Empty());
+}
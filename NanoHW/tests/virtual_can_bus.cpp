@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <virtual_can_bus.hpp>
+
+using nano_hw::can::CANFilter;
+using nano_hw::can::CANMessage;
+using nano_hw::can::CANMessageFormat;
+using nano_hw::can::CANMode;
+using nano_stub::VirtualCANBus;
+using nano_stub::VirtualCANPort;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int kBitrate = 500000;
+/// 500 kbps で 8 バイトの標準フレーム (最悪 135 bit)
+constexpr auto kFrameTime = 270us;
+
+/// 受信したフレームと時刻を溜めるノード
+struct Node {
+  VirtualCANPort* port;
+  std::vector<CANMessage> received;
+  std::vector<VirtualCANBus::Duration> times;
+
+  Node(VirtualCANBus& bus, int bitrate = kBitrate) : port(bus.Attach(bitrate)) {
+    port->on_receive = [this, &bus](CANMessage const& msg) {
+      received.push_back(msg);
+      times.push_back(bus.Now());
+    };
+  }
+};
+
+CANMessage MakeFrame(uint32_t id,
+                     CANMessageFormat format = CANMessageFormat::kStandard) {
+  CANMessage msg{};
+  msg.id = id;
+  msg.len = 8;
+  msg.SetFormat(format);
+  return msg;
+}
+
+}  // namespace
+
+// 同時に出した要求は ID の小さい順に、1 フレームずつ送られること
+TEST(VirtualCANBusTest, Arbitration) {
+  VirtualCANBus bus(kBitrate);
+  Node a(bus);
+  Node b(bus);
+  Node c(bus);
+  Node listener(bus);
+
+  bus.Submit(a.port, MakeFrame(0x300));
+  bus.Submit(b.port, MakeFrame(0x100));
+  bus.Submit(c.port, MakeFrame(0x200));
+  bus.RunUntilIdle();
+
+  ASSERT_EQ(listener.received.size(), 3u);
+  EXPECT_EQ(listener.received[0].id, 0x100u);
+  EXPECT_EQ(listener.received[1].id, 0x200u);
+  EXPECT_EQ(listener.received[2].id, 0x300u);
+  EXPECT_EQ(listener.times[2], 3 * kFrameTime);
+  EXPECT_EQ(bus.LatencyOf(0x300).worst, 3 * kFrameTime);
+  EXPECT_EQ(bus.LatencyOf(0x100).worst, kFrameTime);
+
+  // 受信時刻はバスの時刻で付く
+  EXPECT_TRUE(listener.received[0].HasTimestamp());
+  EXPECT_EQ(listener.received[2].Timestamp(1ms), 0ms);
+}
+
+// 同じベース ID では標準 > 拡張、データ > リモートの順に勝つこと
+TEST(VirtualCANBusTest, ArbitrationField) {
+  auto const standard = MakeFrame(0x123);
+  auto remote = MakeFrame(0x123);
+  remote.SetRemote(true);
+  auto const extended = MakeFrame(0x123U << 18U, CANMessageFormat::kExtended);
+  auto const lower_extended =
+      MakeFrame((0x122U << 18U) | 0x3FFFF, CANMessageFormat::kExtended);
+
+  auto const key = &VirtualCANBus::ArbitrationKey;
+  EXPECT_LT(key(standard), key(remote));
+  EXPECT_LT(key(remote), key(extended));
+  EXPECT_LT(key(lower_extended), key(standard));
+}
+
+// フィルタに合うフレームだけを受け、ループバックでは自分のフレームも受けること
+TEST(VirtualCANBusTest, FiltersAndLoopback) {
+  VirtualCANBus bus(kBitrate);
+  Node sender(bus);
+  Node masked(bus);
+  Node listed(bus);
+
+  CANFilter mask{CANFilter::Type::kMask, {}};
+  mask.filter.mask_filter = {0x700, 0x100};
+  VirtualCANBus::SetFilter(masked.port, 0, mask);
+  CANFilter list{CANFilter::Type::kList, {}};
+  list.filter.list_filter.id = 0x205;
+  VirtualCANBus::SetFilter(listed.port, 0, list);
+
+  sender.port->mode = CANMode::kLoopback;
+  for (uint32_t id : {0x105U, 0x1FFU, 0x205U, 0x300U}) {
+    bus.Submit(sender.port, MakeFrame(id));
+  }
+  bus.RunUntilIdle();
+
+  EXPECT_EQ(sender.received.size(), 4u);
+  ASSERT_EQ(masked.received.size(), 2u);
+  EXPECT_EQ(masked.received[1].id, 0x1FFu);
+  ASSERT_EQ(listed.received.size(), 1u);
+  EXPECT_EQ(listed.received[0].id, 0x205u);
+
+  VirtualCANBus::DeactivateFilter(listed.port, 0);
+  bus.Submit(sender.port, MakeFrame(0x300));
+  bus.RunUntilIdle();
+  EXPECT_EQ(listed.received.size(), 2u);
+}
+
+// ビットレートの違うノードは送受信できずエラーになること
+TEST(VirtualCANBusTest, BitrateMismatch) {
+  VirtualCANBus bus(kBitrate);
+  Node good(bus);
+  Node slow(bus, 250000);
+
+  bus.Submit(slow.port, MakeFrame(0x10));
+  bus.Submit(good.port, MakeFrame(0x20));
+  bus.RunUntilIdle();
+
+  EXPECT_TRUE(good.received.empty());
+  EXPECT_TRUE(slow.received.empty());
+  EXPECT_EQ(slow.port->transmit_errors, 8);
+  EXPECT_EQ(slow.port->receive_errors, 1);
+}
+
+// 20 ノードが 10 ms 周期で一斉に送ったときの最悪遅延が ID 順に積み上がること
+TEST(VirtualCANBusTest, TwentyNodes) {
+  constexpr int kNodes = 20;
+  constexpr int kPeriods = 10;
+  constexpr auto kPeriod = 10ms;
+
+  VirtualCANBus bus(kBitrate);
+  std::vector<std::unique_ptr<Node>> nodes;
+  for (int i = 0; i < kNodes; i++) {
+    nodes.push_back(std::make_unique<Node>(bus));
+  }
+
+  for (int i = 0; i < kNodes; i++) {
+    auto* port = nodes[i]->port;
+    auto const id = static_cast<uint32_t>(0x100 + i);
+    for (int n = 0; n < kPeriods; n++) {
+      ASSERT_TRUE(bus.Schedule(n * kPeriod, [&bus, port, id] {
+        bus.Submit(port, MakeFrame(id));
+      }));
+    }
+  }
+  bus.RunUntil(kPeriods * kPeriod);
+
+  for (auto const& node : nodes) {
+    EXPECT_EQ(node->received.size(),
+              static_cast<size_t>((kNodes - 1) * kPeriods));
+  }
+  EXPECT_EQ(bus.LatencyOf(0x100).worst, kFrameTime);
+  EXPECT_EQ(bus.LatencyOf(0x100 + kNodes - 1).worst, kNodes * kFrameTime);
+  EXPECT_EQ(bus.LatencyOf(0x100 + kNodes - 1).frames,
+            static_cast<uint32_t>(kPeriods));
+  EXPECT_EQ(bus.BusyTime(), kNodes * kPeriods * kFrameTime);
+}
+
+// 送信中のポートを外すとフレームは途切れ、バスは次の送信に移ること
+TEST(VirtualCANBusTest, DetachDuringTransmission) {
+  VirtualCANBus bus(kBitrate);
+  auto* leaving = bus.Attach(kBitrate);
+  bool transmitted = false;
+  leaving->on_transmit = [&](CANMessage const&) { transmitted = true; };
+  Node other(bus);
+  Node listener(bus);
+
+  bus.Submit(leaving, MakeFrame(0x100));
+  bus.Submit(other.port, MakeFrame(0x200));
+  bus.RunFor(kFrameTime / 2);
+  bus.Detach(leaving);
+  bus.RunUntilIdle();
+
+  EXPECT_FALSE(transmitted);
+  ASSERT_EQ(listener.received.size(), 1u);
+  EXPECT_EQ(listener.received[0].id, 0x200u);
+  EXPECT_EQ(listener.times[0], kFrameTime / 2 + kFrameTime);
+  EXPECT_EQ(bus.BusyTime(), kFrameTime / 2 + kFrameTime);
+}
+
+// 受信コールバックの中で自分や後ろのポートを外しても安全なこと
+TEST(VirtualCANBusTest, DetachFromCallback) {
+  VirtualCANBus bus(kBitrate);
+  Node sender(bus);
+  auto* first = bus.Attach(kBitrate);
+  Node later(bus);
+  int first_calls = 0;
+  first->on_receive = [&](CANMessage const&) {
+    first_calls++;
+    bus.Detach(later.port);
+    bus.Detach(first);
+  };
+
+  bus.Submit(sender.port, MakeFrame(0x10));
+  bus.Submit(sender.port, MakeFrame(0x20));
+  bus.RunUntilIdle();
+
+  // 外されたポートは同じフレームも受信しない
+  EXPECT_EQ(first_calls, 1);
+  EXPECT_TRUE(later.received.empty());
+  EXPECT_EQ(bus.Ports(), 1u);
+}
@@ -4,6 +4,8 @@
 #include <iostream>
 
 #include "NanoHW/pin.hpp"
+#include "high_res_clock.hpp"
+#include "virtual_can_bus.hpp"
 
 namespace nano_stub {
 using namespace nano_hw::can;
@@ -24,7 +26,38 @@ class MockCAN {
               << frequency << ", context " << context_ << "\n";
   }
 
+  // The bus port's callbacks point at this object, so it must not be copied
+  // or moved
+  MockCAN(MockCAN const&) = delete;
+  MockCAN& operator=(MockCAN const&) = delete;
+
+  ~MockCAN() { DetachBus(); }
+
+  // Connect to a shared VirtualCANBus. While attached, frames go through the
+  // bus (arbitration, filters, loopback) instead of being logged.
+  // OnCANTransmit is left to CANImpl, which reports a frame once Submit
+  // accepts it, so the bus completion is not forwarded again
+  void AttachBus(VirtualCANBus& bus) {
+    DetachBus();
+    bus_ = &bus;
+    port_ = bus.Attach(frequency_);
+    port_->on_receive = [this](CANMessage const& msg) {
+      Config::OnCANReceived::execute(context_, msg);
+    };
+  }
+
+  void DetachBus() {
+    if (bus_ != nullptr) {
+      bus_->Detach(port_);
+      bus_ = nullptr;
+      port_ = nullptr;
+    }
+  }
+
   bool SendMessage(CANMessage msg) {
+    if (port_ != nullptr) {
+      return bus_->Submit(port_, msg);
+    }
     std::cout << "CAN SendMessage: ID 0x" << std::hex << msg.id << std::dec
               << ", len " << static_cast<int>(msg.len) << ", data [";
     for (int i = 0; i < msg.len; ++i) {
@@ -34,10 +67,11 @@ class MockCAN {
     }
     std::cout << std::dec;
     std::cout << "("
-              << (msg.format == nano_hw::can::CANMessageFormat::kStandard
+              << (msg.Format() == nano_hw::can::CANMessageFormat::kStandard
                       ? "Standard"
                       : "Extended")
-              << ")";
+              << (msg.IsFD() ? ", FD" : "")
+              << (msg.BitrateSwitch() ? ", BRS" : "") << ")";
     std::cout << "]\n";
 
     // Simulate successful transmission
@@ -45,11 +79,17 @@ class MockCAN {
   }
 
   int TransmitErrors() {
+    if (port_ != nullptr) {
+      return port_->transmit_errors;
+    }
     std::cout << "CAN TransmitErrors called\n";
     return 0;  // Mock always returns 0
   }
 
   int ReceiveErrors() {
+    if (port_ != nullptr) {
+      return port_->receive_errors;
+    }
     std::cout << "CAN ReceiveErrors called\n";
     return 0;  // Mock always returns 0
   }
@@ -58,10 +98,26 @@ class MockCAN {
 
   void ChangeBaudrate(int frequency) {
     frequency_ = frequency;
+    if (port_ != nullptr) {
+      port_->bitrate = frequency;
+    }
     std::cout << "CAN ChangeBaudrate: " << frequency << "\n";
   }
 
+  void ChangeBaudrate(int nominal, int data) {
+    frequency_ = nominal;
+    data_frequency_ = data;
+    if (port_ != nullptr) {
+      port_->bitrate = nominal;
+    }
+    std::cout << "CAN ChangeBaudrate: nominal " << nominal << ", data " << data
+              << "\n";
+  }
+
   void ChangeMode(nano_hw::can::CANMode mode) {
+    if (port_ != nullptr) {
+      port_->mode = mode;
+    }
     std::cout << "CAN ChangeMode: "
               << (mode == nano_hw::can::CANMode::kNormal ? "Normal"
                                                          : "Loopback")
@@ -69,6 +125,9 @@ class MockCAN {
   }
 
   void SetFilter(int filter_num, CANFilter filter) {
+    if (port_ != nullptr) {
+      VirtualCANBus::SetFilter(port_, filter_num, filter);
+    }
     std::cout << "CAN SetFilter: filter_num " << filter_num << ", type ";
     if (filter.filter_type == CANFilter::Type::kMask) {
       std::cout << "Mask (mask: 0x" << std::hex
@@ -81,11 +140,15 @@ class MockCAN {
   }
 
   void DeactivateFilter(int filter_num, CANFilter filter) {
+    if (port_ != nullptr) {
+      VirtualCANBus::DeactivateFilter(port_, filter_num);
+    }
     std::cout << "CAN DeactivateFilter: filter_num " << filter_num << "\n";
   }
 
   // Simulate receiving a CAN message and invoke the callback
   void SimulateReceive(CANMessage msg) {
+    nano_hw::can::StampReceived<Config, StubHighResClock>(msg);
     std::cout << "MockCAN SimulateReceive: ID 0x" << std::hex << msg.id
               << std::dec << ", len " << static_cast<int>(msg.len) << "\n";
     Config::OnCANReceived::execute(context_, msg);
@@ -114,10 +177,14 @@ class MockCAN {
   nano_hw::Pin transmit_pin_;
   nano_hw::Pin receive_pin_;
   int frequency_;
+  int data_frequency_ = 0;
   void* context_;
+  VirtualCANBus* bus_ = nullptr;
+  VirtualCANPort* port_ = nullptr;
 };
 
 static_assert(nano_hw::can::CAN<MockCAN>);
 static_assert(nano_hw::can::CANWithPolling<MockCAN>);
+static_assert(nano_hw::can::CANFD<MockCAN>);
 
 }  // namespace nano_stub
\ No newline at end of file
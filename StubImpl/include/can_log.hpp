@@ -0,0 +1,214 @@
+#pragma once
+
+#include <NanoHW/can_recorder.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <thread>
+
+namespace nano_stub {
+using nano_hw::can::CANRecord;
+
+/// @brief CAN ログファイルの先頭 (後ろに CANRecord が count 個並ぶ)
+struct CANLogHeader {
+  static constexpr char kMagic[4] = {'N', 'C', 'A', 'N'};  // NOLINT
+  static constexpr uint16_t kVersion = 1;
+
+  char magic[4] = {'N', 'C', 'A', 'N'};  // NOLINT
+  uint16_t version = kVersion;
+  /// CANRecord のサイズ (classic / FD のビルドで異なる)
+  uint16_t record_size = sizeof(CANRecord);
+  uint32_t count = 0;
+  uint32_t reserved = 0;
+};
+static_assert(sizeof(CANLogHeader) == 16);
+
+/// @brief CANRecord を mmap したファイルに追記する
+/// @details
+///   - Open で capacity 件分の領域を確保し、Close で実際の長さに切り詰める
+///   - Append は memcpy のみ (システムコールなし)。Flush で msync する
+///   - CANRecorder::Drain のシンクとして使う
+class CANLogWriter {
+ public:
+  CANLogWriter() = default;
+  CANLogWriter(CANLogWriter const&) = delete;
+  CANLogWriter& operator=(CANLogWriter const&) = delete;
+  ~CANLogWriter() { Close(); }
+
+  bool Open(const char* path, size_t capacity) {
+    Close();
+    fd_ = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+      return false;
+    }
+    size_ = sizeof(CANLogHeader) + capacity * sizeof(CANRecord);
+    if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+      Close();
+      return false;
+    }
+    void* map = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       fd_, 0);
+    if (map == MAP_FAILED) {
+      Close();
+      return false;
+    }
+    header_ = new (map) CANLogHeader{};
+    records_ = reinterpret_cast<uint8_t*>(map) + sizeof(CANLogHeader);
+    capacity_ = capacity;
+    return true;
+  }
+
+  /// @return ファイルが満杯なら false
+  bool Append(CANRecord const& record) {
+    if (header_ == nullptr || header_->count >= capacity_) {
+      return false;
+    }
+    std::memcpy(records_ + header_->count * sizeof(CANRecord), &record,
+                sizeof(CANRecord));
+    header_->count++;
+    return true;
+  }
+
+  void operator()(CANRecord const& record) { Append(record); }
+
+  void Flush() {
+    if (header_ != nullptr) {
+      ::msync(header_, size_, MS_ASYNC);
+    }
+  }
+
+  void Close() {
+    if (header_ != nullptr) {
+      auto const used =
+          sizeof(CANLogHeader) + header_->count * sizeof(CANRecord);
+      ::munmap(header_, size_);
+      ::ftruncate(fd_, static_cast<off_t>(used));
+      header_ = nullptr;
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  [[nodiscard]] size_t Size() const {
+    return header_ != nullptr ? header_->count : 0;
+  }
+
+ private:
+  int fd_ = -1;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+  CANLogHeader* header_ = nullptr;
+  uint8_t* records_ = nullptr;
+};
+
+/// @brief CANLogWriter で書いたファイルを読み取り専用で mmap する
+class CANLogReader {
+ public:
+  CANLogReader() = default;
+  CANLogReader(CANLogReader const&) = delete;
+  CANLogReader& operator=(CANLogReader const&) = delete;
+  ~CANLogReader() { Close(); }
+
+  /// @return 開けない / 形式が違う (別のビルドの CANRecord など) なら false
+  bool Open(const char* path) {
+    Close();
+    int const fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    auto const size = ::lseek(fd, 0, SEEK_END);
+    if (size < static_cast<off_t>(sizeof(CANLogHeader))) {
+      ::close(fd);
+      return false;
+    }
+    size_ = static_cast<size_t>(size);
+    void* map = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+      return false;
+    }
+    map_ = map;
+
+    auto const* header = static_cast<CANLogHeader const*>(map_);
+    if (std::memcmp(header->magic, CANLogHeader::kMagic, 4) != 0 ||
+        header->version != CANLogHeader::kVersion ||
+        header->record_size != sizeof(CANRecord) ||
+        sizeof(CANLogHeader) + header->count * sizeof(CANRecord) > size_) {
+      Close();
+      return false;
+    }
+    records_ = reinterpret_cast<CANRecord const*>(
+        static_cast<uint8_t const*>(map_) + sizeof(CANLogHeader));
+    count_ = header->count;
+    return true;
+  }
+
+  void Close() {
+    if (map_ != nullptr) {
+      ::munmap(map_, size_);
+      map_ = nullptr;
+    }
+    records_ = nullptr;
+    count_ = 0;
+  }
+
+  [[nodiscard]] size_t Size() const { return count_; }
+  CANRecord const& operator[](size_t index) const { return records_[index]; }
+  [[nodiscard]] CANRecord const* begin() const { return records_; }
+  [[nodiscard]] CANRecord const* end() const { return records_ + count_; }
+
+ private:
+  void* map_ = nullptr;
+  size_t size_ = 0;
+  CANRecord const* records_ = nullptr;
+  size_t count_ = 0;
+};
+
+struct ReplayOptions {
+  /// 再生速度の倍率 (0 なら待たずに流す)
+  float speed = 1.0F;
+  /// 送信したフレームも流す
+  bool include_tx = false;
+};
+
+/// @brief ログのフレームを記録時の間隔で target.SimulateReceive に渡す
+/// @details MockCAN など SimulateReceive(CANMessage) を持つ型に使う。
+///          受信時刻は付けないので、target 側で再生時の時刻が付く
+/// @return 渡したフレーム数
+template <typename Target>
+size_t Replay(CANLogReader const& log, Target& target,
+              ReplayOptions options = {}) {
+  using Clock = std::chrono::steady_clock;
+
+  size_t replayed = 0;
+  auto const start = Clock::now();
+  uint32_t const origin = log.Size() > 0 ? log[0].time_ms : 0;
+
+  for (auto const& record : log) {
+    if (record.direction == CANRecord::kTx && !options.include_tx) {
+      continue;
+    }
+    if (options.speed > 0.0F) {
+      // 32 bit の一周をまたいでも差分は正しい
+      auto const offset_ms =
+          static_cast<float>(record.time_ms - origin) / options.speed;
+      std::this_thread::sleep_until(
+          start + std::chrono::duration_cast<Clock::duration>(
+                      std::chrono::duration<float, std::milli>(offset_ms)));
+    }
+    target.SimulateReceive(record.ToMessage());
+    replayed++;
+  }
+  return replayed;
+}
+
+}  // namespace nano_stub
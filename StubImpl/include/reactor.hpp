@@ -0,0 +1,48 @@
+#pragma once
+
+#include <NanoHW/reactor.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "high_res_clock.hpp"
+#include "thread.hpp"
+
+namespace nano_stub {
+
+/// @brief 条件変数で待つ Waker (WaitFor の前の Notify も覚えておく)
+class CondVarWaker {
+ public:
+  void Notify() {
+    {
+      std::lock_guard lock(mutex_);
+      notified_ = true;
+    }
+    cv_.notify_one();
+  }
+
+  void WaitFor(std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex_);
+    cv_.wait_for(lock, timeout, [this] { return notified_; });
+    notified_ = false;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool notified_ = false;
+};
+
+using StubReactor =
+    nano_hw::reactor::Reactor<PosixThread, StubHighResClock, CondVarWaker>;
+
+/// @brief スタブの周辺機器が共有する reactor (初めて使うときに起動する)
+inline StubReactor& SharedReactor() {
+  static StubReactor reactor(ThreadPriorityNormal, 64 * 1024,
+                             "stub-reactor");
+  reactor.Start();
+  return reactor;
+}
+
+}  // namespace nano_stub
@@ -4,8 +4,11 @@
 #include <iostream>
 #include <thread>
 
+#include "thread.hpp"
+
 namespace nano_hw::parallel {
+// PosixThread の中では Terminate の要求で途中で起きる
 void SleepForMS(std::chrono::milliseconds ms) {
-  std::this_thread::sleep_for(ms);
+  nano_stub::PosixThread::SleepFor(ms);
 }
-}  // namespace nano_hw::parallel
\ No newline at end of file
+}  // namespace nano_hw::parallel
@@ -3,9 +3,9 @@
 #include <NanoHW/spi.hpp>
 
 #include <iostream>
-#include <vector>
 
 namespace nano_stub {
+using nano_hw::spi::SPIBuffer;
 using nano_hw::spi::SPIFormat;
 
 namespace {
@@ -44,7 +44,7 @@ class MockSPI {
     std::cout << "MockSPI SetFrequency: " << frequency_ << "\n";
   }
 
-  int Transfer(std::vector<uint8_t> const& tx, std::vector<uint8_t>& rx) {
+  int Transfer(SPIBuffer const& tx, SPIBuffer& rx) {
     rx = tx;
     std::cout << "MockSPI Transfer: length " << tx.size() << ", data [";
     for (size_t i = 0; i < tx.size(); ++i) {
@@ -59,7 +59,7 @@ class MockSPI {
   }
 
   // Simulate transfer complete and invoke the callback
-  void SimulateTransferComplete(std::vector<uint8_t> const& rx_data) {
+  void SimulateTransferComplete(SPIBuffer const& rx_data) {
     std::cout << "MockSPI SimulateTransferComplete: size " << rx_data.size()
               << "\n";
     Config::OnSPITransferComplete::execute(nullptr, rx_data);
@@ -2,8 +2,20 @@
 
 #include <NanoHW/thread.hpp>
 
-#include <functional>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 namespace nano_stub {
 using ::ThreadPriority;
@@ -24,7 +36,7 @@ class MockThread {
               << "\n";
   }
 
-  void Start(std::function<void()> task) {
+  void Start(nano_hw::thread::ThreadTask task) {
     std::cout << "MockThread Start: " << name_ << "\n";
     started_ = true;
 
@@ -64,4 +76,198 @@ class MockThread {
 
 static_assert(nano_hw::thread::Thread<MockThread>,
               "MockThread must satisfy nano_hw::thread::Thread concept");
+
+/// @brief pthread 上で実際に並行実行する Thread 実装
+/// @details
+///   - stack_size は pthread 属性で指定する (PTHREAD_STACK_MIN 未満は切り上げ)
+///   - AboveNormal 以上は権限があれば SCHED_FIFO, 無ければ nice 値で表現する
+///   - Terminate は停止要求フラグを立てて Join する (協調的な停止)。
+///     タスクは CurrentStopRequested() を見て自分で戻ること。SleepFor
+///     (rtos の SleepForMS) は停止要求で途中で起きる
+class PosixThread {
+ public:
+  PosixThread(ThreadPriority priority, uint32_t stack_size,
+              unsigned char* stack_mem, const char* name)
+      : priority_(priority),
+        stack_size_(stack_size),
+        stack_mem_(stack_mem),
+        name_(name ? name : "unnamed") {
+    std::cout << "PosixThread initialized: name=" << name_
+              << ", priority=" << priority_ << ", stack_size=" << stack_size_
+              << "\n";
+  }
+
+  PosixThread(PosixThread const&) = delete;
+  PosixThread& operator=(PosixThread const&) = delete;
+
+  ~PosixThread() {
+    if (started_ && !joined_) {
+      Terminate();
+    }
+  }
+
+  void Start(nano_hw::thread::ThreadTask task) {
+    if (!task || started_) {
+      return;
+    }
+    std::cout << "PosixThread Start: " << name_ << "\n";
+
+    task_ = std::move(task);
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    ConfigureStack(attr);
+
+    if (pthread_create(&handle_, &attr, &PosixThread::Entry, this) == 0) {
+      started_ = true;
+    } else {
+      std::cout << "PosixThread Start failed: " << name_ << "\n";
+    }
+    pthread_attr_destroy(&attr);
+  }
+
+  void Join() {
+    if (!started_ || joined_ || pthread_equal(handle_, pthread_self())) {
+      return;
+    }
+    pthread_join(handle_, nullptr);
+    joined_ = true;
+  }
+
+  /// @note タスクが停止要求を見ないと戻らない
+  void Terminate() {
+    std::cout << "PosixThread Terminate: " << name_ << "\n";
+    {
+      std::lock_guard lock(stop_mutex_);
+      stop_requested_.store(true, std::memory_order_release);
+    }
+    stop_cv_.notify_all();
+    Join();
+  }
+
+  void SetPriority(ThreadPriority priority) {
+    priority_.store(priority, std::memory_order_relaxed);
+    if (started_ && !joined_) {
+      ApplyPriority(handle_, tid_.load(std::memory_order_acquire), priority);
+    }
+  }
+
+  ThreadPriority GetPriority() const {
+    return priority_.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Terminate が要求されたか
+  [[nodiscard]] bool StopRequested() const {
+    return stop_requested_.load(std::memory_order_acquire);
+  }
+
+  /// @brief 呼び出し元の PosixThread に Terminate が要求されたか
+  /// @note PosixThread 以外のスレッドからは常に false
+  static bool CurrentStopRequested() {
+    return current_ != nullptr && current_->StopRequested();
+  }
+
+  /// @brief 呼び出し元のスレッドを眠らせる
+  /// @details PosixThread の中なら Terminate が要求された時点で起きる
+  static void SleepFor(std::chrono::milliseconds duration) {
+    if (current_ == nullptr) {
+      std::this_thread::sleep_for(duration);
+      return;
+    }
+    std::unique_lock lock(current_->stop_mutex_);
+    current_->stop_cv_.wait_for(
+        lock, duration, [] { return current_->StopRequested(); });
+  }
+
+ private:
+  static constexpr int kFifoPriorityStep = 10;
+
+  static void* Entry(void* arg) {
+    auto* self = static_cast<PosixThread*>(arg);
+    current_ = self;
+
+    auto const tid = static_cast<pid_t>(syscall(SYS_gettid));
+    self->tid_.store(tid, std::memory_order_release);
+
+    auto const thread_name = self->name_.substr(0, 15);
+    pthread_setname_np(pthread_self(), thread_name.c_str());
+    ApplyPriority(pthread_self(), tid, self->GetPriority());
+
+    self->task_();
+    return nullptr;
+  }
+
+  void ConfigureStack(pthread_attr_t& attr) const {
+    auto const page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto const min_size = static_cast<size_t>(PTHREAD_STACK_MIN);
+
+    if (stack_mem_ != nullptr && stack_size_ >= min_size &&
+        pthread_attr_setstack(&attr, stack_mem_, stack_size_) == 0) {
+      return;
+    }
+
+    auto size = std::max<size_t>(stack_size_, min_size);
+    size = (size + page_size - 1) / page_size * page_size;
+    pthread_attr_setstacksize(&attr, size);
+  }
+
+  static int NiceOf(ThreadPriority priority) {
+    switch (priority) {
+      case ThreadPriorityIdle:
+        return 19;
+      case ThreadPriorityLow:
+        return 10;
+      case ThreadPriorityBelowNormal:
+        return 5;
+      case ThreadPriorityAboveNormal:
+        return -5;
+      case ThreadPriorityHigh:
+        return -10;
+      case ThreadPriorityRealtime:
+        return -15;
+      case ThreadPriorityNormal:
+      default:
+        return 0;
+    }
+  }
+
+  static void ApplyPriority(pthread_t handle, pid_t tid,
+                            ThreadPriority priority) {
+    if (priority >= ThreadPriorityAboveNormal) {
+      sched_param param{};
+      param.sched_priority = std::min(sched_get_priority_min(SCHED_FIFO) +
+                                          priority * kFifoPriorityStep,
+                                      sched_get_priority_max(SCHED_FIFO));
+      if (pthread_setschedparam(handle, SCHED_FIFO, &param) == 0) {
+        return;
+      }
+    }
+
+    // 権限が無い場合や Normal 以下は SCHED_OTHER + nice で近似する
+    sched_param param{};
+    pthread_setschedparam(handle, SCHED_OTHER, &param);
+    if (tid != 0) {
+      setpriority(PRIO_PROCESS, static_cast<id_t>(tid), NiceOf(priority));
+    }
+  }
+
+  static inline thread_local PosixThread* current_ = nullptr;
+
+  std::atomic<ThreadPriority> priority_;
+  uint32_t stack_size_;
+  unsigned char* stack_mem_;
+  std::string name_;
+
+  nano_hw::thread::ThreadTask task_;
+  pthread_t handle_{};
+  std::atomic<pid_t> tid_{0};
+  std::atomic<bool> stop_requested_{false};
+  std::mutex stop_mutex_;
+  std::condition_variable stop_cv_;
+  bool started_ = false;
+  bool joined_ = false;
+};
+
+static_assert(nano_hw::thread::Thread<PosixThread>,
+              "PosixThread must satisfy nano_hw::thread::Thread concept");
 }  // namespace nano_stub
\ No newline at end of file
@@ -3,7 +3,9 @@
 
 #include <chrono>
 #include <iostream>
-#include <thread>
+#include <optional>
+
+#include "reactor.hpp"
 
 namespace nano_stub {
 
@@ -15,6 +17,11 @@ class MockTimer {
     std::cout << "MockTimer initialized\n";
   }
 
+  MockTimer(MockTimer const&) = delete;
+  MockTimer& operator=(MockTimer const&) = delete;
+
+  ~MockTimer() { DisableTick(); }
+
   void Reset() {
     std::cout << "Timer Reset called\n";
     accumulated_time_ = std::chrono::milliseconds(0);
@@ -53,21 +60,27 @@ class MockTimer {
   bool EnableTick(std::chrono::milliseconds interval) {
     std::cout << "EnableTick called with interval: " << interval.count()
               << " ms\n";
-    tick_thread_ = std::thread([this, interval]() {
-      while (true) {
-        std::this_thread::sleep_for(interval);
-        Config::OnTick::execute(this);
-      }
-    });
-    tick_thread_->detach();
-    return true;
+    // tick ごとにスレッドを作らず、共有 reactor の周期イベントにする
+    DisableTick();
+    tick_ = SharedReactor().RegisterPeriodic(&MockTimer::OnTick, this,
+                                             interval);
+    return tick_.has_value();
   }
 
  private:
+  static void OnTick(void* self) { Config::OnTick::execute(self); }
+
+  void DisableTick() {
+    if (tick_) {
+      SharedReactor().Unregister(*tick_);
+      tick_.reset();
+    }
+  }
+
   std::chrono::steady_clock::time_point start_time_;
   bool is_running_ = false;
   std::chrono::milliseconds accumulated_time_;
-  std::optional<std::thread> tick_thread_ = std::nullopt;
+  std::optional<nano_hw::reactor::EventSource> tick_ = std::nullopt;
 };
 
 static_assert(nano_hw::timer::Timer<MockTimer>);
@@ -14,7 +14,9 @@ class MockUART {
 
  public:
   MockUART(nano_hw::Pin tx, nano_hw::Pin rx, int baud_rate)
-      : tx_(tx), rx_(rx), baud_rate_(baud_rate) {
+      : MockUART(tx, rx, baud_rate, nullptr) {}
+  MockUART(nano_hw::Pin tx, nano_hw::Pin rx, int baud_rate, void* ctx)
+      : tx_(tx), rx_(rx), baud_rate_(baud_rate), context_(ctx) {
     std::cout << "MockUART initialized: TX " << tx_.number << ", RX "
               << rx_.number << ", baud " << baud_rate_ << "\n";
   }
@@ -46,19 +48,20 @@ class MockUART {
   // Simulate receiving data and invoke the callback
   void SimulateReceive(const uint8_t* data, size_t size) {
     std::cout << "MockUART SimulateReceive: size " << size << "\n";
-    Config::OnUARTRx::execute(nullptr, data, size);
+    Config::OnUARTRx::execute(context_, data, size);
   }
 
   // Simulate transmission complete and invoke the callback
   void SimulateTransmitComplete(size_t size) {
     std::cout << "MockUART SimulateTransmitComplete: size " << size << "\n";
-    Config::OnUARTTx::execute(nullptr, nullptr, size);
+    Config::OnUARTTx::execute(context_, nullptr, size);
   }
 
  private:
   nano_hw::Pin tx_;
   nano_hw::Pin rx_;
   int baud_rate_;
+  void* context_;
 };
 
 static_assert(nano_hw::uart::UART<MockUART>);
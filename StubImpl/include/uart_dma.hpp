@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Nano/span.hpp>
+#include <NanoHW/uart_dma_rx.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace nano_stub {
+using nano_hw::uart::DmaRxEvent;
+
+/// @brief 循環 DMA 受信と idle-line 検出をする UART の擬似ペリフェラル
+/// @details
+///   - Receive で届いたバイトを DMA と同じ順に buffer へ書き、
+///     前半・末尾を書き終えたところで割り込み (irq) を呼ぶ
+///   - Idle で回線が空いたことにし、受信があれば idle-line 割り込みを呼ぶ
+///   - SetIrqEnabled(false) の間は割り込みを保留し、有効にしたときに
+///     まとめて 1 回ずつ呼ぶ (割り込みの遅れの再現)
+class MockUARTDma {
+ public:
+  using Irq = std::function<void(DmaRxEvent event, size_t remaining)>;
+
+  MockUARTDma(Nano::collection::Span<uint8_t> buffer, Irq irq)
+      : buffer_(buffer), irq_(std::move(irq)) {}
+
+  /// DmaRxRing の割り込みハンドラを呼ぶ
+  template <typename Ring>
+  requires requires(Ring& ring) { ring.OnEvent(DmaRxEvent{}, size_t{}); }
+  explicit MockUARTDma(Ring& ring)
+      : MockUARTDma(ring.Buffer(), [&ring](DmaRxEvent event, size_t remaining) {
+          ring.OnEvent(event, remaining);
+        }) {}
+
+  void Receive(const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      buffer_[position_++] = data[i];
+      active_ = true;
+      if (position_ == buffer_.size() / 2) {
+        Raise(pending_half_);
+      } else if (position_ == buffer_.size()) {
+        position_ = 0;
+        Raise(pending_complete_);
+      }
+    }
+  }
+
+  void Idle() {
+    if (active_) {
+      active_ = false;
+      Raise(pending_idle_);
+    }
+  }
+
+  void SetIrqEnabled(bool enabled) {
+    irq_enabled_ = enabled;
+    if (enabled) {
+      Flush();
+    }
+  }
+
+  /// DMA の残り転送数 (NDTR)
+  [[nodiscard]] size_t Remaining() const {
+    return buffer_.size() - position_;
+  }
+
+ private:
+  void Raise(bool& pending) {
+    pending = true;
+    if (irq_enabled_) {
+      Flush();
+    }
+  }
+
+  // 保留していた割り込みを HT / TC / IDLE の順に呼ぶ
+  void Flush() {
+    auto const fire = [this](bool& pending, DmaRxEvent event) {
+      if (pending) {
+        pending = false;
+        irq_(event, Remaining());
+      }
+    };
+    fire(pending_half_, DmaRxEvent::kHalfTransfer);
+    fire(pending_complete_, DmaRxEvent::kTransferComplete);
+    fire(pending_idle_, DmaRxEvent::kIdle);
+  }
+
+  Nano::collection::Span<uint8_t> buffer_;
+  Irq irq_;
+  size_t position_ = 0;
+  bool active_ = false;
+  bool irq_enabled_ = true;
+  bool pending_half_ = false;
+  bool pending_complete_ = false;
+  bool pending_idle_ = false;
+};
+
+}  // namespace nano_stub
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <Nano/priority_queue.hpp>
+#include <NanoHW/can_message.hpp>
+#include <NanoHW/can_stats.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace nano_stub {
+using nano_hw::can::CANFilter;
+using nano_hw::can::CANMessage;
+using nano_hw::can::CANMessageFormat;
+using nano_hw::can::CANMode;
+
+/// @brief VirtualCANBus につないだノード側の口
+/// @details MockCAN::AttachBus で作られる。バスの時刻で動くので、
+///          コールバックは VirtualCANBus::Run* の中から呼ばれる
+struct VirtualCANPort {
+  static constexpr size_t kMailboxes = 32;
+  static constexpr size_t kFilters = 14;
+
+  /// 受信したフレーム (バスの時刻で受信時刻が付いている)
+  std::function<void(CANMessage const&)> on_receive;
+  /// 送信し終えたフレーム
+  std::function<void(CANMessage const&)> on_transmit;
+
+  int bitrate = 0;
+  CANMode mode = CANMode::kNormal;
+  int transmit_errors = 0;
+  int receive_errors = 0;
+
+ private:
+  friend class VirtualCANBus;
+
+  struct Pending {
+    uint32_t key = 0;
+    uint64_t seq = 0;
+    std::chrono::nanoseconds submitted{};
+    CANMessage msg;
+  };
+  /// Compare(a, b): a の方が後に送られる (キーが大きい、同じなら後に積んだ)
+  struct Later {
+    bool operator()(Pending const& a, Pending const& b) const {
+      return a.key != b.key ? a.key > b.key : a.seq > b.seq;
+    }
+  };
+
+  bool Accepts(CANMessage const& msg) const {
+    bool any = false;
+    for (auto const& slot : filters) {
+      if (!slot.active) {
+        continue;
+      }
+      any = true;
+      auto const& filter = slot.filter;
+      if (filter.filter_type == CANFilter::Type::kMask) {
+        auto const mask = filter.filter.mask_filter.mask;
+        if ((msg.id & mask) == (filter.filter.mask_filter.id & mask)) {
+          return true;
+        }
+      } else if (msg.id == filter.filter.list_filter.id) {
+        return true;
+      }
+    }
+    // フィルタが 1 つも無ければすべて受ける
+    return !any;
+  }
+
+  struct FilterSlot {
+    bool active = false;
+    CANFilter filter{};
+  };
+
+  std::array<FilterSlot, kFilters> filters{};
+  Nano::collection::PriorityQueue<Pending, kMailboxes, Later> tx;
+  /// Detach 済み (配っている途中なら解放を配り終えるまで遅らせる)
+  bool detached = false;
+};
+
+/// @brief 複数の MockCAN をつなぐプロセス内の仮想 CAN バス
+/// @details
+///   - 離散イベントで仮想時間を進める (実時間は待たない)
+///   - 各ポートは送信待ちのうち最も優先度の高いフレームを出し、
+///     ID (アービトレーションフィールド) の小さいものが勝つ。
+///     同じキーならポートの番号が小さい方を先に送る
+///   - フレーム長は EstimateFrameBits (最悪ケースのスタッフィング) と
+///     バスのビットレートから求める。ビットレートの違うポートの送信は
+///     エラーとして捨て、受信もしない
+///   - CANMode::kLoopback のポートは自分の送ったフレームも受信する
+///   - 送信要求から送信完了までの時間を ID ごとに記録する
+///   - 送信中のポートを Detach するとそのフレームは途中で途切れ、
+///     誰も受信しない。コールバックの中から Detach してもよい
+class VirtualCANBus {
+ public:
+  using Duration = std::chrono::nanoseconds;
+
+  struct Latency {
+    uint32_t frames = 0;
+    Duration worst{};
+    Duration total{};
+
+    [[nodiscard]] Duration Average() const {
+      return frames > 0 ? total / frames : Duration{};
+    }
+  };
+
+  explicit VirtualCANBus(int bitrate) : bitrate_(bitrate) {}
+
+  [[nodiscard]] Duration Now() const { return now_; }
+  [[nodiscard]] int Bitrate() const { return bitrate_; }
+  [[nodiscard]] size_t Ports() const { return ports_.size(); }
+
+  VirtualCANPort* Attach(int bitrate) {
+    auto& port = ports_.emplace_back(std::make_unique<VirtualCANPort>());
+    port->bitrate = bitrate;
+    return port.get();
+  }
+
+  void Detach(VirtualCANPort* port) {
+    auto const it =
+        std::find_if(ports_.begin(), ports_.end(),
+                     [port](auto const& p) { return p.get() == port; });
+    if (it == ports_.end()) {
+      return;
+    }
+    if (port == active_) {
+      AbortTransmission();
+    }
+    port->detached = true;
+    if (dispatching_) {
+      retired_.push_back(std::move(*it));
+    }
+    ports_.erase(it);
+  }
+
+  /// @brief 送信要求を出す (現在の仮想時刻から調停に参加する)
+  /// @return ポートのメールボックスが満杯なら false
+  bool Submit(VirtualCANPort* port, CANMessage const& msg) {
+    return static_cast<bool>(port->tx.Push(
+        {ArbitrationKey(msg), next_seq_++, now_, msg}));
+  }
+
+  static void SetFilter(VirtualCANPort* port, int filter_num,
+                        CANFilter filter) {
+    if (filter_num >= 0 &&
+        static_cast<size_t>(filter_num) < VirtualCANPort::kFilters) {
+      port->filters[filter_num] = {true, filter};
+    }
+  }
+
+  static void DeactivateFilter(VirtualCANPort* port, int filter_num) {
+    if (filter_num >= 0 &&
+        static_cast<size_t>(filter_num) < VirtualCANPort::kFilters) {
+      port->filters[filter_num].active = false;
+    }
+  }
+
+  /// @brief at の時刻に action を呼ぶ (ノードの周期送信などに使う)
+  /// @return イベントキューが満杯なら false
+  bool Schedule(Duration at, std::function<void()> action) {
+    return static_cast<bool>(
+        events_.Push({at, next_seq_++, std::move(action)}));
+  }
+
+  /// @brief end まで仮想時間を進める
+  void RunUntil(Duration end) {
+    while (true) {
+      if (active_ == nullptr) {
+        StartTransmission();
+      }
+      auto next = Duration::max();
+      if (active_ != nullptr) {
+        next = busy_until_;
+      }
+      if (!events_.Empty()) {
+        next = std::min(next, events_.Top().at);
+      }
+      if (next > end) {
+        now_ = end;
+        return;
+      }
+
+      // 過去の時刻に積まれたイベントは今の時刻で呼ぶ
+      now_ = std::max(now_, next);
+      if (active_ != nullptr && busy_until_ <= now_) {
+        CompleteTransmission();
+      }
+      while (!events_.Empty() && events_.Top().at <= now_) {
+        Event event;
+        events_.TryPop(event);
+        event.action();
+      }
+    }
+  }
+
+  void RunFor(Duration duration) { RunUntil(now_ + duration); }
+
+  /// @brief 送信待ちとイベントが無くなるまで進める
+  /// @note 自分を積み直す周期イベントがあると戻らない
+  void RunUntilIdle() {
+    while (active_ != nullptr || AnyPending() || !events_.Empty()) {
+      auto next = now_;
+      if (active_ != nullptr) {
+        next = busy_until_;
+      } else if (!AnyPending()) {
+        next = std::max(next, events_.Top().at);
+      }
+      RunUntil(next);
+    }
+  }
+
+  /// @brief id の送信要求から送信完了までの時間
+  [[nodiscard]] Latency LatencyOf(
+      uint32_t id,
+      CANMessageFormat format = CANMessageFormat::kStandard) const {
+    auto const it =
+        latency_.find(nano_hw::can::CANStatsSnapshot::Key(id, format));
+    return it != latency_.end() ? it->second : Latency{};
+  }
+
+  /// @brief バスがフレームを送っていた時間
+  [[nodiscard]] Duration BusyTime() const { return busy_total_; }
+
+  /// @brief アービトレーションで比べる値 (小さい方が勝つ)
+  /// @details ベース ID、RTR / SRR、IDE、拡張 ID、RTR の順にビットを並べる
+  static uint32_t ArbitrationKey(CANMessage const& msg) {
+    uint32_t const rtr = msg.IsRemote() ? 1 : 0;
+    if (msg.Format() == CANMessageFormat::kStandard) {
+      return (msg.id & 0x7FFU) << 21U | rtr << 20U;
+    }
+    uint32_t const base = (msg.id >> 18U) & 0x7FFU;
+    return base << 21U | 1U << 20U | 1U << 19U | (msg.id & 0x3FFFFU) << 1U |
+           rtr;
+  }
+
+  /// @brief フレームがバスを占有する時間
+  [[nodiscard]] Duration FrameTime(CANMessage const& msg) const {
+    auto const bits = nano_hw::can::EstimateFrameBits(msg);
+    // データフェーズも同じビットレートとみなす
+    return Duration(
+        static_cast<int64_t>(bits.nominal_bits + bits.data_bits) *
+        1000000000LL / bitrate_);
+  }
+
+ private:
+  struct Event {
+    Duration at{};
+    uint64_t seq = 0;
+    std::function<void()> action;
+  };
+  struct EventLater {
+    bool operator()(Event const& a, Event const& b) const {
+      return a.at != b.at ? a.at > b.at : a.seq > b.seq;
+    }
+  };
+
+  [[nodiscard]] bool AnyPending() const {
+    for (auto const& port : ports_) {
+      if (!port->tx.Empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @return 送信を始めたら true
+  bool StartTransmission() {
+    VirtualCANPort* winner = nullptr;
+    for (auto const& port : ports_) {
+      if (port->tx.Empty()) {
+        continue;
+      }
+      if (port->bitrate != bitrate_) {
+        // ビットレートが合わないノードはエラーフレームになる
+        port->tx.Pop();
+        port->transmit_errors += 8;
+        continue;
+      }
+      // 同じキーなら先につないだポートが勝つ
+      if (winner == nullptr || port->tx.Top().key < winner->tx.Top().key) {
+        winner = port.get();
+      }
+    }
+    if (winner == nullptr) {
+      return false;
+    }
+
+    winner->tx.TryPop(current_);
+    active_ = winner;
+    auto const duration = FrameTime(current_.msg);
+    busy_until_ = now_ + duration;
+    busy_total_ += duration;
+    return true;
+  }
+
+  // 送信中のフレームを途中で打ち切り、バスを空ける
+  void AbortTransmission() {
+    busy_total_ -= busy_until_ - now_;
+    busy_until_ = now_;
+    active_ = nullptr;
+  }
+
+  void CompleteTransmission() {
+    auto* sender = active_;
+    active_ = nullptr;
+    // コールバックの中で Detach されたポートは配り終えるまで解放しない
+    dispatching_ = true;
+
+    auto& latency =
+        latency_[nano_hw::can::CANStatsSnapshot::Key(current_.msg.id,
+                                                     current_.msg.Format())];
+    auto const elapsed = now_ - current_.submitted;
+    latency.frames++;
+    latency.total += elapsed;
+    latency.worst = std::max(latency.worst, elapsed);
+
+    auto msg = current_.msg;
+    msg.SetTimestamp(
+        std::chrono::duration_cast<nano_hw::HighResClockDuration>(now_));
+
+    if (sender->on_transmit) {
+      sender->on_transmit(current_.msg);
+    }
+    // コールバックの中で Attach されても走査が崩れないよう、先に集めてから配る
+    std::vector<VirtualCANPort*> receivers;
+    for (auto const& port : ports_) {
+      bool const self = port.get() == sender;
+      if (self && port->mode != CANMode::kLoopback) {
+        continue;
+      }
+      if (port->bitrate != bitrate_) {
+        port->receive_errors++;
+        continue;
+      }
+      if (port->Accepts(msg)) {
+        receivers.push_back(port.get());
+      }
+    }
+    for (auto* port : receivers) {
+      if (!port->detached && port->on_receive) {
+        port->on_receive(msg);
+      }
+    }
+    dispatching_ = false;
+    retired_.clear();
+  }
+
+  int bitrate_;
+  Duration now_{};
+  uint64_t next_seq_ = 0;
+
+  std::vector<std::unique_ptr<VirtualCANPort>> ports_;
+  std::vector<std::unique_ptr<VirtualCANPort>> retired_;
+  bool dispatching_ = false;
+  Nano::collection::PriorityQueue<Event, 1024, EventLater> events_;
+
+  VirtualCANPort* active_ = nullptr;
+  VirtualCANPort::Pending current_;
+  Duration busy_until_{};
+  Duration busy_total_{};
+
+  std::unordered_map<uint32_t, Latency> latency_;
+};
+
+}  // namespace nano_stub